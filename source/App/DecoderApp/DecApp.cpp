@@ -46,6 +46,7 @@
 #if RExt__DECODER_DEBUG_STATISTICS
 #include "CommonLib/CodingStatistics.h"
 #endif
+#include "CommonLib/StageProfiler.h"
 #include "CommonLib/dtrace_codingstruct.h"
 
 
@@ -57,8 +58,15 @@
 // ====================================================================================================================
 
 DecApp::DecApp()
-: m_iPOCLastDisplay(-MAX_INT)
+: m_numMetricPics(0)
+, m_iPOCLastDisplay(-MAX_INT)
 {
+  for( int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    m_sumPSNR  [comp] = 0.0;
+    m_sumSSIM  [comp] = 0.0;
+    m_sumMSSSIM[comp] = 0.0;
+  }
 }
 
 // ====================================================================================================================
@@ -86,6 +94,8 @@ uint32_t DecApp::decode()
 
   InputByteStream bytestream(bitstreamFile);
 
+  g_stageProfiler.setEnabled( !m_stageStatsFileName.empty() );
+
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
     m_seiMessageFileStream.open(m_outputDecodedSEIMessagesFilename.c_str(), std::ios::out);
@@ -112,6 +122,7 @@ uint32_t DecApp::decode()
 
   // main decoder loop
   bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
+  bool openedReferenceFile = false;
   bool loopFiltered = false;
 
   while (!!bitstreamFile)
@@ -136,7 +147,10 @@ uint32_t DecApp::decode()
     AnnexBStats stats = AnnexBStats();
 
     InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    {
+      PROFILE_STAGE( PROF_STAGE_READ );
+      byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    }
 
     // call actual decoding function
     bool bNewPicture = false;
@@ -241,6 +255,19 @@ uint32_t DecApp::decode()
         m_cVideoIOYuvReconFile.open( m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
         openedReconFile = true;
       }
+      if( !m_referenceFileName.empty() && !openedReferenceFile )
+      {
+        // the reference file is expected at the output bit depth, if specified, otherwise at the coded bit depth
+        const BitDepths &bitDepths = pcListPic->front()->cs->sps->getBitDepths();
+        int fileBitDepth[MAX_NUM_CHANNEL_TYPE];
+        for( uint32_t channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++ )
+        {
+          fileBitDepth[channelType] = m_outputBitDepth[channelType] ? m_outputBitDepth[channelType] : bitDepths.recon[channelType];
+        }
+        m_cVideoIOYuvReferenceFile.open( m_referenceFileName, false, fileBitDepth, fileBitDepth, bitDepths.recon ); // read mode
+        m_picMetrics.setNumThreads( m_metricThreads );
+        openedReferenceFile = true;
+      }
       // write reconstruction to file
       if( bNewPicture )
       {
@@ -287,6 +314,13 @@ uint32_t DecApp::decode()
 
   xFlushOutput( pcListPic );
 
+  if( openedReferenceFile )
+  {
+    xPrintMetricsSummary();
+  }
+
+  g_stageProfiler.writeJson( m_stageStatsFileName );
+
   // get the number of checksum errors
   uint32_t nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
 
@@ -322,6 +356,9 @@ void DecApp::xCreateDecLib()
 #endif
   );
   m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+#if JVET_O1164_RPR
+  m_cDecLib.setRescaleThreads(m_rescaleThreads);
+#endif
 
   m_cDecLib.setTargetDecLayer(m_iTargetLayer);
 
@@ -339,6 +376,13 @@ void DecApp::xDestroyDecLib()
     m_cVideoIOYuvReconFile.close();
   }
 
+  if ( !m_referenceFileName.empty() )
+  {
+    m_cVideoIOYuvReferenceFile.close();
+  }
+  m_referencePic[0].destroy();
+  m_referencePic[1].destroy();
+
   // destroy decoder class
   m_cDecLib.destroy();
 }
@@ -353,6 +397,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
   {
     return;
   }
+  PROFILE_STAGE( PROF_STAGE_WRITE );
 
   PicList::iterator iterPic   = pcListPic->begin();
   int numPicsNotYetDisplayed = 0;
@@ -533,6 +578,11 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           m_cColourRemapping.outputColourRemapPic (pcPic, m_seiMessageFileStream);
         }
 #endif
+        if (!m_referenceFileName.empty())
+        {
+          xCalculateMetrics( pcPic );
+        }
+
         // update POC of display order
         m_iPOCLastDisplay = pcPic->getPOC();
 
@@ -557,6 +607,7 @@ void DecApp::xFlushOutput( PicList* pcListPic )
   {
     return;
   }
+  PROFILE_STAGE( PROF_STAGE_WRITE );
   PicList::iterator iterPic   = pcListPic->begin();
 
   iterPic   = pcListPic->begin();
@@ -684,6 +735,11 @@ void DecApp::xFlushOutput( PicList* pcListPic )
         }
 #endif
                                          
+        if (!m_referenceFileName.empty())
+        {
+          xCalculateMetrics( pcPic );
+        }
+
         // update POC of display order
         m_iPOCLastDisplay = pcPic->getPOC();
 
@@ -707,6 +763,93 @@ void DecApp::xFlushOutput( PicList* pcListPic )
   m_iPOCLastDisplay = -MAX_INT;
 }
 
+/** computes PSNR, SSIM and MS-SSIM of the cropped output picture with respect to the next picture of the reference file
+    \param pcPic picture being output
+ */
+void DecApp::xCalculateMetrics( Picture* pcPic )
+{
+  const SPS*         sps          = pcPic->cs->sps;
+  const ChromaFormat chromaFormat = sps->getChromaFormatIdc();
+#if JVET_O1164_PS
+  const Window&      conf         = pcPic->cs->pps->getConformanceWindow();
+  const int          confLeft     = conf.getWindowLeftOffset()   * SPS::getWinUnitX( chromaFormat );
+  const int          confRight    = conf.getWindowRightOffset()  * SPS::getWinUnitX( chromaFormat );
+  const int          confTop      = conf.getWindowTopOffset()    * SPS::getWinUnitY( chromaFormat );
+  const int          confBottom   = conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormat );
+#else
+  const Window&      conf         = sps->getConformanceWindow();
+  const int          confLeft     = conf.getWindowLeftOffset();
+  const int          confRight    = conf.getWindowRightOffset();
+  const int          confTop      = conf.getWindowTopOffset();
+  const int          confBottom   = conf.getWindowBottomOffset();
+#endif
+  const CPelUnitBuf  reco         = pcPic->getRecoBuf();
+  const Area         area( 0, 0, reco.Y().width - confLeft - confRight, reco.Y().height - confTop - confBottom );
+
+  if( m_referencePic[0].bufs.empty() || m_referencePic[0].chromaFormat != chromaFormat || m_referencePic[0].Y().width != area.width || m_referencePic[0].Y().height != area.height )
+  {
+    for( int i = 0; i < 2; i++ )
+    {
+      m_referencePic[i].destroy();
+      m_referencePic[i].create( chromaFormat, area );
+    }
+  }
+
+  int pad[2] = { 0, 0 };
+  if( !m_cVideoIOYuvReferenceFile.read( m_referencePic[1], m_referencePic[0], IPCOLOURSPACE_UNCHANGED, pad ) )
+  {
+    msg( WARNING, "\nWarning: end of reference file %s reached, no quality metrics are computed from POC %d on\n", m_referenceFileName.c_str(), pcPic->getPOC() );
+    m_cVideoIOYuvReferenceFile.close();
+    m_referenceFileName.clear();
+    return;
+  }
+
+  double psnr[MAX_NUM_COMPONENT]   = { 0, 0, 0 };
+  double ssim[MAX_NUM_COMPONENT]   = { 0, 0, 0 };
+  double msssim[MAX_NUM_COMPONENT] = { 0, 0, 0 };
+
+  for( int comp = 0; comp < ::getNumberValidComponents( chromaFormat ); comp++ )
+  {
+    const ComponentID compID   = ComponentID( comp );
+    const int         scaleX   = ::getComponentScaleX( compID, chromaFormat );
+    const int         scaleY   = ::getComponentScaleY( compID, chromaFormat );
+    const CPelBuf     ref      = m_referencePic[0].get( compID );
+    const CPelBuf     rec      = reco.get( compID ).subBuf( confLeft >> scaleX, confTop >> scaleY, ref.width, ref.height );
+    const int         bitDepth = sps->getBitDepth( toChannelType( compID ) );
+
+    const uint64_t    sse      = m_picMetrics.getSSE( rec, ref );
+    const uint32_t    maxval   = 255 << ( bitDepth - 8 );
+    const double      refValue = (double)maxval * maxval * ref.width * ref.height;
+
+    psnr[comp]   = sse ? 10.0 * log10( refValue / (double)sse ) : 999.99;
+    ssim[comp]   = m_picMetrics.getSSIM( rec, ref, bitDepth );
+    msssim[comp] = m_picMetrics.getMSSSIM( rec, ref, bitDepth );
+
+    m_sumPSNR[comp]   += psnr[comp];
+    m_sumSSIM[comp]   += ssim[comp];
+    m_sumMSSSIM[comp] += msssim[comp];
+  }
+  m_numMetricPics++;
+
+  msg( NOTICE, "POC %4d output [Y %6.4lf dB    U %6.4lf dB    V %6.4lf dB]", pcPic->getPOC(), psnr[COMPONENT_Y], psnr[COMPONENT_Cb], psnr[COMPONENT_Cr] );
+  msg( NOTICE, " [SSIM Y %1.6lf    U %1.6lf    V %1.6lf]", ssim[COMPONENT_Y], ssim[COMPONENT_Cb], ssim[COMPONENT_Cr] );
+  msg( NOTICE, " [MS-SSIM Y %1.6lf    U %1.6lf    V %1.6lf]\n", msssim[COMPONENT_Y], msssim[COMPONENT_Cb], msssim[COMPONENT_Cr] );
+}
+
+void DecApp::xPrintMetricsSummary()
+{
+  if( m_numMetricPics == 0 )
+  {
+    return;
+  }
+
+  const double n = m_numMetricPics;
+  msg( INFO, "\nQuality of %d output pictures\n", m_numMetricPics );
+  msg( INFO, "PSNR    : Y %8.4lf dB    U %8.4lf dB    V %8.4lf dB\n", m_sumPSNR[COMPONENT_Y] / n, m_sumPSNR[COMPONENT_Cb] / n, m_sumPSNR[COMPONENT_Cr] / n );
+  msg( INFO, "SSIM    : Y %1.6lf    U %1.6lf    V %1.6lf\n", m_sumSSIM[COMPONENT_Y] / n, m_sumSSIM[COMPONENT_Cb] / n, m_sumSSIM[COMPONENT_Cr] / n );
+  msg( INFO, "MS-SSIM : Y %1.6lf    U %1.6lf    V %1.6lf\n", m_sumMSSSIM[COMPONENT_Y] / n, m_sumMSSSIM[COMPONENT_Cb] / n, m_sumMSSSIM[COMPONENT_Cr] / n );
+}
+
 /** \param nalu Input nalu to check whether its LayerId is within targetDecLayerIdSet
  */
 bool DecApp::isNaluWithinTargetDecLayerIdSet( InputNALUnit* nalu )
@@ -45,6 +45,7 @@
 #include "Utilities/VideoIOYuv.h"
 #include "Utilities/ColourRemapping.h"
 #include "CommonLib/Picture.h"
+#include "CommonLib/PictureMetrics.h"
 #include "DecoderLib/DecLib.h"
 #include "DecAppCfg.h"
 
@@ -63,6 +64,15 @@ private:
   DecLib          m_cDecLib;                     ///< decoder class
   VideoIOYuv      m_cVideoIOYuvReconFile;        ///< reconstruction YUV class
 
+  // for the objective quality metrics
+  VideoIOYuv      m_cVideoIOYuvReferenceFile;    ///< reference YUV class
+  PelStorage      m_referencePic[2];             ///< reference picture, as read from file and after colour space conversion
+  PictureMetrics  m_picMetrics;
+  double          m_sumPSNR  [MAX_NUM_COMPONENT];
+  double          m_sumSSIM  [MAX_NUM_COMPONENT];
+  double          m_sumMSSSIM[MAX_NUM_COMPONENT];
+  int             m_numMetricPics;
+
   // for output control
   int             m_iPOCLastDisplay;              ///< last POC in display order
   std::ofstream   m_seiMessageFileStream;         ///< Used for outputing SEI messages.
@@ -81,6 +91,8 @@ private:
   void  xDestroyDecLib    (); ///< destroy internal classes
   void  xWriteOutput      ( PicList* pcListPic , uint32_t tId); ///< write YUV to file
   void  xFlushOutput      ( PicList* pcListPic ); ///< flush all remaining decoded pictures to file
+  void  xCalculateMetrics ( Picture* pcPic ); ///< compute the quality metrics of an output picture with respect to the reference file
+  void  xPrintMetricsSummary(); ///< print the average quality metrics of all output pictures
   bool  isNaluWithinTargetDecLayerIdSet ( InputNALUnit* nalu ); ///< check whether given Nalu is within targetDecLayerIdSet
   bool  isNaluTheTargetLayer(InputNALUnit* nalu); ///< check whether given Nalu is within targetDecLayerIdSet
 };
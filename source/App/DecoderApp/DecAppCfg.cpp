@@ -96,6 +96,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("RespectDefDispWindow,w",    m_respectDefDispWindow,                0,          "Only output content inside the default display window\n")
   ("SEIColourRemappingInfoFilename",  m_colourRemapSEIFileName,        string(""), "Colour Remapping YUV output file name. If empty, no remapping is applied (ignore SEI message)\n")
   ("OutputDecodedSEIMessagesFilename",  m_outputDecodedSEIMessagesFilename,    string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
+  ("StageStatsFile",            m_stageStatsFileName,                  string(""), "When non empty, write per-stage timing and counter statistics (JSON) to the indicated file\n")
+  ("ReferenceFile",             m_referenceFileName,                   string(""), "When non empty, compute PSNR, SSIM and MS-SSIM of the output pictures with respect to the indicated YUV file\n")
+  ("MetricThreads",             m_metricThreads,                       1,          "Number of threads used to compute the objective quality metrics of a picture")
   ("ClipOutputVideoToRec709Range",      m_bClipOutputVideoToRec709Range,  false,   "If true then clip output video to the Rec. 709 Range on saving")
   ("PYUV",                      m_packedYUVMode,                       false,      "If true then output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data. Ignored for interlaced output.")
 #if ENABLE_TRACING
@@ -116,6 +119,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("MCTSCheck",                m_mctsCheck,                           false,       "If enabled, the decoder checks for violations of mc_exact_sample_value_match_flag in Temporal MCTS ")
 #if JVET_O1164_RPR
   ( "UpscaledOutput",          m_upscaledOutput,                          0,       "Upscaled output for RPR" )
+  ( "RescaleThreads",          m_rescaleThreads,                          1,       "Number of threads used to resample the reference pictures for RPR" )
 #endif
   ;
 
@@ -173,6 +177,20 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     return false;
   }
 
+  if (m_metricThreads < 1)
+  {
+    msg( ERROR, "Number of threads used for the quality metrics cannot be smaller than 1, aborting\n");
+    return false;
+  }
+
+#if JVET_O1164_RPR
+  if (m_rescaleThreads < 1)
+  {
+    msg( ERROR, "Number of threads used for resampling cannot be smaller than 1, aborting\n");
+    return false;
+  }
+#endif
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
@@ -234,6 +252,9 @@ DecAppCfg::DecAppCfg()
 , m_targetDecLayerIdSet()
 , m_respectDefDispWindow(0)
 , m_outputDecodedSEIMessagesFilename()
+, m_stageStatsFileName()
+, m_referenceFileName()
+, m_metricThreads(1)
 , m_bClipOutputVideoToRec709Range(false)
 , m_packedYUVMode(false)
 , m_statMode(0)
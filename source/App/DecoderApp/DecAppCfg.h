@@ -70,6 +70,9 @@ protected:
   std::vector<int> m_targetDecLayerIdSet;             ///< set of LayerIds to be included in the sub-bitstream extraction process.
   int           m_respectDefDispWindow;               ///< Only output content inside the default display window
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
+  std::string   m_stageStatsFileName;                 ///< filename of the per-stage timing statistics. If empty, do not profile.
+  std::string   m_referenceFileName;                  ///< reference YUV file for the objective quality metrics. If empty, no metrics are computed.
+  int           m_metricThreads;                      ///< number of threads used to compute the objective quality metrics
   bool          m_bClipOutputVideoToRec709Range;      ///< If true, clip the output video to the Rec 709 range on saving.
   bool          m_packedYUVMode;                      ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
@@ -78,6 +81,7 @@ protected:
 
 #if JVET_O1164_RPR
   int          m_upscaledOutput;                     ////< Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
+  int          m_rescaleThreads;                     ///< number of threads used to resample the reference pictures for RPR
 #endif
 
 public:
@@ -44,6 +44,7 @@
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
+#include "CommonLib/StageProfiler.h"
 #if EXTENSION_360_VIDEO
 #include "AppEncHelper360/TExt360AppEncTop.h"
 #endif
@@ -107,6 +108,8 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setPrintFrameMSE                                     ( m_printFrameMSE);
   m_cEncLib.setPrintHexPsnr(m_printHexPsnr);
   m_cEncLib.setPrintSequenceMSE                                  ( m_printSequenceMSE);
+  m_cEncLib.setPrintSSIM                                         ( m_printSSIM );
+  m_cEncLib.setMetricThreads                                     ( m_metricThreads );
   m_cEncLib.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
 
   m_cEncLib.setFrameRate                                         ( m_iFrameRate );
@@ -120,6 +123,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setRPREnabled                                        ( m_rprEnabled );
   m_cEncLib.setSwitchPocPeriod                                   ( m_switchPocPeriod );
   m_cEncLib.setUpscaledOutput                                    ( m_upscaledOutput );
+  m_cEncLib.setRescaleThreads                                    ( m_rescaleThreads );
 #else
   m_cEncLib.setConformanceWindow                                 ( m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom );
 #endif
@@ -316,6 +320,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setUseMHIntra                                        ( m_MHIntra );
   m_cEncLib.setUseTriangle                                       ( m_Triangle );
   m_cEncLib.setUseHashME                                         ( m_HashME );
+  m_cEncLib.setHashMEThreads                                     ( m_hashMEThreads );
 
   m_cEncLib.setAllowDisFracMMVD                                  ( m_allowDisFracMMVD );
   m_cEncLib.setUseAffineAmvr                                     ( m_AffineAmvr );
@@ -376,6 +381,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setUseAMaxBT                                         ( m_useAMaxBT );
   m_cEncLib.setUseE0023FastEnc                                   ( m_e0023FastEnc );
   m_cEncLib.setUseContentBasedFastQtbt                           ( m_contentBasedFastQtbt );
+  m_cEncLib.setFastSplitPruning                                  ( m_fastSplitPruning );
   m_cEncLib.setUseNonLinearAlfLuma                               ( m_useNonLinearAlfLuma );
   m_cEncLib.setUseNonLinearAlfChroma                             ( m_useNonLinearAlfChroma );
 #if JVET_O0090_ALF_CHROMA_FILTER_ALTERNATIVES_CTB
@@ -383,6 +389,7 @@ void EncApp::xInitLibCfg()
 #endif
   m_cEncLib.setUseMIP                                            ( m_MIP );
   m_cEncLib.setUseFastMIP                                        ( m_useFastMIP );
+  m_cEncLib.setIntraGradientPreselect                            ( m_intraGradientPreselect );
 #if JVET_O0050_LOCAL_DUAL_TREE
   m_cEncLib.setFastLocalDualTreeMode                             ( m_fastLocalDualTreeMode );
 #endif
@@ -628,6 +635,18 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setCpbSize                                           ( m_RCCpbSize );
   m_cEncLib.setInitialCpbFullness                                ( m_RCInitialCpbFullness );
 #endif
+  m_cEncLib.setRCTwoPass                                         ( m_RCTwoPass && !m_RCFirstPassMode );
+  m_cEncLib.setRCFirstPassMode                                   ( m_RCFirstPassMode );
+  m_cEncLib.setRCStatsFileName                                   ( m_RCStatsFileName );
+  if ( m_RCFirstPassMode )
+  {
+    // analysis pass of two-pass rate control: constant QP, reduced motion search and coarse partitioning
+    m_cEncLib.setUseRateCtrl                                     ( false );
+    m_cEncLib.setSearchRange                                     ( std::min( m_iSearchRange, 16 ) );
+    m_cEncLib.setMaxMTTHierarchyDepth                            ( std::min( m_uiMaxMTTHierarchyDepth, 1u ), std::min( m_uiMaxMTTHierarchyDepthI, 1u ), std::min( m_uiMaxMTTHierarchyDepthIChroma, 1u ) );
+    m_cEncLib.setUseFastDecisionForMerge                         ( true );
+    m_cEncLib.setUseEarlySkipDetection                           ( true );
+  }
   m_cEncLib.setTransquantBypassEnabledFlag                       ( m_TransquantBypassEnabledFlag );
   m_cEncLib.setCUTransquantBypassFlagForceValue                  ( m_CUTransquantBypassFlagForce );
   m_cEncLib.setCostMode                                          ( m_costMode );
@@ -772,12 +791,25 @@ void EncApp::xInitLib(bool isFieldCoding)
  */
 void EncApp::encode()
 {
-  m_bitstream.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
-  if (!m_bitstream)
+  if ( m_RCFirstPassMode )
   {
-    EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for writing\n");
+    // the analysis pass only produces rate control statistics
+    m_reconFileName.clear();
+    m_summaryOutFilename.clear();
+    m_summaryPicFilenameBase.clear();
+  }
+  else
+  {
+    m_bitstream.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
+    if (!m_bitstream)
+    {
+      EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for writing\n");
+    }
   }
 
+  // the analysis pass of two-pass rate control is not profiled
+  g_stageProfiler.setEnabled( !m_stageStatsFileName.empty() && !m_RCFirstPassMode );
+
   std::list<PelUnitBuf*> recBufList;
   // initialize internal class & member variables
   xInitLibCfg();
@@ -808,18 +840,21 @@ void EncApp::encode()
   while ( !bEos )
   {
     // read input YUV file
-#if EXTENSION_360_VIDEO
-    if (ext360.isEnabled())
     {
-      ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
-    }
-    else
-    {
-      m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
-    }
+      PROFILE_STAGE( PROF_STAGE_READ );
+#if EXTENSION_360_VIDEO
+      if (ext360.isEnabled())
+      {
+        ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
+      }
+      else
+      {
+        m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
+      }
 #else
-    m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
 #endif
+    }
 
     // increase number of received frames
     m_iFrameRcvd++;
@@ -883,11 +918,21 @@ void EncApp::encode()
   }
   recBufList.clear();
 
+  if ( m_RCFirstPassMode )
+  {
+    m_cEncLib.getRateCtrl()->writeFirstPassStats( m_RCStatsFileName );
+  }
+
   xDestroyLib();
 
   m_bitstream.close();
 
-  printRateSummary();
+  if ( !m_RCFirstPassMode )
+  {
+    printRateSummary();
+  }
+
+  g_stageProfiler.writeJson( m_stageStatsFileName );
 
   return;
 }
@@ -905,6 +950,7 @@ void EncApp::encode()
 void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
                           )
 {
+  PROFILE_STAGE( PROF_STAGE_WRITE );
   const InputColourSpaceConversion ipCSC = (!m_outputInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
   std::list<PelUnitBuf*>::iterator iterPicYuvRec = recBufList.end();
   int i;
@@ -965,6 +1011,11 @@ void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
 
 void EncApp::outputAU( const AccessUnit& au )
 {
+  if ( m_RCFirstPassMode )
+  {
+    return;
+  }
+  PROFILE_STAGE( PROF_STAGE_WRITE );
   const vector<uint32_t>& stats = writeAnnexB(m_bitstream, au);
   rateStatsAccum(au, stats);
   m_bitstream.flush();
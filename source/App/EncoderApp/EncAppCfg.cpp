@@ -150,6 +150,7 @@ EncAppCfg::EncAppCfg()
 #endif
 {
   m_aidQP = NULL;
+  m_RCFirstPassMode = false;
 #if HEVC_SEI
   m_startOfCodedInterval = NULL;
   m_codedPivotValue = NULL;
@@ -831,6 +832,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("PrintHexPSNR",                                    m_printHexPsnr,                                   false, "0 (default) don't emit hexadecimal PSNR for each frame, 1 = also emit hexadecimal PSNR values")
   ("PrintFrameMSE",                                   m_printFrameMSE,                                  false, "0 (default) emit only bit count and PSNRs for each frame, 1 = also emit MSE values")
   ("PrintSequenceMSE",                                m_printSequenceMSE,                               false, "0 (default) emit only bit rate and PSNRs for the whole sequence, 1 = also emit MSE values")
+  ("PrintSSIM",                                       m_printSSIM,                                      false, "0 (default) emit only PSNRs, 1 = also emit SSIM and MS-SSIM values for each frame and the whole sequence")
+  ("MetricThreads",                                   m_metricThreads,                                      1, "Number of threads used to compute the objective quality metrics (PSNR, SSIM) of a picture")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceMode",                                 m_conformanceWindowMode,                              0, "Deprecated alias of ConformanceWindowMode")
@@ -860,6 +863,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("StageStatsFile",                                  m_stageStatsFileName,                          string(), "Filename of the per-stage timing and counter statistics (JSON). If empty, do not profile.")
   ("Verbosity,v",                                     m_verbosity,                               (int)VERBOSE, "Specifies the level of the verboseness")
 
 #if JVET_O0756_CONFIG_HDRMETRICS || JVET_O0756_CALCULATE_HDRMETRICS
@@ -959,6 +963,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MHIntra",                                         m_MHIntra,                                        false, "Enable MHIntra mode")
   ("Triangle",                                        m_Triangle,                                       false, "Enable triangular shape motion vector prediction (0:off, 1:on)")
   ("HashME",                                          m_HashME,                                         false, "Enable hash motion estimation (0:off, 1:on)")
+  ("HashMEThreads",                                   m_hashMEThreads,                                      1, "Number of threads used to build the hash motion estimation tables")
 
   ("AllowDisFracMMVD",                                m_allowDisFracMMVD,                               false, "Disable fractional MVD in MMVD mode adaptively")
   ("AffineAmvr",                                      m_AffineAmvr,                                     false, "Eanble AMVR for affine inter mode")
@@ -1000,6 +1005,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
                                                                                                                "1: rsp both (CW66 for QP<=22), 2: rsp TID0 (for all QP),"
                                                                                                                "3: rsp inter(CW66 for QP<=22), 4: rsp inter(for all QP).")
   ("LMCSInitialCW",                                   m_initialCW,                                         0u, "LMCS initial total codeword (0~1023) when LMCSAdpOption > 0")
+  ("LMCSThreads",                                     m_lmcsThreads,                                        1, "Number of threads used for the LMCS picture analysis")
 #else
   ("LumaReshapeEnable",                               m_lumaReshapeEnable,                              false, "Enable Reshaping for Luma Channel")
   ("ReshapeSignalType",                               m_reshapeSignalType,                                 0u, "Input signal type: 0: SDR, 1:PQ, 2:HLG")
@@ -1011,6 +1017,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("AMaxBT",                                          m_useAMaxBT,                                      false, "Adaptive maximal BT-size")
   ("E0023FastEnc",                                    m_e0023FastEnc,                                    true, "Fast encoding setting for QTBT (proposal E0023)")
   ("ContentBasedFastQtbt",                            m_contentBasedFastQtbt,                           false, "Signal based QTBT speed-up")
+  ("FastSplitPruning",                                m_fastSplitPruning,                                   0, "Content-adaptive pruning of split modes before RD testing (0: off, 1: conservative, 2: medium, 3: aggressive)")
   ("UseNonLinearAlfLuma",                             m_useNonLinearAlfLuma,                             true, "Non-linear adaptive loop filters for Luma Channel")
   ("UseNonLinearAlfChroma",                           m_useNonLinearAlfChroma,                           true, "Non-linear adaptive loop filters for Chroma Channels")
 #if JVET_O0090_ALF_CHROMA_FILTER_ALTERNATIVES_CTB
@@ -1019,6 +1026,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 #endif
   ("MIP",                                             m_MIP,                                             true,  "Enable MIP (matrix-based intra prediction)")
   ("FastMIP",                                         m_useFastMIP,                                     false,  "Fast encoder search for MIP (matrix-based intra prediction)")
+  ("IntraGradientPreselect",                          m_intraGradientPreselect,                             0,  "Number of gradient-ranked angular directions kept for the intra Hadamard search, next to planar, DC and the MPMs (0: off)")
 #if JVET_O0050_LOCAL_DUAL_TREE
   ("FastLocalDualTreeMode",                           m_fastLocalDualTreeMode,                              0,  "Fast intra pass coding for local dual-tree in intra coding region, 0: off, 1: use threshold, 2: one intra mode only")
 #endif
@@ -1256,6 +1264,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "RCCpbSize",                                      m_RCCpbSize,                                         0u, "Rate control: CPB size" )
   ( "RCInitialCpbFullness",                           m_RCInitialCpbFullness,                             0.9, "Rate control: initial CPB fullness" )
 #endif
+  ( "RCTwoPass",                                      m_RCTwoPass,                                      false, "Rate control: run a fast constant-QP analysis pass and use its picture and CTU bits for bit allocation" )
+  ( "RCStatsFile",                                    m_RCStatsFileName,                             string(""), "Rate control: two-pass statistics file (default: <BitstreamFile>.rcstats)" )
   ("TransquantBypassEnable",                          m_TransquantBypassEnabledFlag,                    false, "transquant_bypass_enabled_flag indicator in PPS")
   ("TransquantBypassEnableFlag",                      m_TransquantBypassEnabledFlag,                    false, "deprecated and obsolete, but still needed for compatibility reasons")
   ("CUTransquantBypassFlagForce",                     m_CUTransquantBypassFlagForce,                    false, "Force transquant bypass mode, when transquant_bypass_enabled_flag is enabled")
@@ -1440,6 +1450,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "FractionNumFrames",                              m_fractionOfFrames,                         1.0, "Encode a fraction of the specified in FramesToBeEncoded frames" )
   ( "SwitchPocPeriod",                                m_switchPocPeriod,                            0, "Switch POC period for RPR" )
   ( "UpscaledOutput",                                 m_upscaledOutput,                             0, "Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR" )
+  ( "RescaleThreads",                                 m_rescaleThreads,                             1, "Number of threads used to resample the original and reference pictures for RPR" )
 #endif
     ;
 
@@ -2352,6 +2363,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   m_reshapeCW.updateCtrl = m_updateCtrl;
   m_reshapeCW.adpOption = m_adpOption;
   m_reshapeCW.initialCW = m_initialCW;
+  m_reshapeCW.numThreads = m_lmcsThreads;
 #endif
 #if ENABLE_TRACING
   g_trace_ctx = tracing_init(sTracingFile, sTracingRule);
@@ -2536,6 +2548,11 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_numWppThreads != 1, "ENABLE_WPP_PARALLELISM is disabled, numWppThreads has to be 1" );
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
 #endif
+  xConfirmPara( m_metricThreads < 1, "Number of threads used for the quality metrics cannot be smaller than 1" );
+  xConfirmPara( m_hashMEThreads < 1, "Number of threads used for the hash motion estimation tables cannot be smaller than 1" );
+#if JVET_O1164_RPR
+  xConfirmPara( m_rescaleThreads < 1, "Number of threads used for resampling cannot be smaller than 1" );
+#endif
 
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
@@ -2552,6 +2569,8 @@ bool EncAppCfg::xCheckParameter()
 
 
   xConfirmPara( m_useAMaxBT && !m_SplitConsOverrideEnabledFlag, "AMaxBt can only be used with PartitionConstriantsOverride enabled" );
+  xConfirmPara( m_fastSplitPruning < 0 || m_fastSplitPruning > 3, "FastSplitPruning must be in the range 0 to 3" );
+  xConfirmPara( m_intraGradientPreselect < 0 || m_intraGradientPreselect > NUM_LUMA_MODE - 2, "IntraGradientPreselect must be in the range 0 to 65" );
 
 
   xConfirmPara(m_bitstreamFileName.empty(), "A bitstream file name must be specified (BitstreamFile)");
@@ -2794,6 +2813,7 @@ bool EncAppCfg::xCheckParameter()
     xConfirmPara(m_adpOption > 4, "Max. LMCS Adaptation Option is 4");
     xConfirmPara(m_initialCW < 0, "Min. Initial Total Codeword is 0");
     xConfirmPara(m_initialCW > 1023, "Max. Initial Total Codeword is 1023");
+    xConfirmPara(m_lmcsThreads < 1, "Number of threads used for the LMCS analysis cannot be smaller than 1");
     if (m_updateCtrl > 0 && m_adpOption > 2) { m_adpOption -= 2; }
   }
 #endif
@@ -3494,6 +3514,10 @@ bool EncAppCfg::xCheckParameter()
       }
     }
     xConfirmPara( m_uiDeltaQpRD > 0, "Rate control cannot be used together with slice level multiple-QP optimization!\n" );
+    if ( m_RCTwoPass && m_RCStatsFileName.empty() )
+    {
+      m_RCStatsFileName = m_bitstreamFileName + ".rcstats";
+    }
 #if U0132_TARGET_BITS_SATURATION
     if ((m_RCCpbSaturationEnabled) && (m_level!=Level::NONE) && (m_profile!=Profile::NONE))
     {
@@ -3577,12 +3601,18 @@ void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Input          File                    : %s\n", m_inputFileName.c_str() );
   msg( DETAILS, "Bitstream      File                    : %s\n", m_bitstreamFileName.c_str() );
   msg( DETAILS, "Reconstruction File                    : %s\n", m_reconFileName.c_str() );
+  if( !m_stageStatsFileName.empty() )
+  {
+    msg( DETAILS, "Stage statistics File                  : %s\n", m_stageStatsFileName.c_str() );
+  }
   msg( DETAILS, "Real     Format                        : %dx%d %gHz\n", m_iSourceWidth - m_confWinLeft - m_confWinRight, m_iSourceHeight - m_confWinTop - m_confWinBottom, (double)m_iFrameRate / m_temporalSubsampleRatio );
   msg( DETAILS, "Internal Format                        : %dx%d %gHz\n", m_iSourceWidth, m_iSourceHeight, (double)m_iFrameRate / m_temporalSubsampleRatio );
   msg( DETAILS, "Sequence PSNR output                   : %s\n", ( m_printMSEBasedSequencePSNR ? "Linear average, MSE-based" : "Linear average only" ) );
   msg( DETAILS, "Hexadecimal PSNR output                : %s\n", ( m_printHexPsnr ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Sequence MSE output                    : %s\n", ( m_printSequenceMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Frame MSE output                       : %s\n", ( m_printFrameMSE ? "Enabled" : "Disabled" ) );
+  msg( DETAILS, "SSIM output                            : %s\n", ( m_printSSIM ? "Enabled" : "Disabled" ) );
+  msg( DETAILS, "Quality metric threads                 : %d\n", m_metricThreads );
   msg( DETAILS, "Cabac-zero-word-padding                : %s\n", ( m_cabacZeroWordPaddingEnabled ? "Enabled" : "Disabled" ) );
   if (m_isField)
   {
@@ -3700,6 +3730,11 @@ void EncAppCfg::xPrintParameter()
     msg( DETAILS, "UseLCUSeparateModel                    : %d\n", m_RCUseLCUSeparateModel );
     msg( DETAILS, "InitialQP                              : %d\n", m_RCInitialQP );
     msg( DETAILS, "ForceIntraQP                           : %d\n", m_RCForceIntraQP );
+    msg( DETAILS, "TwoPass                                : %d\n", m_RCTwoPass );
+    if (m_RCTwoPass)
+    {
+      msg( DETAILS, "StatsFile                              : %s\n", m_RCStatsFileName.c_str() );
+    }
 #if U0132_TARGET_BITS_SATURATION
     msg( DETAILS, "CpbSaturation                          : %d\n", m_RCCpbSaturationEnabled );
     if (m_RCCpbSaturationEnabled)
@@ -3831,6 +3866,10 @@ void EncAppCfg::xPrintParameter()
 #endif
     msg(VERBOSE, "IBC:%d ", m_IBCMode);
   msg( VERBOSE, "HashME:%d ", m_HashME );
+  if( m_HashME )
+  {
+    msg( VERBOSE, "HashMEThreads:%d ", m_hashMEThreads );
+  }
   msg( VERBOSE, "WrapAround:%d ", m_wrapAround);
   if( m_wrapAround )
   {
@@ -3859,6 +3898,7 @@ void EncAppCfg::xPrintParameter()
       msg(VERBOSE, "(Signal:%s ", m_reshapeSignalType == 0 ? "SDR" : (m_reshapeSignalType == 2 ? "HDR-HLG" : "HDR-PQ"));
       msg(VERBOSE, "Opt:%d", m_adpOption);
       if (m_adpOption > 0) { msg(VERBOSE, " CW:%d", m_initialCW); }
+      if (m_lmcsThreads > 1) { msg(VERBOSE, " Threads:%d", m_lmcsThreads); }
 #else
       msg(VERBOSE, "(Sigal:%s ", m_reshapeSignalType==0? "SDR" : "HDR-PQ");
 #endif
@@ -3877,12 +3917,14 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "AMaxBT:%d ", m_useAMaxBT );
   msg( VERBOSE, "E0023FastEnc:%d ", m_e0023FastEnc );
   msg( VERBOSE, "ContentBasedFastQtbt:%d ", m_contentBasedFastQtbt );
+  msg( VERBOSE, "FastSplitPruning:%d ", m_fastSplitPruning );
   msg( VERBOSE, "UseNonLinearAlfLuma:%d ", m_useNonLinearAlfLuma );
   msg( VERBOSE, "UseNonLinearAlfChroma:%d ", m_useNonLinearAlfChroma );
 #if JVET_O0090_ALF_CHROMA_FILTER_ALTERNATIVES_CTB
   msg( VERBOSE, "MaxNumAlfAlternativesChroma:%d ", m_maxNumAlfAlternativesChroma );
 #endif
   if( m_MIP ) msg(VERBOSE, "FastMIP:%d ", m_useFastMIP);
+  msg( VERBOSE, "IntraGradientPreselect:%d ", m_intraGradientPreselect );
 #if JVET_O0050_LOCAL_DUAL_TREE
   msg( VERBOSE, "FastLocalDualTree:%d ", m_fastLocalDualTreeMode );
 #endif
@@ -3899,6 +3941,7 @@ void EncAppCfg::xPrintParameter()
   if( m_rprEnabled )
   {
     msg( VERBOSE, "RPR:(%1.2lfx, %1.2lfx)|%d", m_scalingRatioHor, m_scalingRatioVer, m_switchPocPeriod );
+    msg( VERBOSE, " RescaleThreads:%d", m_rescaleThreads );
   }
   else
   {
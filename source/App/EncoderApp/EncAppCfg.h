@@ -117,6 +117,8 @@ protected:
   bool      m_printHexPsnr;
   bool      m_printFrameMSE;
   bool      m_printSequenceMSE;
+  bool      m_printSSIM;
+  int       m_metricThreads;
   bool      m_cabacZeroWordPaddingEnabled;
   bool      m_bClipInputVideoToRec709Range;
   bool      m_bClipOutputVideoToRec709Range;
@@ -303,6 +305,7 @@ protected:
   bool      m_MHIntra;
   bool      m_Triangle;
   bool      m_HashME;
+  int       m_hashMEThreads;
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
   bool      m_AffineAmvrEncOpt;
@@ -343,6 +346,7 @@ protected:
   int       m_updateCtrl;
   int       m_adpOption;
   uint32_t  m_initialCW;
+  int       m_lmcsThreads;
 #endif
   bool      m_encDbOpt;
   unsigned  m_uiMaxCUWidth;                                   ///< max. CU width in pixel
@@ -357,6 +361,7 @@ protected:
   bool      m_useFastMrg;
   bool      m_e0023FastEnc;
   bool      m_contentBasedFastQtbt;
+  int       m_fastSplitPruning;
   bool      m_useNonLinearAlfLuma;
   bool      m_useNonLinearAlfChroma;
 #if JVET_O0090_ALF_CHROMA_FILTER_ALTERNATIVES_CTB
@@ -364,6 +369,7 @@ protected:
 #endif
   bool      m_MIP;
   bool      m_useFastMIP;
+  int       m_intraGradientPreselect;
 #if JVET_O0050_LOCAL_DUAL_TREE
   int       m_fastLocalDualTreeMode;
 #endif
@@ -602,6 +608,9 @@ protected:
   uint32_t      m_RCCpbSize;                          ///< CPB size
   double    m_RCInitialCpbFullness;               ///< initial CPB fullness
 #endif
+  bool      m_RCTwoPass;                          ///< run a fast analysis pass and allocate bits from its statistics
+  std::string m_RCStatsFileName;                  ///< statistics file written by the analysis pass of two-pass rate control
+  bool      m_RCFirstPassMode;                    ///< this encoder instance runs the analysis pass of two-pass rate control
   ScalingListMode m_useScalingListId;                         ///< using quantization matrix
   std::string m_scalingListFileName;                          ///< quantization matrix file name
   bool      m_TransquantBypassEnabledFlag;                    ///< transquant_bypass_enabled_flag setting in PPS.
@@ -643,6 +652,7 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   uint32_t        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  std::string m_stageStatsFileName;                           ///< filename of the per-stage timing statistics, profiling is disabled if empty
 
   int         m_verbosity;
 
@@ -664,6 +674,7 @@ protected:
   double      m_fractionOfFrames;                             ///< encode a fraction of the frames as specified in FramesToBeEncoded
   int         m_switchPocPeriod;
   int         m_upscaledOutput;                               ////< Output upscaled (2), decoded cropped but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
+  int         m_rescaleThreads;                               ///< number of threads used to resample pictures for RPR
 #endif
 
 #if EXTENSION_360_VIDEO
@@ -704,6 +715,9 @@ public:
   void  destroy   ();                                         ///< destroy option handling class
   bool  parseCfg  ( int argc, char* argv[] );                ///< parse configuration file to fill member variables
 
+  bool  getRCTwoPass        () const                          { return m_RCEnableRateControl && m_RCTwoPass; }
+  void  setRCFirstPassMode  ( bool b )                        { m_RCFirstPassMode = b; }
+
 };// END CLASS DEFINITION EncAppCfg
 
 //! \}
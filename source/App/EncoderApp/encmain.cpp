@@ -150,6 +150,19 @@ int main(int argc, char* argv[])
   try
   {
 #endif
+    if( pcEncApp->getRCTwoPass() )
+    {
+      // run the analysis pass of two-pass rate control with its own encoder instance
+      EncApp* pcFirstPassApp = new EncApp;
+      pcFirstPassApp->create();
+      pcFirstPassApp->parseCfg( argc, argv );
+      pcFirstPassApp->setRCFirstPassMode( true );
+      fprintf( stdout, "\nTwo-pass rate control: analysis pass\n" );
+      pcFirstPassApp->encode();
+      pcFirstPassApp->destroy();
+      delete pcFirstPassApp;
+      fprintf( stdout, "\nTwo-pass rate control: final pass\n" );
+    }
     pcEncApp->encode();
 #ifndef _DEBUG
   }
@@ -0,0 +1,650 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchApp.cpp
+    \brief    Kernel benchmark application class
+*/
+
+#include "KernelBenchApp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "CommonLib/Unit.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/AffineGradientSearch.h"
+
+//! \ingroup KernelBenchApp
+//! \{
+
+#if ENABLE_SIMD_OPT && defined( TARGET_SIMD_X86 )
+
+static const int BENCH_MAX_SIZE = 128;
+static const int BENCH_MARGIN   = 16;
+static const int BENCH_STRIDE   = BENCH_MAX_SIZE + 2 * BENCH_MARGIN;
+
+enum BenchPlane
+{
+  BENCH_ORG = 0,    // original samples
+  BENCH_REF,        // reference samples, close to the original
+  BENCH_PRED0,      // intermediate (IF_INTERNAL_PREC) prediction samples
+  BENCH_PRED1,
+  BENCH_RESI,       // residual samples
+  BENCH_DST,        // output samples
+  BENCH_GRAD_X,     // output gradients
+  BENCH_GRAD_Y,
+  NUM_BENCH_PLANES
+};
+
+/// kernel tables of one vector extension together with the buffers the kernels operate on
+struct KernelBenchContext
+{
+  PelBufferOps          pelBufOps;
+  InterpolationFilter   interpFilter;
+  RdCost                rdCost;
+  AdaptiveLoopFilter    alf;
+  AffineGradientSearch  affineGradSearch;
+
+  int                   width;
+  int                   height;
+  int                   bitDepth;
+  ClpRng                clpRng;
+
+  Pel*                  planes[NUM_BENCH_PLANES];
+  int*                  derivatesIn[2];
+  int*                  derivatesOut[2];
+  int64_t               equalCoeff[7][7];
+  Distortion            dist;
+  DistParam             distParam;
+
+  AlfClassifier*        classifierData;
+  AlfClassifier*        classifier[BENCH_MAX_SIZE];
+  int                   laplacianData[NUM_DIRECTIONS][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5];
+  int*                  laplacianPtr[NUM_DIRECTIONS][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5];
+  int**                 laplacian[NUM_DIRECTIONS];
+
+  KernelBenchContext();
+  ~KernelBenchContext();
+
+  Pel*      buf         ( BenchPlane plane ) { return planes[plane] + BENCH_MARGIN * BENCH_STRIDE + BENCH_MARGIN; }
+  void      setSimd     ( X86_VEXT vext );
+  void      setBlock    ( int blkWidth, int blkHeight, int blkBitDepth );
+  void      clearOutput ();
+  uint64_t  getChecksum () const;
+
+private:
+  template<X86_VEXT vext>
+  void      xInitSimd   ();
+};
+
+KernelBenchContext::KernelBenchContext()
+  : width( 0 )
+  , height( 0 )
+  , bitDepth( 0 )
+  , dist( 0 )
+{
+  for( int i = 0; i < NUM_BENCH_PLANES; i++ )
+  {
+    planes[i] = ( Pel* ) xMalloc( Pel, BENCH_STRIDE * BENCH_STRIDE );
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    derivatesIn[i]  = ( int* ) xMalloc( int, BENCH_MAX_SIZE * BENCH_MAX_SIZE );
+    derivatesOut[i] = ( int* ) xMalloc( int, BENCH_MAX_SIZE * BENCH_MAX_SIZE );
+  }
+  classifierData = new AlfClassifier[BENCH_MAX_SIZE * BENCH_MAX_SIZE];
+  for( int i = 0; i < BENCH_MAX_SIZE; i++ )
+  {
+    classifier[i] = classifierData + i * BENCH_MAX_SIZE;
+  }
+  for( int i = 0; i < NUM_DIRECTIONS; i++ )
+  {
+    laplacian[i] = laplacianPtr[i];
+    for( int j = 0; j < AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5; j++ )
+    {
+      laplacianPtr[i][j] = laplacianData[i][j];
+    }
+  }
+  clpRng.min = 0;
+  clpRng.max = 0;
+  clpRng.bd  = 0;
+  clpRng.n   = 0;
+  clearOutput();
+}
+
+KernelBenchContext::~KernelBenchContext()
+{
+  for( int i = 0; i < NUM_BENCH_PLANES; i++ )
+  {
+    xFree( planes[i] );
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    xFree( derivatesIn[i] );
+    xFree( derivatesOut[i] );
+  }
+  delete[] classifierData;
+}
+
+template<X86_VEXT vext>
+void KernelBenchContext::xInitSimd()
+{
+#if ENABLE_SIMD_OPT_BUFFER
+  pelBufOps._initPelBufOpsX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+  interpFilter._initInterpolationFilterX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_DIST
+  rdCost._initRdCostX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_ALF
+  alf._initAdaptiveLoopFilterX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_AFFINE_ME
+  affineGradSearch._initAffineGradientSearchX86<vext>();
+#endif
+}
+
+void KernelBenchContext::setSimd( X86_VEXT vext )
+{
+  // start from the scalar kernels, the run-time dispatch is pinned to SCALAR by the application
+  pelBufOps    = PelBufferOps();
+  interpFilter = InterpolationFilter();
+  rdCost.init();
+  alf.m_deriveClassificationBlk = AdaptiveLoopFilter::deriveClassificationBlk;
+  affineGradSearch.m_HorizontalSobelFilter = AffineGradientSearch::xHorizontalSobelFilter;
+  affineGradSearch.m_VerticalSobelFilter   = AffineGradientSearch::xVerticalSobelFilter;
+  affineGradSearch.m_EqualCoeffComputer    = AffineGradientSearch::xEqualCoeffComputer;
+
+  switch( vext )
+  {
+  case AVX512:
+  case AVX2:
+    xInitSimd<AVX2>();
+    break;
+  case AVX:
+    xInitSimd<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    xInitSimd<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+
+void KernelBenchContext::setBlock( int blkWidth, int blkHeight, int blkBitDepth )
+{
+  width      = blkWidth;
+  height     = blkHeight;
+  bitDepth   = blkBitDepth;
+  clpRng.min = 0;
+  clpRng.max = ( 1 << bitDepth ) - 1;
+  clpRng.bd  = bitDepth;
+  clpRng.n   = 0;
+
+  // identical input for all vector extensions, including the margins read by the filters
+  std::mt19937 gen( 1000 + bitDepth );
+  std::uniform_int_distribution<int> sample( 0, clpRng.max );
+  std::uniform_int_distribution<int> noise( -8, 8 );
+  std::uniform_int_distribution<int> resi( -( 1 << ( bitDepth - 1 ) ), ( 1 << ( bitDepth - 1 ) ) );
+  std::uniform_int_distribution<int> derivate( -( 1 << ( bitDepth + 2 ) ), ( 1 << ( bitDepth + 2 ) ) );
+  const int predShift = IF_INTERNAL_PREC - bitDepth;
+
+  for( int i = 0; i < BENCH_STRIDE * BENCH_STRIDE; i++ )
+  {
+    const int org = sample( gen );
+    planes[BENCH_ORG][i]   = org;
+    planes[BENCH_REF][i]   = Clip3( 0, clpRng.max, org + noise( gen ) );
+    planes[BENCH_PRED0][i] = ( Pel ) ( ( org << predShift ) - IF_INTERNAL_OFFS );
+    planes[BENCH_PRED1][i] = ( Pel ) ( ( sample( gen ) << predShift ) - IF_INTERNAL_OFFS );
+    planes[BENCH_RESI][i]  = resi( gen );
+  }
+  for( int i = 0; i < BENCH_MAX_SIZE * BENCH_MAX_SIZE; i++ )
+  {
+    derivatesIn[0][i] = derivate( gen );
+    derivatesIn[1][i] = derivate( gen );
+  }
+}
+
+void KernelBenchContext::clearOutput()
+{
+  for( int i = BENCH_DST; i < NUM_BENCH_PLANES; i++ )
+  {
+    ::memset( planes[i], 0, sizeof( Pel ) * BENCH_STRIDE * BENCH_STRIDE );
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    ::memset( derivatesOut[i], 0, sizeof( int ) * BENCH_MAX_SIZE * BENCH_MAX_SIZE );
+  }
+  ::memset( equalCoeff, 0, sizeof( equalCoeff ) );
+  for( int i = 0; i < BENCH_MAX_SIZE * BENCH_MAX_SIZE; i++ )
+  {
+    classifierData[i] = AlfClassifier( 0, 0 );
+  }
+  dist = 0;
+}
+
+static inline uint64_t xHash( uint64_t hash, const void* data, size_t size )
+{
+  // FNV-1a
+  const uint8_t* bytes = ( const uint8_t* ) data;
+  for( size_t i = 0; i < size; i++ )
+  {
+    hash = ( hash ^ bytes[i] ) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+uint64_t KernelBenchContext::getChecksum() const
+{
+  // all planes are included, since some kernels operate in place
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for( int i = 0; i < NUM_BENCH_PLANES; i++ )
+  {
+    hash = xHash( hash, planes[i], sizeof( Pel ) * BENCH_STRIDE * BENCH_STRIDE );
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    hash = xHash( hash, derivatesOut[i], sizeof( int ) * BENCH_MAX_SIZE * BENCH_MAX_SIZE );
+  }
+  hash = xHash( hash, equalCoeff, sizeof( equalCoeff ) );
+  hash = xHash( hash, &dist, sizeof( dist ) );
+  for( int i = 0; i < BENCH_MAX_SIZE * BENCH_MAX_SIZE; i++ )
+  {
+    const uint8_t cls[2] = { classifierData[i].classIdx, classifierData[i].transposeIdx };
+    hash = xHash( hash, cls, sizeof( cls ) );
+  }
+  return hash;
+}
+
+// ====================================================================================================================
+// Kernels
+// ====================================================================================================================
+
+typedef void ( *KernelBenchFunc )( KernelBenchContext& ctx );
+
+/// one benchmarked kernel, square blocks between minSize and maxSize are measured
+struct KernelBenchEntry
+{
+  const char*     name;
+  int             minSize;
+  int             maxSize;
+  KernelBenchFunc prepare;                            ///< called once per measurement, may be NULL
+  KernelBenchFunc run;                                ///< the timed call
+};
+
+static void benchAddAvg( KernelBenchContext& ctx )
+{
+  const int shiftNum = std::max<int>( 2, IF_INTERNAL_PREC - ctx.bitDepth ) + 1;
+  const int offset   = ( 1 << ( shiftNum - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+  ( ( ctx.width & 7 ) == 0 ? ctx.pelBufOps.addAvg8 : ctx.pelBufOps.addAvg4 )( ctx.buf( BENCH_PRED0 ), BENCH_STRIDE, ctx.buf( BENCH_PRED1 ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height, shiftNum, offset, ctx.clpRng );
+}
+
+static void benchReco( KernelBenchContext& ctx )
+{
+  ( ( ctx.width & 7 ) == 0 ? ctx.pelBufOps.reco8 : ctx.pelBufOps.reco4 )( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.buf( BENCH_RESI ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height, ctx.clpRng );
+}
+
+static void benchLinTf( KernelBenchContext& ctx )
+{
+  ( ( ctx.width & 7 ) == 0 ? ctx.pelBufOps.linTf8 : ctx.pelBufOps.linTf4 )( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height, 3, 1, 4, ctx.clpRng, true );
+}
+
+static void benchCopyBuffer( KernelBenchContext& ctx )
+{
+  ctx.pelBufOps.copyBuffer( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height );
+}
+
+#if ENABLE_SIMD_OPT_GBI
+static void benchRemoveHighFreq( KernelBenchContext& ctx )
+{
+  ( ( ctx.width & 7 ) == 0 ? ctx.pelBufOps.removeHighFreq8 : ctx.pelBufOps.removeHighFreq4 )( ctx.buf( BENCH_PRED0 ), BENCH_STRIDE, ctx.buf( BENCH_PRED1 ), BENCH_STRIDE, ctx.width, ctx.height );
+}
+#endif
+
+static void benchBioGradFilter( KernelBenchContext& ctx )
+{
+  // the BDOF gradients are derived on the block extended by BIO_EXTEND_SIZE
+  const int offset = BIO_EXTEND_SIZE * BENCH_STRIDE + BIO_EXTEND_SIZE;
+  ctx.pelBufOps.bioGradFilter( ctx.buf( BENCH_PRED0 ) - offset, BENCH_STRIDE, ctx.width + 2 * BIO_EXTEND_SIZE, ctx.height + 2 * BIO_EXTEND_SIZE, BENCH_STRIDE, ctx.buf( BENCH_GRAD_X ) - offset, ctx.buf( BENCH_GRAD_Y ) - offset, ctx.bitDepth );
+}
+
+static void benchInterpHorLuma( KernelBenchContext& ctx )
+{
+  ctx.interpFilter.filterHor( COMPONENT_Y, ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height, 8, false, CHROMA_420, ctx.clpRng );
+}
+
+static void benchInterpVerLuma( KernelBenchContext& ctx )
+{
+  ctx.interpFilter.filterVer( COMPONENT_Y, ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height, 8, true, true, CHROMA_420, ctx.clpRng );
+}
+
+static void benchInterpHorChroma( KernelBenchContext& ctx )
+{
+  ctx.interpFilter.filterHor( COMPONENT_Cb, ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height, 16, false, CHROMA_420, ctx.clpRng );
+}
+
+static void benchInterpVerChroma( KernelBenchContext& ctx )
+{
+  ctx.interpFilter.filterVer( COMPONENT_Cb, ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.buf( BENCH_DST ), BENCH_STRIDE, ctx.width, ctx.height, 16, true, true, CHROMA_420, ctx.clpRng );
+}
+
+static void prepareSAD( KernelBenchContext& ctx )
+{
+  ctx.rdCost.setDistParam( ctx.distParam, CPelBuf( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.width, ctx.height ), ctx.buf( BENCH_REF ), BENCH_STRIDE, ctx.bitDepth, COMPONENT_Y );
+}
+
+static void prepareHAD( KernelBenchContext& ctx )
+{
+  ctx.rdCost.setDistParam( ctx.distParam, CPelBuf( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.width, ctx.height ), ctx.buf( BENCH_REF ), BENCH_STRIDE, ctx.bitDepth, COMPONENT_Y, 0, 1, true );
+}
+
+static void benchDistParam( KernelBenchContext& ctx )
+{
+  ctx.dist = ctx.distParam.distFunc( ctx.distParam );
+}
+
+static void benchSSE( KernelBenchContext& ctx )
+{
+  ctx.dist = ctx.rdCost.getDistPart( CPelBuf( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.width, ctx.height ), CPelBuf( ctx.buf( BENCH_REF ), BENCH_STRIDE, ctx.width, ctx.height ), ctx.bitDepth, COMPONENT_Y, DF_SSE );
+}
+
+static void benchAlfClassification( KernelBenchContext& ctx )
+{
+  const Area blk( 0, 0, ctx.width, ctx.height );
+#if JVET_O0625_ALF_PADDING
+  const int alfBryList[4] = { ALF_NONE_BOUNDARY, ALF_NONE_BOUNDARY, ALF_NONE_BOUNDARY, ALF_NONE_BOUNDARY };
+  ctx.alf.m_deriveClassificationBlk( ctx.classifier, ctx.laplacian, CPelBuf( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.width, ctx.height ), blk, blk, ctx.bitDepth + 4, BENCH_MAX_SIZE, BENCH_MAX_SIZE - ALF_VB_POS_ABOVE_CTUROW_LUMA, alfBryList );
+#else
+  ctx.alf.m_deriveClassificationBlk( ctx.classifier, ctx.laplacian, CPelBuf( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.width, ctx.height ), blk, blk, ctx.bitDepth + 4, BENCH_MAX_SIZE, BENCH_MAX_SIZE - ALF_VB_POS_ABOVE_CTUROW_LUMA );
+#endif
+}
+
+static void benchSobelHor( KernelBenchContext& ctx )
+{
+  ctx.affineGradSearch.m_HorizontalSobelFilter( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.derivatesOut[0], ctx.width, ctx.width, ctx.height );
+}
+
+static void benchSobelVer( KernelBenchContext& ctx )
+{
+  ctx.affineGradSearch.m_VerticalSobelFilter( ctx.buf( BENCH_ORG ), BENCH_STRIDE, ctx.derivatesOut[1], ctx.width, ctx.width, ctx.height );
+}
+
+static void benchEqualCoeff( KernelBenchContext& ctx )
+{
+  ctx.affineGradSearch.m_EqualCoeffComputer( ctx.buf( BENCH_RESI ), BENCH_STRIDE, ctx.derivatesIn, ctx.width, ctx.equalCoeff, ctx.width, ctx.height, true );
+}
+
+static const KernelBenchEntry g_benchKernels[] =
+{
+  { "AddAvg",               4, 128, NULL,       benchAddAvg            },
+  { "Reco",                 4, 128, NULL,       benchReco              },
+  { "LinTf",                4, 128, NULL,       benchLinTf             },
+  { "CopyBuffer",           4, 128, NULL,       benchCopyBuffer        },
+#if ENABLE_SIMD_OPT_GBI
+  { "RemoveHighFreq",       4, 128, NULL,       benchRemoveHighFreq    },
+#endif
+  { "BioGradFilter",        8,  32, NULL,       benchBioGradFilter     },
+  { "InterpHorLuma",        4, 128, NULL,       benchInterpHorLuma     },
+  { "InterpVerLuma",        4, 128, NULL,       benchInterpVerLuma     },
+  { "InterpHorChroma",      4,  64, NULL,       benchInterpHorChroma   },
+  { "InterpVerChroma",      4,  64, NULL,       benchInterpVerChroma   },
+  { "SAD",                  4, 128, prepareSAD, benchDistParam         },
+  { "HAD",                  4, 128, prepareHAD, benchDistParam         },
+  { "SSE",                  4, 128, NULL,       benchSSE               },
+  { "AlfClassification",    8,  32, NULL,       benchAlfClassification },
+  { "SobelHor",             8, 128, NULL,       benchSobelHor          },
+  { "SobelVer",             8, 128, NULL,       benchSobelVer          },
+  { "EqualCoeff",           8, 128, NULL,       benchEqualCoeff        },
+};
+
+static const char* getSimdName( X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case SSE41:  return "SSE41";
+  case SSE42:  return "SSE42";
+  case AVX:    return "AVX";
+  case AVX2:   return "AVX2";
+  case AVX512: return "AVX512";
+  default:     return "SCALAR";
+  }
+}
+
+#endif // ENABLE_SIMD_OPT && defined( TARGET_SIMD_X86 )
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+KernelBenchApp::KernelBenchApp()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/**
+ - pin the run-time dispatch to the scalar kernels
+ - measure every selected kernel for each vector extension supported by the CPU
+ - compare the output of the vector extensions against the scalar reference
+ - write the results
+ */
+int KernelBenchApp::run()
+{
+#if ENABLE_SIMD_OPT && defined( TARGET_SIMD_X86 )
+  X86_VEXT maxVext = _get_x86_extensions();
+  if( !m_simd.empty() )
+  {
+    int reqVext = -1;
+    for( int i = SCALAR; i <= AVX512; i++ )
+    {
+      if( m_simd == getSimdName( X86_VEXT( i ) ) )
+      {
+        reqVext = i;
+      }
+    }
+    if( reqVext < 0 )
+    {
+      std::cerr << "Unknown vector extension " << m_simd << ", aborting" << std::endl;
+      return -1;
+    }
+    if( reqVext > maxVext )
+    {
+      std::cerr << "Vector extension " << m_simd << " not supported by the CPU, measuring up to " << getSimdName( maxVext ) << std::endl;
+    }
+    maxVext = std::min( maxVext, X86_VEXT( reqVext ) );
+  }
+
+  // the kernel tables are initialized explicitly per vector extension below
+  read_x86_extension_flags( "SCALAR" );
+
+  std::vector<X86_VEXT> levels;
+  const X86_VEXT benchLevels[] = { SCALAR, SSE41, AVX, AVX2 };
+  for( auto vext : benchLevels )
+  {
+    if( vext <= maxVext )
+    {
+      levels.push_back( vext );
+    }
+  }
+
+  KernelBenchContext* ctx = new KernelBenchContext;
+  int numMismatches = 0;
+
+  for( auto bitDepth : m_bitDepths )
+  {
+    for( const KernelBenchEntry& kernel : g_benchKernels )
+    {
+      if( !xIsKernelSelected( kernel.name ) )
+      {
+        continue;
+      }
+      for( int size = std::max( kernel.minSize, m_minBlockSize ); size <= std::min( kernel.maxSize, m_maxBlockSize ); size <<= 1 )
+      {
+        const int iterations = std::max( 10, int( int64_t( m_iterations ) * 256 / ( size * size ) ) );
+        double   scalarNs    = 0.0;
+        uint64_t scalarHash  = 0;
+
+        for( auto vext : levels )
+        {
+          ctx->setSimd( vext );
+          ctx->setBlock( size, size, bitDepth );
+          if( kernel.prepare )
+          {
+            kernel.prepare( *ctx );
+          }
+
+          // verification call on cleared output
+          ctx->clearOutput();
+          kernel.run( *ctx );
+          const uint64_t hash = ctx->getChecksum();
+
+          const auto start = std::chrono::steady_clock::now();
+          for( int i = 0; i < iterations; i++ )
+          {
+            kernel.run( *ctx );
+          }
+          const auto end = std::chrono::steady_clock::now();
+          const double ns = std::chrono::duration<double, std::nano>( end - start ).count() / iterations;
+
+          if( vext == SCALAR )
+          {
+            scalarNs   = ns;
+            scalarHash = hash;
+          }
+
+          KernelBenchResult result;
+          result.kernel     = kernel.name;
+          result.simd       = getSimdName( vext );
+          result.width      = size;
+          result.height     = size;
+          result.bitDepth   = bitDepth;
+          result.iterations = iterations;
+          result.nsPerCall  = ns;
+          result.speedup    = ns > 0.0 ? scalarNs / ns : 0.0;
+          result.match      = hash == scalarHash;
+          m_results.push_back( result );
+
+          if( !result.match )
+          {
+            numMismatches++;
+            std::cerr << "Mismatch: " << result.kernel << " " << result.simd << " " << size << "x" << size << " " << bitDepth << " bit" << std::endl;
+          }
+        }
+      }
+    }
+  }
+
+  delete ctx;
+
+  if( m_outputFileName.empty() )
+  {
+    m_outputFormat == "json" ? xWriteJson( std::cout ) : xWriteCsv( std::cout );
+  }
+  else
+  {
+    std::ofstream os( m_outputFileName.c_str() );
+    if( !os )
+    {
+      std::cerr << "Failed to open output file " << m_outputFileName << std::endl;
+      return -1;
+    }
+    m_outputFormat == "json" ? xWriteJson( os ) : xWriteCsv( os );
+  }
+
+  return numMismatches;
+#else
+  std::cerr << "Kernel benchmark requires a build with x86 SIMD optimizations" << std::endl;
+  return 0;
+#endif
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+bool KernelBenchApp::xIsKernelSelected( const std::string& name ) const
+{
+  if( m_kernels.empty() )
+  {
+    return true;
+  }
+  std::istringstream kernels( m_kernels );
+  std::string kernel;
+  while( std::getline( kernels, kernel, ',' ) )
+  {
+    if( kernel == name )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void KernelBenchApp::xWriteCsv( std::ostream& os ) const
+{
+  os << "kernel,simd,width,height,bitDepth,iterations,nsPerCall,speedup,match\n";
+  for( const auto& r : m_results )
+  {
+    os << r.kernel << "," << r.simd << "," << r.width << "," << r.height << "," << r.bitDepth << "," << r.iterations << ","
+       << std::fixed << std::setprecision( 2 ) << r.nsPerCall << "," << r.speedup << "," << ( r.match ? 1 : 0 ) << "\n";
+  }
+}
+
+void KernelBenchApp::xWriteJson( std::ostream& os ) const
+{
+  os << "{\n  \"results\": [\n";
+  for( size_t i = 0; i < m_results.size(); i++ )
+  {
+    const KernelBenchResult& r = m_results[i];
+    os << "    { \"kernel\": \"" << r.kernel << "\", \"simd\": \"" << r.simd << "\", \"width\": " << r.width << ", \"height\": " << r.height
+       << ", \"bitDepth\": " << r.bitDepth << ", \"iterations\": " << r.iterations << ", \"nsPerCall\": " << std::fixed << std::setprecision( 2 ) << r.nsPerCall
+       << ", \"speedup\": " << r.speedup << ", \"match\": " << ( r.match ? "true" : "false" ) << " }" << ( i + 1 < m_results.size() ? "," : "" ) << "\n";
+  }
+  os << "  ]\n}\n";
+}
+
+//! \}
@@ -0,0 +1,151 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchAppCfg.cpp
+    \brief    Kernel benchmark configuration class
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "KernelBenchAppCfg.h"
+#include "Utilities/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup KernelBenchApp
+//! \{
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+bool KernelBenchAppCfg::parseCfg( int argc, char* argv[] )
+{
+  bool do_help = false;
+  string bitDepths;
+  po::Options opts;
+  opts.addOptions()
+
+  ("help",                      do_help,                               false,      "this help text")
+  ("SIMD",                      m_simd,                                string(""), "highest vector extension to be measured (SCALAR, SSE41, AVX, AVX2), default: CPU maximum")
+  ("Kernels,k",                 m_kernels,                             string(""), "comma separated list of kernels to be measured, default: all")
+  ("BitDepths",                 bitDepths,                             string("8,10"), "comma separated list of internal bit depths")
+  ("MinBlockSize",              m_minBlockSize,                        4,          "smallest block size to be measured")
+  ("MaxBlockSize",              m_maxBlockSize,                        128,        "largest block size to be measured")
+  ("Iterations,n",              m_iterations,                          20000,      "number of kernel calls for a 16x16 block, scaled with the block area")
+  ("OutputFile,o",              m_outputFileName,                      string(""), "result file name, default: stdout")
+  ("OutputFormat,f",            m_outputFormat,                        string("csv"), "result format (csv or json)")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const char*>& argv_unhandled = po::scanArgv(opts, argc, (const char**) argv, err);
+
+  for (list<const char*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    std::cerr << "Unhandled argument ignored: "<< *it << std::endl;
+  }
+
+  if (do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    /* errors have already been reported to stderr */
+    return false;
+  }
+
+  m_bitDepths.clear();
+  std::replace( bitDepths.begin(), bitDepths.end(), ',', ' ' );
+  std::istringstream bitDepthStream( bitDepths );
+  int bitDepth;
+  while( bitDepthStream >> bitDepth )
+  {
+    if( bitDepth < 8 || bitDepth > 12 )
+    {
+      std::cerr << "Unsupported bit depth " << bitDepth << ", aborting" << std::endl;
+      return false;
+    }
+    m_bitDepths.push_back( bitDepth );
+  }
+  if( m_bitDepths.empty() )
+  {
+    std::cerr << "No bit depth specified, aborting" << std::endl;
+    return false;
+  }
+  if( m_minBlockSize < 4 || m_maxBlockSize > 128 || m_minBlockSize > m_maxBlockSize )
+  {
+    std::cerr << "Block sizes must be in the range 4..128, aborting" << std::endl;
+    return false;
+  }
+  if( m_iterations < 1 )
+  {
+    std::cerr << "Number of iterations must be positive, aborting" << std::endl;
+    return false;
+  }
+  if( m_outputFormat != "csv" && m_outputFormat != "json" )
+  {
+    std::cerr << "Unsupported output format " << m_outputFormat << ", aborting" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+KernelBenchAppCfg::KernelBenchAppCfg()
+: m_simd()
+, m_kernels()
+, m_minBlockSize( 4 )
+, m_maxBlockSize( 128 )
+, m_iterations( 20000 )
+, m_outputFileName()
+, m_outputFormat( "csv" )
+{
+}
+
+KernelBenchAppCfg::~KernelBenchAppCfg()
+{
+}
+
+//! \}
@@ -39,6 +39,7 @@
 
 #include "CodingStructure.h"
 #include "Picture.h"
+#include "StageProfiler.h"
 #include <array>
 #include <cmath>
 
@@ -338,8 +339,9 @@ const int AdaptiveLoopFilter::m_classToFilterMapping[NUM_FIXED_FILTER_SETS][MAX_
   { 16,  31,  32,  15,  60,  30,   4,  17,  19,  25,  22,  20,   4,  53,  19,  21,  22,  46,  25,  55,  26,  48,  63,  58,  55 },
 };
 
-void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
+void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs, const bool extendPicBorder)
 {
+  PROFILE_STAGE( PROF_STAGE_ALF );
   if (!cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Y) && !cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Cb) && !cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Cr))
   {
     return;
@@ -380,6 +382,12 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 
   for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
   {
+    if( extendPicBorder )
+    {
+      // the CTU rows above are final, extend their borders while they are still in the cache
+      cs.picture->extendPicBorder( yPos );
+    }
+
     for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
     {
       const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
@@ -558,6 +566,11 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
       ctuIdx++;
     }
   }
+
+  if( extendPicBorder )
+  {
+    cs.picture->extendPicBorder();
+  }
 }
 
 void AdaptiveLoopFilter::reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo)
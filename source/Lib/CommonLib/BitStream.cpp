@@ -179,9 +179,17 @@ void   OutputBitstream::addSubstream( OutputBitstream* pcSubstream )
   uint32_t uiNumBits = pcSubstream->getNumberOfWrittenBits();
 
   const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  if (m_num_held_bits == 0)
+  {
+    // byte aligned, the complete bytes can be appended as a whole
+    m_fifo.insert(m_fifo.end(), rbsp.begin(), rbsp.end());
+  }
+  else
   {
-    write(*it++, 8);
+    for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+    {
+      write(*it++, 8);
+    }
   }
   if (uiNumBits&0x7)
   {
@@ -399,6 +399,7 @@ PelBufferOps::PelBufferOps()
 
   copyBuffer = copyBufferCore;
   padding = paddingCore;
+  mapPWL = mapPWLCore;
 #if ENABLE_SIMD_OPT_GBI
   removeWeightHighFreq8 = removeWeightHighFreq;
   removeWeightHighFreq4 = removeWeightHighFreq;
@@ -417,6 +418,24 @@ PelBufferOps::PelBufferOps()
 
 PelBufferOps g_pelBufOP = PelBufferOps();
 
+void mapPWLCore( Pel *ptr, int stride, int width, int height, const PWLMapping& pwl )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const Pel val = ptr[x];
+      int       idx = 0;
+      while( idx < PIC_CODE_CW_BINS - 1 && val >= pwl.threshold[idx] )
+      {
+        idx++;
+      }
+      ptr[x] = Clip3( (Pel)0, pwl.maxVal, (Pel)( pwl.outBase[idx] + ( ( pwl.scale[idx] * ( val - pwl.inBase[idx] ) + ( 1 << ( FP_PREC - 1 ) ) ) >> FP_PREC ) ) );
+    }
+    ptr += stride;
+  }
+}
+
 void copyBufferCore(Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height)
 {
   int numBytes = width * sizeof(Pel);
@@ -482,19 +501,9 @@ void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBu
 }
 
 template<>
-void AreaBuf<Pel>::rspSignal(std::vector<Pel>& pLUT)
+void AreaBuf<Pel>::rspSignal( const PWLMapping& pwl )
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-    for (unsigned y = 0; y < height; y++)
-    {
-      for (unsigned x = 0; x < width; x++)
-      {
-        dst[x] = pLUT[src[x]];
-      }
-      dst += stride;
-      src += stride;
-    }
+  g_pelBufOP.mapPWL( buf, stride, width, height, pwl );
 }
 
 template<>
@@ -51,6 +51,16 @@
 // AreaBuf struct
 // ---------------------------------------------------------------------------
 
+/// piecewise-linear sample mapping over PIC_CODE_CW_BINS segments, used for the LMCS luma mapping
+struct PWLMapping
+{
+  Pel     threshold[PIC_CODE_CW_BINS - 1]; ///< a sample v lies on segment #{ j : v >= threshold[j] }
+  Pel     inBase   [PIC_CODE_CW_BINS];
+  Pel     outBase  [PIC_CODE_CW_BINS];
+  int32_t scale    [PIC_CODE_CW_BINS];     ///< slope in FP_PREC fixed point precision
+  Pel     maxVal;
+};
+
 struct PelBufferOps
 {
   PelBufferOps();
@@ -76,6 +86,7 @@ struct PelBufferOps
   void(*calcBlkGradient)(int sx, int sy, int    *arraysGx2, int     *arraysGxGy, int     *arraysGxdI, int     *arraysGy2, int     *arraysGydI, int     &sGx2, int     &sGy2, int     &sGxGy, int     &sGxdI, int     &sGydI, int width, int height, int unitSize);
   void(*copyBuffer)(Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height);
   void(*padding)(Pel *dst, int stride, int width, int height, int padSize);
+  void(*mapPWL)(Pel *ptr, int stride, int width, int height, const PWLMapping& pwl);
 #if ENABLE_SIMD_OPT_GBI
   void ( *removeWeightHighFreq8)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int gbiWeight);
   void ( *removeWeightHighFreq4)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int gbiWeight);
@@ -94,6 +105,7 @@ extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
+void mapPWLCore(Pel *ptr, int stride, int width, int height, const PWLMapping& pwl);
 
 template<typename T>
 struct AreaBuf : public Size
@@ -141,7 +153,7 @@ struct AreaBuf : public Size
 
   void toLast               ( const ClpRng& clpRng );
 
-  void rspSignal            ( std::vector<Pel>& pLUT );
+  void rspSignal            ( const PWLMapping& pwl );
   void scaleSignal          ( const int scale, const bool dir , const ClpRng& clpRng);
   T    computeAvg           ( ) const;
 
@@ -64,6 +64,8 @@ CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tu
   , parent    ( nullptr )
   , bestCS    ( nullptr )
   , m_isTuEnc ( false )
+  , m_rootCS  ( nullptr )
+  , m_ctuCS   ( nullptr )
   , m_cuCache ( cuCache )
   , m_puCache ( puCache )
   , m_tuCache ( tuCache )
@@ -106,6 +108,8 @@ void CodingStructure::destroy()
 {
   picture   = nullptr;
   parent    = nullptr;
+  m_rootCS  = nullptr;
+  m_ctuCS   = nullptr;
 
   m_pred.destroy();
   m_resi.destroy();
@@ -132,6 +136,8 @@ void CodingStructure::destroy()
   delete[] m_motionBuf;
   m_motionBuf = nullptr;
 
+  m_colMotion.destroy();
+
 
   m_tuCache.cache( tus );
   m_puCache.cache( pus );
@@ -288,99 +294,79 @@ CodingUnit* CodingStructure::getLumaCU( const Position &pos )
 }
 #endif
 
-CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType effChType )
+const CodingStructure* CodingStructure::xGetOwnerCS( const Position &pos, const ChannelType effChType, const bool lumaFromParentInTreeC ) const
 {
-  const CompArea &_blk = area.blocks[effChType];
+  const CodingStructure* cs = this;
 
+  while( cs )
+  {
 #if JVET_O0050_LOCAL_DUAL_TREE
-  if( !_blk.contains( pos ) || (treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
+    const bool useParent = lumaFromParentInTreeC && cs->treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA;
+
+    if( !useParent && cs->area.blocks[effChType].contains( pos ) )
 #else
-  if( !_blk.contains( pos ) )
+    if( cs->area.blocks[effChType].contains( pos ) )
 #endif
-  {
+    {
+      return cs;
+    }
 #if JVET_O0050_LOCAL_DUAL_TREE
     //keep this check, which is helpful to identify bugs
-    if( treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
+    if( useParent )
     {
-      CHECK( parent == nullptr, "parent shall be valid; consider using function getLumaCU()" );
-      CHECK( parent->treeType != TREE_D, "wrong parent treeType " );
+      CHECK( cs->parent == nullptr, "parent shall be valid; consider using function getLumaCU()" );
+      CHECK( cs->parent->treeType != TREE_D, "wrong parent treeType" );
     }
 #endif
-    if( parent ) return parent->getCU( pos, effChType );
-    else         return nullptr;
-  }
-  else
-  {
-    const unsigned idx = m_cuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
 
-    if( idx != 0 ) return cus[ idx - 1 ];
-    else           return nullptr;
+    // positions outside of the CTU-level structure can only be found at the root, skip the levels in between
+    if( cs->m_ctuCS && cs->parent && !cs->m_ctuCS->area.blocks[effChType].contains( pos ) )
+    {
+      cs = cs->m_rootCS;
+    }
+    else
+    {
+      cs = cs->parent;
+    }
   }
+
+  return nullptr;
+}
+
+CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType effChType )
+{
+  return const_cast<CodingUnit*>( const_cast<const CodingStructure*>( this )->getCU( pos, effChType ) );
 }
 
 const CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType effChType ) const
 {
-  const CompArea &_blk = area.blocks[effChType];
+  const CodingStructure* cs = xGetOwnerCS( pos, effChType, true );
 
-#if JVET_O0050_LOCAL_DUAL_TREE
-  if( !_blk.contains( pos ) || (treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
-#else
-  if( !_blk.contains( pos ) )
-#endif
-  {
-#if JVET_O0050_LOCAL_DUAL_TREE
-    if( treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
-    {
-      CHECK( parent == nullptr, "parent shall be valid; consider using function getLumaCU()" );
-      CHECK( parent->treeType != TREE_D, "wrong parent treeType" );
-    }
-#endif
-    if( parent ) return parent->getCU( pos, effChType );
-    else         return nullptr;
-  }
-  else
-  {
-    const unsigned idx = m_cuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
+  if( !cs ) return nullptr;
 
-    if( idx != 0 ) return cus[ idx - 1 ];
-    else           return nullptr;
-  }
+  const CompArea &_blk = cs->area.blocks[effChType];
+  const unsigned idx   = cs->m_cuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, cs->unitScale[effChType] )];
+
+  if( idx != 0 ) return cs->cus[ idx - 1 ];
+  else           return nullptr;
 }
 
 PredictionUnit* CodingStructure::getPU( const Position &pos, const ChannelType effChType )
 {
-  const CompArea &_blk = area.blocks[effChType];
-
-  if( !_blk.contains( pos ) )
-  {
-    if( parent ) return parent->getPU( pos, effChType );
-    else         return nullptr;
-  }
-  else
-  {
-    const unsigned idx = m_puIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
-
-    if( idx != 0 ) return pus[ idx - 1 ];
-    else           return nullptr;
-  }
+  return const_cast<PredictionUnit*>( const_cast<const CodingStructure*>( this )->getPU( pos, effChType ) );
 }
 
 const PredictionUnit * CodingStructure::getPU( const Position &pos, const ChannelType effChType ) const
 {
-  const CompArea &_blk = area.blocks[effChType];
+  const CodingStructure* cs = xGetOwnerCS( pos, effChType, false );
 
-  if( !_blk.contains( pos ) )
-  {
-    if( parent ) return parent->getPU( pos, effChType );
-    else         return nullptr;
-  }
-  else
-  {
-    const unsigned idx = m_puIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
+  if( !cs ) return nullptr;
 
-    if( idx != 0 ) return pus[ idx - 1 ];
-    else           return nullptr;
-  }
+  const CompArea &_blk = cs->area.blocks[effChType];
+  const unsigned idx   = cs->m_puIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, cs->unitScale[effChType] )];
+
+  if( idx != 0 ) return cs->pus[ idx - 1 ];
+  else           return nullptr;
 }
 
 TransformUnit* CodingStructure::getTU( const Position &pos, const ChannelType effChType, const int subTuIdx )
@@ -840,6 +826,8 @@ void CodingStructure::createInternals( const UnitArea& _unit, const bool isTopLa
 
   picture = nullptr;
   parent  = nullptr;
+  m_rootCS = nullptr;
+  m_ctuCS  = nullptr;
 
   unsigned numCh = ::getNumberValidChannels(area.chromaFormat);
 
@@ -864,9 +852,101 @@ void CodingStructure::createInternals( const UnitArea& _unit, const bool isTopLa
 
   unsigned _lumaAreaScaled = g_miScaling.scale( area.lumaSize() ).area();
   m_motionBuf       = new MotionInfo[_lumaAreaScaled];
+  if( isTopLayer ) m_colMotion.create( area.lumaSize() );
   initStructData();
 }
 
+void CodingStructure::storeColMotionField()
+{
+  CHECKD( parent, "The co-located motion field is only kept at picture level" );
+
+  m_colMotion.fill( getMotionBuf() );
+
+  delete[] m_motionBuf;
+  m_motionBuf = nullptr;
+}
+
+void ColMotionField::create( const Size &lumaSize )
+{
+  width  = ( lumaSize.width  + ( 1 << COL_MOTION_LOG2_GRANULARITY ) - 1 ) >> COL_MOTION_LOG2_GRANULARITY;
+  height = ( lumaSize.height + ( 1 << COL_MOTION_LOG2_GRANULARITY ) - 1 ) >> COL_MOTION_LOG2_GRANULARITY;
+
+  const int size = width * height;
+
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    mv    [l] = new Mv    [size];
+    refIdx[l] = new int8_t[size];
+  }
+  sliceIdx = new uint16_t[size];
+
+  clear();
+}
+
+void ColMotionField::destroy()
+{
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    delete[] mv    [l]; mv    [l] = nullptr;
+    delete[] refIdx[l]; refIdx[l] = nullptr;
+  }
+  delete[] sliceIdx; sliceIdx = nullptr;
+
+  width = height = 0;
+}
+
+void ColMotionField::clear()
+{
+  const int size = width * height;
+
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    if( refIdx[l] ) memset( refIdx[l], NOT_VALID, size * sizeof( int8_t ) );
+  }
+}
+
+void ColMotionField::fill( const CMotionBuf &mb )
+{
+  // the motion of each 8x8 block is represented by its top-left 4x4 unit
+  const int step = ( 1 << COL_MOTION_LOG2_GRANULARITY ) >> MIN_CU_LOG2;
+
+  CHECKD( ( int( mb.width ) + step - 1 ) / step != width || ( int( mb.height ) + step - 1 ) / step != height, "Motion buffer does not match the co-located motion field" );
+
+  for( int y = 0, i = 0; y < height; y++ )
+  {
+    const MotionInfo *src = mb.buf + y * step * mb.stride;
+
+    for( int x = 0; x < width; x++, i++, src += step )
+    {
+      if( src->isInter && !src->isIBCmot )
+      {
+        mv    [REF_PIC_LIST_0][i] = src->mv    [REF_PIC_LIST_0];
+        mv    [REF_PIC_LIST_1][i] = src->mv    [REF_PIC_LIST_1];
+        refIdx[REF_PIC_LIST_0][i] = int8_t( src->refIdx[REF_PIC_LIST_0] );
+        refIdx[REF_PIC_LIST_1][i] = int8_t( src->refIdx[REF_PIC_LIST_1] );
+        sliceIdx[i]               = src->sliceIdx;
+      }
+      else
+      {
+        refIdx[REF_PIC_LIST_0][i] = NOT_VALID;
+        refIdx[REF_PIC_LIST_1][i] = NOT_VALID;
+      }
+    }
+  }
+}
+
+void ColMotionField::copyFrom( const ColMotionField &other )
+{
+  const int size = width * height;
+
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    std::copy_n( other.mv    [l], size, mv    [l] );
+    std::copy_n( other.refIdx[l], size, refIdx[l] );
+  }
+  std::copy_n( other.sliceIdx, size, sliceIdx );
+}
+
 void CodingStructure::addMiToLut(static_vector<MotionInfo, MAX_NUM_HMVP_CANDS> &lut, const MotionInfo &mi)
 {
   size_t currCnt = lut.size();
@@ -1019,6 +1099,8 @@ void CodingStructure::initSubStructure( CodingStructure& subStruct, const Channe
 
   subStruct.parent    = this;
   subStruct.picture   = picture;
+  subStruct.m_rootCS  = parent ? m_rootCS : this;
+  subStruct.m_ctuCS   = parent ? m_ctuCS  : &subStruct;
 
   subStruct.sps       = sps;
   subStruct.vps       = vps;
@@ -1306,14 +1388,22 @@ void CodingStructure::copyStructure( const CodingStructure& other, const Channel
 
   if (!other.slice->isIntra() || other.slice->getSPS()->getIBCFlag())
   {
-    // copy motion buffer
-    MotionBuf  ownMB = getMotionBuf();
-    CMotionBuf subMB = other.getMotionBuf();
+    // copy motion buffer, unless only the co-located motion field of the other picture is left
+    if( other.m_motionBuf )
+    {
+      MotionBuf  ownMB = getMotionBuf();
+      CMotionBuf subMB = other.getMotionBuf();
 
-    ownMB.copyFrom( subMB );
+      ownMB.copyFrom( subMB );
+    }
 
     motionLut = other.motionLut;
   }
+
+  if( m_colMotion.width > 0 && m_colMotion.width == other.m_colMotion.width && m_colMotion.height == other.m_colMotion.height )
+  {
+    m_colMotion.copyFrom( other.m_colMotion );
+  }
 #if JVET_O0119_BASE_PALETTE_444
   prevPLT = other.prevPLT;
 #endif
@@ -1382,11 +1472,19 @@ void CodingStructure::initStructData( const int &QP, const bool &_isLosses, cons
     isLossless            = _isLosses;
   }
 
+  if( !m_motionBuf )
+  {
+    // released by storeColMotionField() when the structure was last used for a coded picture
+    m_motionBuf = new MotionInfo[g_miScaling.scale( area.lumaSize() ).area()];
+  }
+
   if (!skipMotBuf && (!parent || ((!slice->isIntra() || slice->getSPS()->getIBCFlag()) && !m_isTuEnc)))
   {
     getMotionBuf()      .memset( 0 );
   }
 
+  m_colMotion.clear();
+
   fracBits = 0;
   dist     = 0;
   cost     = MAX_DOUBLE;
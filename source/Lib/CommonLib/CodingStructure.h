@@ -79,6 +79,32 @@ extern XUCache g_globalUnitCache;
 // coding structure
 // ---------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------
+// compact co-located motion field
+// ---------------------------------------------------------------------------
+
+// motion of a coded picture as seen by TMVP of later pictures: one entry per 8x8 luma block, stored as
+// separate planes; blocks without usable motion (intra, IBC) have both reference indices set to NOT_VALID
+struct ColMotionField
+{
+  int       width;
+  int       height;
+  Mv       *mv      [NUM_REF_PIC_LIST_01];
+  int8_t   *refIdx  [NUM_REF_PIC_LIST_01];
+  uint16_t *sliceIdx;
+
+  ColMotionField() : width( 0 ), height( 0 ), mv{ nullptr, nullptr }, refIdx{ nullptr, nullptr }, sliceIdx( nullptr ) {}
+
+  void create  ( const Size &lumaSize );
+  void destroy ();
+  void clear   ();
+  void fill    ( const CMotionBuf &mb );
+  void copyFrom( const ColMotionField &other );
+
+  int  idx        ( const Position &pos ) const { return ( pos.y >> COL_MOTION_LOG2_GRANULARITY ) * width + ( pos.x >> COL_MOTION_LOG2_GRANULARITY ); }
+  bool isAvailable( const int i )         const { return refIdx[REF_PIC_LIST_0][i] >= 0 || refIdx[REF_PIC_LIST_1][i] >= 0; }
+};
+
 class CodingStructure
 {
 public:
@@ -234,6 +260,14 @@ private:
   // needed for TU encoding
   bool m_isTuEnc;
 
+  // shortcuts in the ancestor chain: the picture-level root and the outermost sub-structure below it (the CTU level).
+  // Positions outside the latter are resolved at the root without walking the intermediate levels, positions inside
+  // it still walk up to the nearest enclosing level (2-3 levels on average)
+  CodingStructure *m_rootCS;
+  CodingStructure *m_ctuCS;
+
+  const CodingStructure* xGetOwnerCS( const Position &pos, const ChannelType effChType, const bool lumaFromParentInTreeC ) const;
+
   unsigned *m_cuIdx   [MAX_NUM_CHANNEL_TYPE];
   unsigned *m_puIdx   [MAX_NUM_CHANNEL_TYPE];
   unsigned *m_tuIdx   [MAX_NUM_CHANNEL_TYPE];
@@ -263,6 +297,7 @@ private:
   int     m_offsets[ MAX_NUM_COMPONENT ];
 
   MotionInfo *m_motionBuf;
+  ColMotionField m_colMotion;
 
 public:
 #if JVET_O0070_PROF
@@ -283,6 +318,11 @@ public:
   MotionInfo& getMotionInfo( const Position& pos );
   const MotionInfo& getMotionInfo( const Position& pos ) const;
 
+  // picture level only: set up once the motion of the picture is final, read by TMVP of later pictures. The per-4x4
+  // motion buffer is released at that point and allocated again when the structure is reused for the next picture
+  void storeColMotionField();
+  const ColMotionField& getColMotionField()      const { return m_colMotion; }
+
 
 public:
   // ---------------------------------------------------------------------------
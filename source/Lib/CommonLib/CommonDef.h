@@ -151,6 +151,7 @@ static const int MAX_NUM_BRICKS_PER_TILE =                          8; ///< max.
 static const int AMVP_MAX_NUM_CANDS =                               2; ///< AMVP: advanced motion vector prediction - max number of final candidates
 static const int AMVP_MAX_NUM_CANDS_MEM =                           3; ///< AMVP: advanced motion vector prediction - max number of candidates
 static const int AMVP_DECIMATION_FACTOR =                           2;
+static const int COL_MOTION_LOG2_GRANULARITY =                      3; ///< log2 of the luma block size at which the motion of co-located pictures is stored
 static const int MRG_MAX_NUM_CANDS =                                6; ///< MERGE
 static const int AFFINE_MRG_MAX_NUM_CANDS =                         5; ///< AFFINE MERGE
 #if JVET_O0455_IBC_MAX_MERGE_NUM
@@ -657,6 +658,7 @@ typedef enum{
 #endif
 
 #ifdef TARGET_SIMD_X86
+X86_VEXT _get_x86_extensions();
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
 #endif
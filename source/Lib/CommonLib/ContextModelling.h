@@ -83,6 +83,8 @@ public:
   bool            isNotFirst      ()                        const { return ( m_subSetId != 0 ); }
   bool            isSigGroup(int scanPosCG) const { return m_sigCoeffGroupFlag[m_scanCG[scanPosCG].idx]; }
   bool            isSigGroup      ()                        const { return m_sigCoeffGroupFlag[ m_subSetPos ]; }
+  // all template neighbours (two to the right, two below, one diagonal) of the current subblock lie inside the block
+  bool            isInnerSubblock ()                        const { return m_subSetPosX + 1 < int( m_widthInGroups ) && m_subSetPosY + 1 < int( m_heightInGroups ) && m_log2CGWidth && m_log2CGHeight; }
   bool            signHiding      ()                        const { return m_signHiding; }
   bool            hideSign        ( int       posFirst,
                                     int       posLast   )   const { return ( m_signHiding && ( posLast - posFirst >= SBH_THRESHOLD ) ); }
@@ -99,6 +101,7 @@ public:
   void            setNumCtxBins   ( int n )                       {          m_remainingContextBins  = n; }
   unsigned        sigGroupCtxId   ( bool ts = false     )   const { return ts ? m_sigGroupCtxIdTS : m_sigGroupCtxId; }
   bool            bdpcm           ()                        const { return m_bdpcm; }
+  template<bool checkBounds = true>
   unsigned sigCtxIdAbs( int scanPos, const TCoeff* coeff, const int state )
   {
     const uint32_t posY      = m_scan[scanPos].y;
@@ -108,22 +111,22 @@ public:
     int           numPos    = 0;
     int           sumAbs    = 0;
 #define UPDATE(x) {int a=abs(x);sumAbs+=std::min(4+(a&1),a);numPos+=!!a;}
-    if( posX < m_width-1 )
+    if( !checkBounds || posX < m_width-1 )
     {
       UPDATE( pData[1] );
-      if( posX < m_width-2 )
+      if( !checkBounds || posX < m_width-2 )
       {
         UPDATE( pData[2] );
       }
-      if( posY < m_height-1 )
+      if( !checkBounds || posY < m_height-1 )
       {
         UPDATE( pData[m_width+1] );
       }
     }
-    if( posY < m_height-1 )
+    if( !checkBounds || posY < m_height-1 )
     {
       UPDATE( pData[m_width] );
-      if( posY < m_height-2 )
+      if( !checkBounds || posY < m_height-2 )
       {
         UPDATE( pData[m_width<<1] );
       }
@@ -165,28 +168,29 @@ public:
   unsigned parityCtxIdAbs   ( uint8_t offset )  const { return m_parFlagCtxSet   ( offset ); }
   unsigned greater1CtxIdAbs ( uint8_t offset )  const { return m_gtxFlagCtxSet[1]( offset ); }
   unsigned greater2CtxIdAbs ( uint8_t offset )  const { return m_gtxFlagCtxSet[0]( offset ); }
+  template<bool checkBounds = true>
   unsigned templateAbsSum( int scanPos, const TCoeff* coeff, int baseLevel )
   {
     const uint32_t  posY  = m_scan[scanPos].y;
     const uint32_t  posX  = m_scan[scanPos].x;
     const TCoeff*   pData = coeff + posX + posY * m_width;
     int             sum   = 0;
-    if (posX < m_width - 1)
+    if (!checkBounds || posX < m_width - 1)
     {
       sum += abs(pData[1]);
-      if (posX < m_width - 2)
+      if (!checkBounds || posX < m_width - 2)
       {
         sum += abs(pData[2]);
       }
-      if (posY < m_height - 1)
+      if (!checkBounds || posY < m_height - 1)
       {
         sum += abs(pData[m_width + 1]);
       }
     }
-    if (posY < m_height - 1)
+    if (!checkBounds || posY < m_height - 1)
     {
       sum += abs(pData[m_width]);
-      if (posY < m_height - 2)
+      if (!checkBounds || posY < m_height - 2)
       {
         sum += abs(pData[m_width << 1]);
       }
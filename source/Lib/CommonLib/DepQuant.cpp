@@ -131,9 +131,10 @@ namespace DQIntern
   class Rom
   {
   public:
-    Rom() : m_scansInitialized(false) {}
+    Rom() : m_scansInitialized(false), m_numUsers(0) {}
     ~Rom() { xUninitScanArrays(); }
-    void                init        ()                       { xInitScanArrays(); }
+    void                init        ()                       { if( m_numUsers++ == 0 ) { xInitScanArrays(); } }
+    void                uninit      ()                       { if( --m_numUsers == 0 ) { xUninitScanArrays(); } }
     const NbInfoSbb*    getNbInfoSbb( int hd, int vd ) const { return m_scanId2NbInfoSbbArray[hd][vd]; }
     const NbInfoOut*    getNbInfoOut( int hd, int vd ) const { return m_scanId2NbInfoOutArray[hd][vd]; }
     const TUParameters* getTUPars   ( const CompArea& area, const ComponentID compID ) const
@@ -145,6 +146,7 @@ namespace DQIntern
     void  xUninitScanArrays ();
   private:
     bool          m_scansInitialized;
+    int           m_numUsers;
     NbInfoSbb*    m_scanId2NbInfoSbbArray[ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ];
     NbInfoOut*    m_scanId2NbInfoOutArray[ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ];
     TUParameters* m_tuParameters         [ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ][ MAX_NUM_CHANNEL_TYPE ];
@@ -1741,7 +1743,8 @@ DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
   const DepQuant* dq = dynamic_cast<const DepQuant*>( other );
   CHECK( other && !dq, "The DepQuant cast must be successfull!" );
   p = new DQIntern::DepQuant();
-  if( enc )
+  m_enc = enc;
+  if( m_enc )
   {
     DQIntern::g_Rom.init();
   }
@@ -1750,6 +1753,11 @@ DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
 DepQuant::~DepQuant()
 {
   delete static_cast<DQIntern::DepQuant*>(p);
+  if( m_enc )
+  {
+    // the scan tables refer to the global scan orders, which are rebuilt when an encoder is re-created
+    DQIntern::g_Rom.uninit();
+  }
 }
 
 void DepQuant::quant( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx )
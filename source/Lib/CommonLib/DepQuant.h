@@ -58,6 +58,7 @@ public:
 
 private:
   void* p;
+  bool  m_enc;
 };
 
 
@@ -46,69 +46,13 @@
  // ====================================================================================================================
 
 int TComHash::m_blockSizeToIndex[65][65];
-TCRCCalculatorLight TComHash::m_crcCalculator1(24, 0x5D6DCB);
-TCRCCalculatorLight TComHash::m_crcCalculator2(24, 0x864CFB);
-
-TCRCCalculatorLight::TCRCCalculatorLight(uint32_t bits, uint32_t truncPoly)
-{
-  m_remainder = 0;
-  m_bits = bits;
-  m_truncPoly = truncPoly;
-  m_finalResultMask = (1 << bits) - 1;
-
-  xInitTable();
-}
-
-TCRCCalculatorLight::~TCRCCalculatorLight()
-{
-
-}
-
-void TCRCCalculatorLight::xInitTable()
-{
-  const uint32_t highBit = 1 << (m_bits - 1);
-  const uint32_t byteHighBit = 1 << (8 - 1);
-
-  for (uint32_t value = 0; value < 256; value++)
-  {
-    uint32_t remainder = 0;
-    for (unsigned char mask = byteHighBit; mask != 0; mask >>= 1)
-    {
-      if (value & mask)
-      {
-        remainder ^= highBit;
-      }
-
-      if (remainder & highBit)
-      {
-        remainder <<= 1;
-        remainder ^= m_truncPoly;
-      }
-      else
-      {
-        remainder <<= 1;
-      }
-    }
-
-    m_table[value] = remainder;
-  }
-}
-
-void TCRCCalculatorLight::processData(unsigned char* curData, uint32_t dataLength)
-{
-  for (uint32_t i = 0; i < dataLength; i++)
-  {
-    unsigned char index = (m_remainder >> (m_bits - 8)) ^ curData[i];
-    m_remainder <<= 8;
-    m_remainder ^= m_table[index];
-  }
-}
-
+uint32_t TComHash::m_crc32cTable[256];
+uint32_t (*TComHash::m_getCRCValue[2])(const unsigned char* p, int length) = { TComHash::xGetCRCValue1, TComHash::xGetCRCValue2 };
 
 TComHash::TComHash()
 {
-  m_lookupTable = NULL;
   tableHasContent = false;
+  m_numThreads = 1;
   for (int i = 0; i < 5; i++)
   {
     hashPic[i] = NULL;
@@ -118,18 +62,10 @@ TComHash::TComHash()
 TComHash::~TComHash()
 {
   clearAll();
-  if (m_lookupTable != NULL)
-  {
-    delete[] m_lookupTable;
-    m_lookupTable = NULL;
-  }
 }
-void TComHash::create(int picWidth, int picHeight)
+void TComHash::create(int picWidth, int picHeight, int numThreads)
 {
-  if (m_lookupTable)
-  {
-    clearAll();
-  }
+  clearAll();
   if (!hashPic[0])
   {
     for (int k = 0; k < 5; k++)
@@ -137,13 +73,7 @@ void TComHash::create(int picWidth, int picHeight)
       hashPic[k] = new uint16_t[picWidth*picHeight];
     }
   }
-  if (m_lookupTable)
-  {
-    return;
-  }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  m_lookupTable = new std::vector<BlockHash>*[maxAddr];
-  memset(m_lookupTable, 0, sizeof(std::vector<BlockHash>*) * maxAddr);
+  m_numThreads = std::max(numThreads, 1);
   tableHasContent = false;
 }
 
@@ -158,76 +88,35 @@ void TComHash::clearAll()
     }
   }
   tableHasContent = false;
-  if (m_lookupTable == NULL)
-  {
-    return;
-  }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  for (int i = 0; i < maxAddr; i++)
-  {
-    if (m_lookupTable[i] != NULL)
-    {
-      delete m_lookupTable[i];
-      m_lookupTable[i] = NULL;
-    }
-  }
-}
-
-void TComHash::addToTable(uint32_t hashValue, const BlockHash& blockHash)
-{
-  if (m_lookupTable[hashValue] == NULL)
-  {
-    m_lookupTable[hashValue] = new std::vector<BlockHash>;
-    m_lookupTable[hashValue]->push_back(blockHash);
-  }
-  else
+  for (int k = 0; k < 5; k++)
   {
-    m_lookupTable[hashValue]->push_back(blockHash);
-  }
-}
-
-int TComHash::count(uint32_t hashValue)
-{
-  if (m_lookupTable[hashValue] == NULL)
-  {
-    return 0;
-  }
-  else
-  {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
+    std::vector<BlockHash>().swap(m_blockHash[k]);
+    std::vector<uint32_t>().swap(m_bucketStart[k]);
   }
 }
 
 int TComHash::count(uint32_t hashValue) const
 {
-  if (m_lookupTable[hashValue] == NULL)
+  const std::vector<uint32_t>& bucketStart = m_bucketStart[hashValue >> m_CRCBits];
+  if (bucketStart.empty())
   {
     return 0;
   }
-  else
-  {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
-  }
-}
-
-MapIterator TComHash::getFirstIterator(uint32_t hashValue)
-{
-  return m_lookupTable[hashValue]->begin();
+  const uint32_t key = hashValue & ((1 << m_CRCBits) - 1);
+  return static_cast<int>(bucketStart[key + 1] - bucketStart[key]);
 }
 
-const MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
+MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
 {
-  return m_lookupTable[hashValue]->begin();
+  const int sizeIdx = hashValue >> m_CRCBits;
+  return m_blockHash[sizeIdx].begin() + m_bucketStart[sizeIdx][hashValue & ((1 << m_CRCBits) - 1)];
 }
 
-bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2)
+bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2) const
 {
-  if (m_lookupTable[hashValue1] == NULL)
-  {
-    return false;
-  }
-  std::vector<BlockHash>::iterator it;
-  for (it = m_lookupTable[hashValue1]->begin(); it != m_lookupTable[hashValue1]->end(); it++)
+  const int num = count(hashValue1);
+  MapIterator it = num > 0 ? getFirstIterator(hashValue1) : MapIterator();
+  for (int i = 0; i < num; i++, it++)
   {
     if ((*it).hashValue2 == hashValue2)
     {
@@ -251,11 +140,13 @@ void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWid
     length *= 3;
     includeChroma = true;
   }
-  unsigned char* p = new unsigned char[length];
 
-  int pos = 0;
+  // the rows are independent of each other
+#pragma omp parallel for num_threads(m_numThreads) if(m_numThreads > 1)
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
+    unsigned char p[12];
+    int pos = yPos * picWidth;
     for (int xPos = 0; xPos < xEnd; xPos++)
     {
       TComHash::getPixelsIn1DCharArrayByBlock2x2(curPicBuf, p, xPos, yPos, bitDepths, includeChroma);
@@ -267,10 +158,7 @@ void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWid
 
       pos++;
     }
-    pos += width - 1;
   }
-
-  delete[] p;
 }
 
 void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3])
@@ -285,10 +173,11 @@ void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, in
 
   int length = 4 * sizeof(uint32_t);
 
-  uint32_t p[4];
-  int pos = 0;
+#pragma omp parallel for num_threads(m_numThreads) if(m_numThreads > 1)
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
+    uint32_t p[4];
+    int pos = yPos * picWidth;
     for (int xPos = 0; xPos < xEnd; xPos++)
     {
       p[0] = srcPicBlockHash[0][pos];
@@ -309,23 +198,12 @@ void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, in
       dstPicBlockSameInfo[1][pos] = srcPicBlockSameInfo[1][pos] && srcPicBlockSameInfo[1][pos + srcWidth] && srcPicBlockSameInfo[1][pos + quadHeight * picWidth]
         && srcPicBlockSameInfo[1][pos + quadHeight * picWidth + srcWidth] && srcPicBlockSameInfo[1][pos + srcHeight * picWidth] && srcPicBlockSameInfo[1][pos + srcHeight * picWidth + srcWidth];
 
-      pos++;
-    }
-    pos += width - 1;
-  }
-
-  if (width >= 4)
-  {
-    pos = 0;
-
-    for (int yPos = 0; yPos < yEnd; yPos++)
-    {
-      for (int xPos = 0; xPos < xEnd; xPos++)
+      if (width >= 4)
       {
         dstPicBlockSameInfo[2][pos] = (!dstPicBlockSameInfo[0][pos] && !dstPicBlockSameInfo[1][pos]);
-        pos++;
       }
-      pos += width - 1;
+
+      pos++;
     }
   }
 }
@@ -338,30 +216,57 @@ void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIs
   bool* srcIsAdded = picIsSame;
   uint32_t* srcHash[2] = { picHash[0], picHash[1] };
 
-  int addValue = m_blockSizeToIndex[width][height];
-  CHECK(addValue < 0, "Wrong")
-  addValue <<= m_CRCBits;
+  int sizeIdx = m_blockSizeToIndex[width][height];
+  CHECK(sizeIdx < 0, "Wrong")
   int crcMask = 1 << m_CRCBits;
   crcMask -= 1;
   int blockIdx = floorLog2(width) - 2;
 
+#pragma omp parallel for num_threads(m_numThreads) if(m_numThreads > 1)
+  for (int yPos = 0; yPos < yEnd; yPos++)
+  {
+    for (int xPos = 0; xPos < xEnd; xPos++)
+    {
+      int pos = yPos * picWidth + xPos;
+      hashPic[blockIdx][pos] = (uint16_t)(srcHash[1][pos] & crcMask);
+    }
+  }
+
+  // count the valid blocks per hash value and derive the start of each bucket
+  std::vector<uint32_t>& bucketStart = m_bucketStart[sizeIdx];
+  bucketStart.assign((1 << m_CRCBits) + 1, 0);
+  for (int yPos = 0; yPos < yEnd; yPos++)
+  {
+    for (int xPos = 0; xPos < xEnd; xPos++)
+    {
+      int pos = yPos * picWidth + xPos;
+      if (srcIsAdded[pos])
+      {
+        bucketStart[(srcHash[0][pos] & crcMask) + 1]++;
+      }
+    }
+  }
+  for (int k = 0; k < (1 << m_CRCBits); k++)
+  {
+    bucketStart[k + 1] += bucketStart[k];
+  }
+
+  // fill the buckets column by column, the search relies on the candidates being in this order
+  std::vector<BlockHash>& blockHashes = m_blockHash[sizeIdx];
+  blockHashes.resize(bucketStart.back());
+  std::vector<uint32_t> fillPos(bucketStart.begin(), bucketStart.end() - 1);
   for (int xPos = 0; xPos < xEnd; xPos++)
   {
     for (int yPos = 0; yPos < yEnd; yPos++)
     {
       int pos = yPos * picWidth + xPos;
-      hashPic[blockIdx][pos] = (uint16_t)(srcHash[1][pos] & crcMask);
       //valid data
       if (srcIsAdded[pos])
       {
-        BlockHash blockHash;
+        BlockHash& blockHash = blockHashes[fillPos[srcHash[0][pos] & crcMask]++];
         blockHash.x = xPos;
         blockHash.y = yPos;
-
-        uint32_t hashValue1 = (srcHash[0][pos] & crcMask) + addValue;
         blockHash.hashValue2 = srcHash[1][pos];
-
-        addToTable(hashValue1, blockHash);
       }
     }
   }
@@ -680,19 +585,44 @@ void TComHash::initBlockSizeToIndex()
   m_blockSizeToIndex[32][32] = 2;
   m_blockSizeToIndex[64][64] = 3;
   m_blockSizeToIndex[4][4] = 4;
+
+  // reflected CRC32-C (Castagnoli) table, matching the SSE4.2 crc32 instruction
+  for (uint32_t value = 0; value < 256; value++)
+  {
+    uint32_t remainder = value;
+    for (int bit = 0; bit < 8; bit++)
+    {
+      remainder = (remainder & 1) ? (remainder >> 1) ^ 0x82F63B78 : remainder >> 1;
+    }
+    m_crc32cTable[value] = remainder;
+  }
+
+#if ENABLE_SIMD_OPT_HASH
+#ifdef TARGET_SIMD_X86
+  initHashX86();
+#endif
+#endif
 }
 
-uint32_t TComHash::getCRCValue1(unsigned char* p, int length)
+// both hash values are CRC32-C truncated to 24 bits, the second one with another seed and processing the data
+// backwards, so that a collision of the first hash value is unlikely to be a collision of the second one
+uint32_t TComHash::xGetCRCValue1(const unsigned char* p, int length)
 {
-  m_crcCalculator1.reset();
-  m_crcCalculator1.processData(p, length);
-  return m_crcCalculator1.getCRC();
+  uint32_t crc = 0;
+  for (int i = 0; i < length; i++)
+  {
+    crc = m_crc32cTable[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+  }
+  return crc & 0xffffff;
 }
 
-uint32_t TComHash::getCRCValue2(unsigned char* p, int length)
+uint32_t TComHash::xGetCRCValue2(const unsigned char* p, int length)
 {
-  m_crcCalculator2.reset();
-  m_crcCalculator2.processData(p, length);
-  return m_crcCalculator2.getCRC();
+  uint32_t crc = 0xffffffff;
+  for (int i = length - 1; i >= 0; i--)
+  {
+    crc = m_crc32cTable[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+  }
+  return crc & 0xffffff;
 }
 //! \}
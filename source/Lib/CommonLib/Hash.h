@@ -56,49 +56,23 @@ struct BlockHash
   uint32_t hashValue2;
 };
 
-typedef std::vector<BlockHash>::iterator MapIterator;
+typedef std::vector<BlockHash>::const_iterator MapIterator;
 
 // ====================================================================================================================
 // Class definitions
 // ====================================================================================================================
 
 
-struct TCRCCalculatorLight
-{
-public:
-  TCRCCalculatorLight(uint32_t bits, uint32_t truncPoly);
-  ~TCRCCalculatorLight();
-
-public:
-  void processData(unsigned char* curData, uint32_t dataLength);
-  void reset() { m_remainder = 0; }
-  uint32_t getCRC() { return m_remainder & m_finalResultMask; }
-
-private:
-  void xInitTable();
-
-private:
-  uint32_t m_remainder;
-  uint32_t m_truncPoly;
-  uint32_t m_bits;
-  uint32_t m_table[256];
-  uint32_t m_finalResultMask;
-};
-
-
 struct TComHash
 {
 public:
   TComHash();
   ~TComHash();
-  void create(int picWidth, int picHeight);
+  void create(int picWidth, int picHeight, int numThreads = 1);
   void clearAll();
-  void addToTable(uint32_t hashValue, const BlockHash& blockHash);
-  int count(uint32_t hashValue);
   int count(uint32_t hashValue) const;
-  MapIterator getFirstIterator(uint32_t hashValue);
-  const MapIterator getFirstIterator(uint32_t hashValue) const;
-  bool hasExactMatch(uint32_t hashValue1, uint32_t hashValue2);
+  MapIterator getFirstIterator(uint32_t hashValue) const;
+  bool hasExactMatch(uint32_t hashValue1, uint32_t hashValue2) const;
 
   void generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3]);
   void generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3]);
@@ -109,8 +83,8 @@ public:
 
 
 public:
-  static uint32_t getCRCValue1(unsigned char* p, int length);
-  static uint32_t getCRCValue2(unsigned char* p, int length);
+  static uint32_t getCRCValue1(unsigned char* p, int length) { return m_getCRCValue[0](p, length); }
+  static uint32_t getCRCValue2(unsigned char* p, int length) { return m_getCRCValue[1](p, length); }
   static void getPixelsIn1DCharArrayByBlock2x2(const PelUnitBuf &curPicBuf, unsigned char* pixelsIn1D, int xStart, int yStart, const BitDepths& bitDepths, bool includeAllComponent = true);
   static bool isBlock2x2RowSameValue(unsigned char* p, bool includeAllComponent = true);
   static bool isBlock2x2ColSameValue(unsigned char* p, bool includeAllComponent = true);
@@ -119,18 +93,34 @@ public:
   static bool isHorizontalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
   static bool isVerticalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
 
+#if ENABLE_SIMD_OPT_HASH
+#ifdef TARGET_SIMD_X86
+  static void initHashX86();
+  template <X86_VEXT vext>
+  static void _initHashX86();
+#endif
+#endif
+
+private:
+  static uint32_t xGetCRCValue1(const unsigned char* p, int length);
+  static uint32_t xGetCRCValue2(const unsigned char* p, int length);
+
 private:
-  std::vector<BlockHash>** m_lookupTable;
+  // compact lookup table: for each block size, the blocks are stored grouped by their hash value,
+  // m_bucketStart[sizeIdx][h] .. m_bucketStart[sizeIdx][h + 1] being the range of hash value h
+  std::vector<BlockHash> m_blockHash[5];
+  std::vector<uint32_t>  m_bucketStart[5];
   bool tableHasContent;
   uint16_t* hashPic[5];//4x4 ~ 64x64
+  int m_numThreads;
 
 private:
   static const int m_CRCBits = 16;
   static const int m_blockSizeBits = 3;
   static int m_blockSizeToIndex[65][65];
 
-  static TCRCCalculatorLight m_crcCalculator1;
-  static TCRCCalculatorLight m_crcCalculator2;
+  static uint32_t m_crc32cTable[256];
+  static uint32_t (*m_getCRCValue[2])(const unsigned char* p, int length);
 };
 
 #endif // __HASH__
@@ -46,6 +46,8 @@ using namespace std;
 //! \ingroup IbcHashMap
 //! \{
 
+static const unsigned int MIN_HASH_TABLE_BITS = 10;
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -55,7 +57,9 @@ IbcHashMap::IbcHashMap()
   m_picWidth = 0;
   m_picHeight = 0;
   m_pos2Hash = NULL;
-  m_computeCrc32c = xxComputeCrc32c16bit;
+  m_hashTableBits = 0;
+  m_numHashEntries = 0;
+  m_calcBlockCrc32c = xxCalcBlockCrc32c;
 
 #if ENABLE_SIMD_OPT_IBC
 #ifdef TARGET_SIMD_X86
@@ -76,6 +80,11 @@ void IbcHashMap::init(const int picWidth, const int picHeight)
   {
     destroy();
   }
+  if (m_pos2Hash != NULL)
+  {
+    // the buffers are reused for pictures of the same size
+    return;
+  }
 
   m_picWidth = picWidth;
   m_picHeight = picHeight;
@@ -85,6 +94,11 @@ void IbcHashMap::init(const int picWidth, const int picHeight)
   {
     m_pos2Hash[n] = m_pos2Hash[n - 1] + m_picWidth;
   }
+
+  const int numPos = std::max(0, m_picWidth - MIN_PU_SIZE + 1) * std::max(0, m_picHeight - MIN_PU_SIZE + 1);
+  m_hashPos.resize(numPos);
+  m_numHashEntries = 0;
+  xxResizeHashTable(MIN_HASH_TABLE_BITS);
 }
 
 void IbcHashMap::destroy()
@@ -98,6 +112,13 @@ void IbcHashMap::destroy()
     delete[] m_pos2Hash;
   }
   m_pos2Hash = NULL;
+  m_picWidth = 0;
+  m_picHeight = 0;
+
+  m_hashTable.clear();
+  m_hashTableBits = 0;
+  m_numHashEntries = 0;
+  m_hashPos.clear();
 }
 ////////////////////////////////////////////////////////
 // CRC32C calculation in C code, same results as SSE 4.2's implementation
@@ -184,13 +205,13 @@ uint32_t IbcHashMap::xxComputeCrc32c16bit(uint32_t crc, const Pel pel)
 // CRC calculation in C code
 ////////////////////////////////////////////////////////
 
-unsigned int IbcHashMap::xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc)
+uint32_t IbcHashMap::xxCalcBlockCrc32c(const Pel* pel, const int stride, const int width, const int height, uint32_t crc)
 {
   for (int y = 0; y < height; y++)
   {
     for (int x = 0; x < width; x++)
     {
-      crc = m_computeCrc32c(crc, pel[x]);
+      crc = xxComputeCrc32c16bit(crc, pel[x]);
     }
     pel += stride;
   }
@@ -204,12 +225,14 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
   const int chromaScalingY = getChannelTypeScaleY(CHANNEL_TYPE_CHROMA, chromaFormat);
   const int chromaMinBlkWidth = MIN_PU_SIZE >> chromaScalingX;
   const int chromaMinBlkHeight = MIN_PU_SIZE >> chromaScalingY;
+  const int maxPosX = pic.Y().width - MIN_PU_SIZE;
+  const int maxPosY = pic.Y().height - MIN_PU_SIZE;
   const Pel* pelY = NULL;
   const Pel* pelCb = NULL;
   const Pel* pelCr = NULL;
 
   Position pos;
-  for (pos.y = 0; pos.y + MIN_PU_SIZE <= pic.Y().height; pos.y++)
+  for (pos.y = 0; pos.y <= maxPosY; pos.y++)
   {
     // row pointer
     pelY = pic.Y().bufAt(0, pos.y);
@@ -220,32 +243,98 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
       pelCr = pic.Cr().bufAt(0, chromaY);
     }
 
-    for (pos.x = 0; pos.x + MIN_PU_SIZE <= pic.Y().width; pos.x++)
+    for (pos.x = 0; pos.x <= maxPosX; pos.x++)
     {
       // 0x1FF is just an initial value
       unsigned int hashValue = 0x1FF;
 
       // luma part
-      hashValue = xxCalcBlockHash(&pelY[pos.x], pic.Y().stride, MIN_PU_SIZE, MIN_PU_SIZE, hashValue);
+      hashValue = m_calcBlockCrc32c(&pelY[pos.x], pic.Y().stride, MIN_PU_SIZE, MIN_PU_SIZE, hashValue);
 
       // chroma part
       if (chromaFormat != CHROMA_400)
       {
         int chromaX = pos.x >> chromaScalingX;
-        hashValue = xxCalcBlockHash(&pelCb[chromaX], pic.Cb().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
-        hashValue = xxCalcBlockHash(&pelCr[chromaX], pic.Cr().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
+        hashValue = m_calcBlockCrc32c(&pelCb[chromaX], pic.Cb().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
+        hashValue = m_calcBlockCrc32c(&pelCr[chromaX], pic.Cr().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
       }
 
-      // hash table
-      m_hash2Pos[hashValue].push_back(pos);
       m_pos2Hash[pos.y][pos.x] = hashValue;
     }
   }
 }
 
+void IbcHashMap::xxResizeHashTable(const unsigned int hashTableBits)
+{
+  std::vector<HashEntry> oldTable(size_t(1) << hashTableBits, HashEntry{ 0, 0, 0 });
+  m_hashTable.swap(oldTable);
+  m_hashTableBits = hashTableBits;
+
+  for (const auto& entry : oldTable)
+  {
+    if (entry.count)
+    {
+      m_hashTable[xxGetEntryIdx(entry.hash)] = entry;
+    }
+  }
+}
+
+void IbcHashMap::xxBuildHashTable()
+{
+  const int numPosX = m_picWidth - MIN_PU_SIZE + 1;
+  const int numPosY = m_picHeight - MIN_PU_SIZE + 1;
+
+  // the table is sized by the number of distinct hash values, starting from the count of the previous picture
+  unsigned int hashTableBits = MIN_HASH_TABLE_BITS;
+  while ((1u << hashTableBits) < 2 * m_numHashEntries)
+  {
+    hashTableBits++;
+  }
+  m_hashTable.clear();
+  xxResizeHashTable(hashTableBits);
+  m_numHashEntries = 0;
+
+  // count the positions of every hash value
+  for (int y = 0; y < numPosY; y++)
+  {
+    for (int x = 0; x < numPosX; x++)
+    {
+      const unsigned int hash = m_pos2Hash[y][x];
+      unsigned int idx = xxGetEntryIdx(hash);
+      if (m_hashTable[idx].count == 0)
+      {
+        if (2 * ++m_numHashEntries > m_hashTable.size())
+        {
+          xxResizeHashTable(m_hashTableBits + 1);
+          idx = xxGetEntryIdx(hash);
+        }
+        m_hashTable[idx].hash = hash;
+      }
+      m_hashTable[idx].count++;
+    }
+  }
+
+  // reserve a consecutive range of m_hashPos for every hash value
+  unsigned int end = 0;
+  for (auto& entry : m_hashTable)
+  {
+    end += entry.count;
+    entry.start = end;
+  }
+
+  // filling the ranges backwards keeps the positions in raster order
+  for (int y = numPosY - 1; y >= 0; y--)
+  {
+    for (int x = numPosX - 1; x >= 0; x--)
+    {
+      m_hashPos[--m_hashTable[xxGetEntryIdx(m_pos2Hash[y][x])].start] = Position(x, y);
+    }
+  }
+}
+
 void IbcHashMap::rebuildPicHashMap(const PelUnitBuf& pic)
 {
-  m_hash2Pos.clear();
+  CHECK(pic.Y().width != m_picWidth || pic.Y().height != m_picHeight, "Hash map not initialized for the picture size");
 
   switch (pic.chromaFormat)
   {
@@ -265,6 +354,8 @@ void IbcHashMap::rebuildPicHashMap(const PelUnitBuf& pic)
     THROW("invalid chroma fomat");
     break;
   }
+
+  xxBuildHashTable();
 }
 
 bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand, const CodingStructure& cs, const int maxCand, const int searchRange4SmallBlk)
@@ -280,21 +371,24 @@ bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand,
     for (SizeType x = 0; x < lumaArea.width && minSize > 1; x += MIN_PU_SIZE)
     {
       unsigned int hash = m_pos2Hash[lumaArea.pos().y + y][lumaArea.pos().x + x];
-      if (m_hash2Pos[hash].size() < minSize)
+      const size_t numPos = xxGetNumPos(hash);
+      if (numPos < minSize)
       {
-        minSize = m_hash2Pos[hash].size();
+        minSize = numPos;
         targetHashOneBlock = hash;
         targetBlockOffsetInCu.repositionTo(Position(x, y));
       }
     }
   }
 
-  if (m_hash2Pos[targetHashOneBlock].size() > 1)
+  const HashEntry& candOneBlock = m_hashTable[xxGetEntryIdx(targetHashOneBlock)];
+  if (candOneBlock.count > 1)
   {
-    std::vector<Position>& candOneBlock = m_hash2Pos[targetHashOneBlock];
+    const Position* candBegin = &m_hashPos[candOneBlock.start];
+    const Position* candEnd   = candBegin + candOneBlock.count;
 
     // check whether whole block match
-    for (std::vector<Position>::iterator refBlockPos = candOneBlock.begin(); refBlockPos != candOneBlock.end(); refBlockPos++)
+    for (const Position* refBlockPos = candBegin; refBlockPos != candEnd; refBlockPos++)
     {
       Position topLeft = refBlockPos->offset(-targetBlockOffsetInCu.x, -targetBlockOffsetInCu.y);
       Position bottomRight = topLeft.offset(lumaArea.width - 1, lumaArea.height - 1);
@@ -346,7 +440,7 @@ int IbcHashMap::getHashHitRatio(const Area& lumaArea)
     for (int x = lumaArea.x; x < maxX; x += MIN_PU_SIZE)
     {
       const unsigned int hash = m_pos2Hash[y][x];
-      hit += (m_hash2Pos[hash].size() > 1);
+      hit += (xxGetNumPos(hash) > 1);
       total++;
     }
   }
@@ -368,11 +462,14 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
     mostSelHash[i] = 0;
   }
 
-  for (std::unordered_map<unsigned int, std::vector<Position>>::iterator it = m_hash2Pos.begin(); it != m_hash2Pos.end(); ++it)
+  for (const auto& entry : m_hashTable)
   {
-    unsigned int hash = it->first;
-    int usage = (int)it->second.size();
-    assert(usage == m_hash2Pos[hash].size());
+    if (entry.count == 0)
+    {
+      continue;
+    }
+    unsigned int hash = entry.hash;
+    int usage = (int)entry.count;
 
     int insertPos = -1;
     for (insertPos = 0; insertPos < numExcludedHashValue; insertPos++)
@@ -417,7 +514,7 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
         continue;
       }
 
-      hit += (m_hash2Pos[hash].size() > 1);
+      hit += (xxGetNumPos(hash) > 1);
       total++;
     }
   }
@@ -46,7 +46,6 @@
 #include "CommonLib/Unit.h"
 #include "CommonLib/UnitPartitioner.h"
 
-#include <unordered_map>
 #include <vector>
 //! \ingroup EncoderLib
 //! \{
@@ -58,20 +57,45 @@
 class IbcHashMap
 {
 private:
+  /// entry of the flat hash table, the positions of a hash value are stored consecutively in m_hashPos
+  struct HashEntry
+  {
+    unsigned int hash;
+    unsigned int count;
+    unsigned int start;
+  };
+
   int     m_picWidth;
   int     m_picHeight;
   unsigned int**  m_pos2Hash;
-  std::unordered_map<unsigned int, std::vector<Position>> m_hash2Pos;
 
-  unsigned int xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc);
+  std::vector<HashEntry>    m_hashTable;        ///< open addressing with linear probing, empty entries have count == 0
+  unsigned int              m_hashTableBits;
+  unsigned int              m_numHashEntries;   ///< number of distinct hash values, the table is kept at most half full
+  std::vector<Position>     m_hashPos;          ///< positions grouped by hash value, raster order within a group
 
   template<ChromaFormat chromaFormat>
   void    xxBuildPicHashMap(const PelUnitBuf& pic);
+  void    xxBuildHashTable();
+  void    xxResizeHashTable(const unsigned int hashTableBits);
+
+  inline unsigned int xxGetEntryIdx(const unsigned int hash) const
+  {
+    const unsigned int mask = (1u << m_hashTableBits) - 1;
+    unsigned int idx = (hash * 2654435761u) >> (32 - m_hashTableBits);
+    while (m_hashTable[idx].count && m_hashTable[idx].hash != hash)
+    {
+      idx = (idx + 1) & mask;
+    }
+    return idx;
+  }
+  inline unsigned int xxGetNumPos(const unsigned int hash) const { return m_hashTable[xxGetEntryIdx(hash)].count; }
 
   static  uint32_t xxComputeCrc32c16bit(uint32_t crc, const Pel pel);
+  static  uint32_t xxCalcBlockCrc32c(const Pel* pel, const int stride, const int width, const int height, uint32_t crc);
 
 public:
-  uint32_t (*m_computeCrc32c) (uint32_t crc, const Pel pel);
+  uint32_t (*m_calcBlockCrc32c) (const Pel* pel, const int stride, const int width, const int height, uint32_t crc);
 
   IbcHashMap();
   virtual ~IbcHashMap();
@@ -40,6 +40,7 @@
 #include "Buffer.h"
 #include "UnitTools.h"
 #include "MCTS.h"
+#include "StageProfiler.h"
 
 #include <memory.h>
 #include <algorithm>
@@ -1084,7 +1085,11 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
     }
   }
 #endif
-  // get prediction block by block
+  // derive the motion vectors of all subblocks up front
+  Mv   subblockMv  [MVBUFFER_SIZE * MVBUFFER_SIZE];
+  bool subblockWrap[MVBUFFER_SIZE * MVBUFFER_SIZE];
+  bool uniformMv = true;
+
   for ( int h = 0; h < cxHeight; h += blockHeight )
   {
     for ( int w = 0; w < cxWidth; w += blockWidth )
@@ -1153,6 +1158,67 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
         iMvScaleTmpVer = curMv.ver;
       }
 
+      const int sbIdx = ( h / blockHeight ) * MVBUFFER_SIZE + w / blockWidth;
+      subblockMv  [sbIdx].set( iMvScaleTmpHor, iMvScaleTmpVer );
+      subblockWrap[sbIdx] = wrapRef;
+      uniformMv &= subblockMv[sbIdx] == subblockMv[0] && wrapRef == subblockWrap[0];
+    }
+  }
+
+  // without PROF, neighbouring subblocks with the same motion vector are predicted by a single filter call; the luma
+  // filter is forced to the 4x4 subblock filter so that the result does not depend on the size of the merged block
+#if JVET_O1164_RPR
+  bool mergeSubblocks = scalingRatio == SCALE_1X;
+#else
+  bool mergeSubblocks = true;
+#endif
+#if JVET_O0070_PROF
+  mergeSubblocks &= !enablePROF;
+#endif
+  const int filterIdx = isLuma( compID ) ? 2 : 0;
+  const int rowHeight = mergeSubblocks && uniformMv ? cxHeight : blockHeight;
+
+#if JVET_O0070_PROF
+  // uni-prediction PROF is applied per row of subblocks, the subblock pattern of the motion vector offsets is repeated
+  // over the block width
+  int dMvRowHor[AFFINE_MIN_BLOCK_SIZE * MAX_CU_SIZE];
+  int dMvRowVer[AFFINE_MIN_BLOCK_SIZE * MAX_CU_SIZE];
+
+  if (enablePROF && !bi)
+  {
+    for (int y = 0; y < blockHeight; y++)
+    {
+      for (int x = 0; x < cxWidth; x++)
+      {
+        dMvRowHor[y * cxWidth + x] = dMvScaleHor[y * blockWidth + (x & (blockWidth - 1))];
+        dMvRowVer[y * cxWidth + x] = dMvScaleVer[y * blockWidth + (x & (blockWidth - 1))];
+      }
+    }
+  }
+#endif
+
+  // get prediction block by block
+  for ( int h = 0; h < cxHeight; h += rowHeight )
+  {
+    for ( int w = 0; w < cxWidth; )
+    {
+      const int sbIdx = ( h / blockHeight ) * MVBUFFER_SIZE + w / blockWidth;
+
+      int bw = blockWidth;
+      int bh = rowHeight;
+
+      if( mergeSubblocks )
+      {
+        while( w + bw < cxWidth && subblockMv[sbIdx + bw / blockWidth] == subblockMv[sbIdx] && subblockWrap[sbIdx + bw / blockWidth] == subblockWrap[sbIdx] )
+        {
+          bw += blockWidth;
+        }
+      }
+
+      const int iMvScaleTmpHor = subblockMv[sbIdx].getHor();
+      const int iMvScaleTmpVer = subblockMv[sbIdx].getVer();
+      wrapRef = subblockWrap[sbIdx];
+
 #if JVET_O1164_RPR
       if( xPredInterBlkRPR( scalingRatio, *pu.cs->pps, CompArea( compID, chFmt, pu.blocks[compID].offset( w, h ), Size( blockWidth, blockHeight ) ), refPic, Mv( iMvScaleTmpHor, iMvScaleTmpVer ), dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, bi, wrapRef, clpRng, 2 ) )
       {
@@ -1189,6 +1255,10 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
 #if !JVET_O0070_PROF
       PelBuf &dstBuf = dstPic.bufs[compID];
 #endif
+      if( bw != blockWidth || bh != blockHeight )
+      {
+        tmpBuf = PelBuf( m_filteredBlockTmp[0][compID], bw, bh + vFilterSize - 1 );
+      }
 
 #if JVET_O0070_PROF
       Pel* ref = (Pel*) refBuf.buf;
@@ -1197,9 +1267,6 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
       int refStride = refBuf.stride;
       int dstStride = dstBuf.stride;
 
-      int bw = blockWidth;
-      int bh = blockHeight;
-
       if (enablePROF)
       {
         dst = dstExtBuf.bufAt(PROF_BORDER_EXT_W, PROF_BORDER_EXT_H);
@@ -1210,31 +1277,31 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
       if ( yFrac == 0 )
       {
 #if JVET_O0070_PROF
-        m_if.filterHor( compID, (Pel*) ref, refStride, dst, dstStride, bw, bh, xFrac, isLast, chFmt, clpRng);
+        m_if.filterHor( compID, (Pel*) ref, refStride, dst, dstStride, bw, bh, xFrac, isLast, chFmt, clpRng, filterIdx );
 #else
-        m_if.filterHor( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, xFrac, !bi, chFmt, clpRng );
+        m_if.filterHor( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, bw, bh, xFrac, !bi, chFmt, clpRng, filterIdx );
 #endif
       }
       else if ( xFrac == 0 )
       {
 #if JVET_O0070_PROF
-        m_if.filterVer( compID, (Pel*) ref, refStride, dst, dstStride, bw, bh, yFrac, true, isLast, chFmt, clpRng);
+        m_if.filterVer( compID, (Pel*) ref, refStride, dst, dstStride, bw, bh, yFrac, true, isLast, chFmt, clpRng, filterIdx );
 #else
-        m_if.filterVer( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, true, !bi, chFmt, clpRng );
+        m_if.filterVer( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, bw, bh, yFrac, true, !bi, chFmt, clpRng, filterIdx );
 #endif
       }
       else
       {
 #if JVET_O0070_PROF
-        m_if.filterHor( compID, (Pel*)ref - ((vFilterSize>>1) -1)*refStride, refStride, tmpBuf.buf, tmpBuf.stride, bw, bh+vFilterSize-1, xFrac, false,      chFmt, clpRng);
+        m_if.filterHor( compID, (Pel*)ref - ((vFilterSize>>1) -1)*refStride, refStride, tmpBuf.buf, tmpBuf.stride, bw, bh+vFilterSize-1, xFrac, false,      chFmt, clpRng, filterIdx );
 #else
-        m_if.filterHor( compID, (Pel*) refBuf.buf - ((vFilterSize>>1) -1)*refBuf.stride, refBuf.stride, tmpBuf.buf, tmpBuf.stride, blockWidth, blockHeight+vFilterSize-1, xFrac, false,      chFmt, clpRng);
+        m_if.filterHor( compID, (Pel*) refBuf.buf - ((vFilterSize>>1) -1)*refBuf.stride, refBuf.stride, tmpBuf.buf, tmpBuf.stride, bw, bh+vFilterSize-1, xFrac, false,      chFmt, clpRng, filterIdx );
 #endif
         JVET_J0090_SET_CACHE_ENABLE( false );
 #if JVET_O0070_PROF
-        m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dst, dstStride, bw, bh, yFrac, false, isLast, chFmt, clpRng);
+        m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dst, dstStride, bw, bh, yFrac, false, isLast, chFmt, clpRng, filterIdx );
 #else
-        m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, false, !bi, chFmt, clpRng);
+        m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, bw, bh, yFrac, false, !bi, chFmt, clpRng, filterIdx );
 #endif
         JVET_J0090_SET_CACHE_ENABLE( true );
       }
@@ -1268,30 +1335,29 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
         PelBuf gradYBuf = gradYExt.subBuf(w, h, blockWidth + 2, blockHeight + 2);
         g_pelBufOP.profGradFilter(dstExtBuf.buf, dstExtBuf.stride, blockWidth + 2, blockHeight + 2, gradXBuf.stride, gradXBuf.buf, gradYBuf.buf, clpRng.bd);
 
-        const int shiftNum = std::max<int>(2, (IF_INTERNAL_PREC - clpRng.bd));
-        const Pel offset = (1 << (shiftNum - 1)) + IF_INTERNAL_OFFS;
+        // the intermediate prediction is refined later for the whole row (uni-prediction) or block (bi-prediction)
         Pel* src = dstExtBuf.bufAt(PROF_BORDER_EXT_W, PROF_BORDER_EXT_H);
-        Pel* gX = gradXBuf.bufAt(PROF_BORDER_EXT_W, PROF_BORDER_EXT_H);
-        Pel* gY = gradYBuf.bufAt(PROF_BORDER_EXT_W, PROF_BORDER_EXT_H);
-
-        Pel * dstY = dstBuf.bufAt(w, h);
-
-        if (!bi)
-        {
-          g_pelBufOP.applyPROF(dstY, dstBuf.stride, src, dstExtBuf.stride, blockWidth, blockHeight, gX, gY, gradXBuf.stride, dMvScaleHor, dMvScaleVer, blockWidth, shiftNum, offset, clpRng);
-        }
-        else
-        {
-          PelBuf srcExtBuf(src, dstExtBuf.stride, Size(blockWidth, blockHeight));
-          PelBuf destBuf(dstY, dstBuf.stride, Size(blockWidth, blockHeight));
-          destBuf.copyFrom(srcExtBuf);
-        }
+        PelBuf srcExtBuf(src, dstExtBuf.stride, Size(blockWidth, blockHeight));
+        PelBuf destBuf(dstBuf.bufAt(w, h), dstBuf.stride, Size(blockWidth, blockHeight));
+        destBuf.copyFrom(srcExtBuf);
       }
 #endif
 #if JVET_O1164_RPR
       }
 #endif
+      w += bw;
+    }
+
+#if JVET_O0070_PROF
+    if (enablePROF && !bi)
+    {
+      const int shiftNum = std::max<int>(2, (IF_INTERNAL_PREC - clpRng.bd));
+      const Pel offset = (1 << (shiftNum - 1)) + IF_INTERNAL_OFFS;
+      Pel* dstRow = dstBuf.bufAt(0, h);
+
+      g_pelBufOP.applyPROF(dstRow, dstBuf.stride, dstRow, dstBuf.stride, cxWidth, blockHeight, gradXExt.bufAt(PROF_BORDER_EXT_W, h + PROF_BORDER_EXT_H), gradYExt.bufAt(PROF_BORDER_EXT_W, h + PROF_BORDER_EXT_H), gradXExt.stride, dMvRowHor, dMvRowVer, cxWidth, shiftNum, offset, clpRng);
     }
+#endif
   }
 }
 
@@ -1748,6 +1814,7 @@ void InterPrediction::motionCompensation( PredictionUnit &pu, PelUnitBuf &predBu
 #endif
 )
 {
+  PROFILE_STAGE( PROF_STAGE_INTER_PRED );
 #if JVET_O0108_DIS_DMVR_BDOF_CIIP
   CHECK(predBufWOBIO && pu.mhIntraFlag, "the case should not happen!");
 #endif
@@ -1950,6 +2017,7 @@ int InterPrediction::rightShiftMSB(int numer, int denom)
 
 void InterPrediction::motionCompensation4Triangle( CodingUnit &cu, MergeCtx &triangleMrgCtx, const bool splitDir, const uint8_t candIdx0, const uint8_t candIdx1 )
 {
+  PROFILE_STAGE( PROF_STAGE_INTER_PRED );
   for( auto &pu : CU::traversePUs( cu ) )
   {
     const UnitArea localUnitArea( cu.cs->area.chromaFormat, Area( 0, 0, pu.lwidth(), pu.lheight() ) );
@@ -2328,19 +2396,18 @@ void xSubPelErrorSrfc(uint64_t *sadBuffer, int32_t *deltaMv)
 
 void InterPrediction::xBIPMVRefine(int bd, Pel *pRefL0, Pel *pRefL1, uint64_t& minCost, int16_t *deltaMV, uint64_t *pSADsArray, int width, int height)
 {
-  const int32_t refStrideL0 = m_biLinearBufStride;
-  const int32_t refStrideL1 = m_biLinearBufStride;
-  Pel *pRefL0Orig = pRefL0;
-  Pel *pRefL1Orig = pRefL1;
+  const int32_t sadStride = (2 * DMVR_NUM_ITERATION) + 1;
+  Distortion    sads[((2 * DMVR_NUM_ITERATION) + 1) * ((2 * DMVR_NUM_ITERATION) + 1)];
+
+  // evaluate the whole search window in one pass, the selection below keeps the original scan order
+  m_pcRdCost->getDMVRSADs(pRefL0, pRefL1, m_biLinearBufStride, width, height, bd, sads);
+
   for (int nIdx = 0; (nIdx < 25); ++nIdx)
   {
-    int32_t sadOffset = ((m_pSearchOffset[nIdx].getVer() * ((2 * DMVR_NUM_ITERATION) + 1)) + m_pSearchOffset[nIdx].getHor());
-    pRefL0 = pRefL0Orig + m_pSearchOffset[nIdx].hor + (m_pSearchOffset[nIdx].ver * refStrideL0);
-    pRefL1 = pRefL1Orig - m_pSearchOffset[nIdx].hor - (m_pSearchOffset[nIdx].ver * refStrideL1);
+    int32_t sadOffset = ((m_pSearchOffset[nIdx].getVer() * sadStride) + m_pSearchOffset[nIdx].getHor());
     if (*(pSADsArray + sadOffset) == MAX_UINT64)
     {
-      const uint64_t cost = xDMVRCost(bd, pRefL0, refStrideL0, pRefL1, refStrideL1, width, height);
-      *(pSADsArray + sadOffset) = cost;
+      *(pSADsArray + sadOffset) = sads[((m_pSearchOffset[nIdx].getVer() + DMVR_NUM_ITERATION) * sadStride) + m_pSearchOffset[nIdx].getHor() + DMVR_NUM_ITERATION] >> 1;
     }
     if (*(pSADsArray + sadOffset) < minCost)
     {
@@ -3046,6 +3113,10 @@ bool InterPrediction::xPredInterBlkRPR( const std::pair<int, int>& scalingRatio,
 
     int xInt = 0, yInt = 0;
 
+    // horizontal phase table: integer position relative to xInt0 and fractional position of each column
+    int xIntOffsets[MAX_CU_SIZE];
+    int xFracs     [MAX_CU_SIZE];
+
     for( col = 0; col < width; col++ )
     {
       int posX = (int32_t)x0Int + col * stepX;
@@ -3055,13 +3126,15 @@ bool InterPrediction::xPredInterBlkRPR( const std::pair<int, int>& scalingRatio,
 
       CHECK( xInt0 > xInt, "Wrong horizontal starting point" );
 
-      Position offset = Position( xInt, yInt0 );
-      refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, offset, Size( 1, refHeight ) ), wrapRef );
-      Pel* tempBuf = buffer + col;
-
-      m_if.filterHor( compID, (Pel*)refBuf.buf - ( ( vFilterSize >> 1 ) - 1 ) * refBuf.stride, refBuf.stride, tempBuf, tmpStride, 1, refHeight + vFilterSize - 1 + extSize, xFrac, false, chFmt, clpRng, filterIndex, false, useAltHpelIf );
+      xIntOffsets[col] = xInt - xInt0;
+      xFracs     [col] = xFrac;
     }
 
+    // filter all columns row by row instead of one column at a time
+    refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, Position( xInt0, yInt0 ), Size( 1, refHeight ) ), wrapRef );
+
+    m_if.filterHorPhase( compID, (Pel*)refBuf.buf - ( ( vFilterSize >> 1 ) - 1 ) * refBuf.stride, refBuf.stride, buffer, tmpStride, width, refHeight + vFilterSize - 1 + extSize, xIntOffsets, xFracs, chFmt, clpRng, filterIndex, useAltHpelIf );
+
     for( row = 0; row < height; row++ )
     {
       int posY = (int32_t)y0Int + row * stepY;
@@ -213,6 +213,9 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+#if JVET_O1164_RPR
+  m_filterHorPhase     = filterHorPhase;
+#endif
 #if JVET_O0280_SIMD_TRIANGLE_WEIGHTING
   m_weightedTriangleBlk = xWeightedTriangleBlk;
 #endif
@@ -561,6 +564,56 @@ void InterpolationFilter::filterVer(const ClpRng& clpRng, Pel const *src, int sr
   }
 }
 
+#if JVET_O1164_RPR
+/**
+ * \brief First (non-last) horizontal filtering stage with a filter phase per column, used for reference picture resampling
+ *
+ * \param  clpRng     Clipping range (only the bit depth is used)
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  srcOffsets Offset of the first of the NTAPS_LUMA source samples of each column
+ * \param  coeffs     NTAPS_LUMA filter taps per column, shorter filters are centered and padded with zeros
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// !!! NOTE !!!
+//
+//  This is the scalar version of the function.
+//  If you change the functionality here, consider to switch off the SIMD implementation of this function.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void InterpolationFilter::filterHorPhase( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int const *srcOffsets, TFilterCoeff const *coeffs )
+{
+  const int headRoom = std::max<int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) );
+  const int shift    = IF_FILTER_PREC - headRoom;
+  const int offset   = -IF_INTERNAL_OFFS << shift;
+
+  for( int row = 0; row < height; row++ )
+  {
+    for( int col = 0; col < width; col++ )
+    {
+      const Pel*          s = src + srcOffsets[col];
+      const TFilterCoeff* c = coeffs + col * NTAPS_LUMA;
+      int sum = 0;
+
+      for( int k = 0; k < NTAPS_LUMA; k++ )
+      {
+        sum += s[k] * c[k];
+      }
+
+      dst[col] = ( sum + offset ) >> shift;
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -597,12 +650,10 @@ void InterpolationFilter::filterHor( const ComponentID compID, Pel const *src, i
     {
       filterHor<NTAPS_BILINEAR>(clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_bilinearFilterPrec4[frac], biMCForDMVR);
     }
-#if JVET_O1164_RPR
     else if( nFilterIdx == 2 )
     {
       filterHor<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_lumaFilter4x4[frac], biMCForDMVR );
     }
-#endif
     else
     {
 #if JVET_O0057_ALTHPELIF
@@ -666,12 +717,10 @@ void InterpolationFilter::filterVer( const ComponentID compID, Pel const *src, i
     {
       filterVer<NTAPS_BILINEAR>(clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_bilinearFilterPrec4[frac], biMCForDMVR);
     }
-#if JVET_O1164_RPR
     else if( nFilterIdx == 2 )
     {
       filterVer<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_lumaFilter4x4[frac], biMCForDMVR );
     }
-#endif
     else
     {
 #if JVET_O0057_ALTHPELIF
@@ -701,79 +750,109 @@ void InterpolationFilter::filterVer( const ComponentID compID, Pel const *src, i
   }
 }
 
-#if JVET_O0280_SIMD_TRIANGLE_WEIGHTING
-void InterpolationFilter::xWeightedTriangleBlk( const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const bool splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1 )
+#if JVET_O1164_RPR
+/**
+ * \brief First horizontal filtering stage of Luma/Chroma samples with a separate integer and fractional position per column
+ *
+ * The result is identical to calling filterHor() with isLast == false for each single column.
+ *
+ * \param  compID      Colour component ID
+ * \param  src         Pointer to source samples at the integer position 0
+ * \param  srcStride   Stride of source samples
+ * \param  dst         Pointer to destination samples
+ * \param  dstStride   Stride of destination samples
+ * \param  width       Width of block, at most MAX_CU_SIZE
+ * \param  height      Height of block
+ * \param  xInt        Integer sample position of each column relative to src
+ * \param  xFrac       Fractional sample position of each column
+ * \param  fmt         Chroma format
+ * \param  clpRng      Clipping range
+ * \param  nFilterIdx  Filter index as in filterHor()
+ * \param  useAltHpelIf Use the alternative half-sample luma filter
+ */
+void InterpolationFilter::filterHorPhase( const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int const *xInt, int const *xFrac, const ChromaFormat fmt, const ClpRng& clpRng, int nFilterIdx, bool useAltHpelIf )
 {
-  Pel*    dst        = predDst .get(compIdx).buf;
-  Pel*    src0       = predSrc0.get(compIdx).buf;
-  Pel*    src1       = predSrc1.get(compIdx).buf;
-  int32_t strideDst  = predDst .get(compIdx).stride  - width;
-  int32_t strideSrc0 = predSrc0.get(compIdx).stride  - width;
-  int32_t strideSrc1 = predSrc1.get(compIdx).stride  - width;
+  CHECK( width > MAX_CU_SIZE, "Block too wide for the phase filter" );
 
-  const char    log2WeightBase    = 3;
-  const ClpRng  clipRng           = pu.cu->slice->clpRngs().comp[compIdx];
-  const int32_t clipbd            = clipRng.bd;
-  const int32_t shiftDefault      = std::max<int>(2, (IF_INTERNAL_PREC - clipbd));
-  const int32_t offsetDefault     = (1<<(shiftDefault-1)) + IF_INTERNAL_OFFS;
-  const int32_t shiftWeighted     = std::max<int>(2, (IF_INTERNAL_PREC - clipbd)) + log2WeightBase;
-  const int32_t offsetWeighted    = (1 << (shiftWeighted - 1)) + (IF_INTERNAL_OFFS << log2WeightBase);
+  int          srcOffsets[MAX_CU_SIZE];
+  TFilterCoeff coeffs[MAX_CU_SIZE * NTAPS_LUMA];
 
-  const int32_t ratioWH           = (width > height) ? (width / height) : 1;
-  const int32_t ratioHW           = (width > height) ? 1 : (height / width);
+  const uint32_t csx = getComponentScaleX( compID, fmt );
 
-  const bool    longWeight        = (compIdx == COMPONENT_Y);
-  const int32_t weightedLength    = longWeight ? 7 : 3;
-        int32_t weightedStartPos  = ( splitDir == 0 ) ? ( 0 - (weightedLength >> 1) * ratioWH ) : ( width - ((weightedLength + 1) >> 1) * ratioWH );
-        int32_t weightedEndPos    = weightedStartPos + weightedLength * ratioWH - 1;
-        int32_t weightedPosoffset = ( splitDir == 0 ) ? ratioWH : -ratioWH;
+  for( int col = 0; col < width; col++ )
+  {
+    const int     frac = xFrac[col];
+    TFilterCoeff* c    = coeffs + col * NTAPS_LUMA;
 
-        Pel     tmpPelWeighted;
-        int32_t weightIdx;
-        int32_t x, y, tmpX, tmpY, tmpWeightedStart, tmpWeightedEnd;
+    std::fill( c, c + NTAPS_LUMA, 0 );
+    srcOffsets[col] = xInt[col] - ( NTAPS_LUMA / 2 - 1 );
 
-  for( y = 0; y < height; y+= ratioHW )
-  {
-    for( tmpY = ratioHW; tmpY > 0; tmpY-- )
+    if( frac == 0 )
+    {
+      // unit filter, equivalent to the copy path of filterHor()
+      c[NTAPS_LUMA / 2 - 1] = 1 << IF_FILTER_PREC;
+    }
+    else if( isLuma( compID ) )
     {
-      for( x = 0; x < weightedStartPos; x++ )
+      CHECK( frac < 0 || frac >= LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction" );
+      if( nFilterIdx == 1 )
       {
-        *dst++ = ClipPel( rightShift( (splitDir == 0 ? *src1 : *src0) + offsetDefault, shiftDefault), clipRng );
-        src0++;
-        src1++;
+        std::copy( m_bilinearFilterPrec4[frac], m_bilinearFilterPrec4[frac] + NTAPS_BILINEAR, c + ( NTAPS_LUMA - NTAPS_BILINEAR ) / 2 );
       }
-
-      tmpWeightedStart = std::max((int32_t)0, weightedStartPos);
-      tmpWeightedEnd   = std::min(weightedEndPos, (int32_t)(width - 1));
-      weightIdx        = 1;
-      if( weightedStartPos < 0 )
+      else if( nFilterIdx == 2 )
       {
-        weightIdx     += abs(weightedStartPos) / ratioWH;
+        std::copy( m_lumaFilter4x4[frac], m_lumaFilter4x4[frac] + NTAPS_LUMA, c );
       }
-      for( x = tmpWeightedStart; x <= tmpWeightedEnd; x+= ratioWH )
+#if JVET_O0057_ALTHPELIF
+      else if( frac == 8 && useAltHpelIf )
       {
-        for( tmpX = ratioWH; tmpX > 0; tmpX-- )
-        {
-          tmpPelWeighted = Clip3( 1, 7, longWeight ? weightIdx : (weightIdx * 2));
-          tmpPelWeighted = splitDir ? ( 8 - tmpPelWeighted ) : tmpPelWeighted;
-          *dst++         = ClipPel( rightShift( (tmpPelWeighted*(*src0++) + ((8 - tmpPelWeighted) * (*src1++)) + offsetWeighted), shiftWeighted ), clipRng );
-        }
-        weightIdx ++;
+        std::copy( m_lumaAltHpelIFilter, m_lumaAltHpelIFilter + NTAPS_LUMA, c );
       }
-
-      for( x = weightedEndPos + 1; x < width; x++ )
+#endif
+      else
       {
-        *dst++ = ClipPel( rightShift( (splitDir == 0 ? *src0 : *src1) + offsetDefault, shiftDefault ), clipRng );
-        src0++;
-        src1++;
+        std::copy( m_lumaFilter[frac], m_lumaFilter[frac] + NTAPS_LUMA, c );
       }
+    }
+    else
+    {
+      CHECK( frac < 0 || csx >= 2 || ( frac << ( 1 - csx ) ) >= CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction" );
+      std::copy( m_chromaFilter[frac << ( 1 - csx )], m_chromaFilter[frac << ( 1 - csx )] + NTAPS_CHROMA, c + ( NTAPS_LUMA - NTAPS_CHROMA ) / 2 );
+    }
+  }
 
-      dst  += strideDst;
-      src0 += strideSrc0;
-      src1 += strideSrc1;
+  m_filterHorPhase( clpRng, src, srcStride, dst, dstStride, width, height, srcOffsets, coeffs );
+}
+#endif
+
+#if JVET_O0280_SIMD_TRIANGLE_WEIGHTING
+void InterpolationFilter::xWeightedTriangleBlk( const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const bool splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1 )
+{
+  Pel*    dst        = predDst .get(compIdx).buf;
+  Pel*    src0       = predSrc0.get(compIdx).buf;
+  Pel*    src1       = predSrc1.get(compIdx).buf;
+  int32_t strideDst  = predDst .get(compIdx).stride;
+  int32_t strideSrc0 = predSrc0.get(compIdx).stride;
+  int32_t strideSrc1 = predSrc1.get(compIdx).stride;
+
+  const char    log2WeightBase    = 3;
+  const ClpRng  clipRng           = pu.cu->slice->clpRngs().comp[compIdx];
+  const int32_t shiftWeighted     = std::max<int>(2, (IF_INTERNAL_PREC - clipRng.bd)) + log2WeightBase;
+  const int32_t offsetWeighted    = (1 << (shiftWeighted - 1)) + (IF_INTERNAL_OFFS << log2WeightBase);
+
+  // the precomputed mask holds the weight of src0 for every sample, 8 (or 0) away from the split diagonal
+  const int16_t *weight           = g_triangleWeights[compIdx != COMPONENT_Y][splitDir][floorLog2(height) - 1][floorLog2(width) - 1];
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x] = ClipPel( rightShift( weight[x] * src0[x] + (8 - weight[x]) * src1[x] + offsetWeighted, shiftWeighted ), clipRng );
     }
-    weightedStartPos += weightedPosoffset;
-    weightedEndPos   += weightedPosoffset;
+    dst    += strideDst;
+    src0   += strideSrc0;
+    src1   += strideSrc1;
+    weight += width;
   }
 }
 
@@ -43,6 +43,7 @@
 
 #include "dtrace_next.h"
 #include "Rom.h"
+#include "StageProfiler.h"
 
 #include <memory.h>
 
@@ -133,9 +134,19 @@ IntraPrediction::IntraPrediction()
     }
   }
 
-  m_piTemp = nullptr;
   m_pMdlmTemp = nullptr;
 
+  m_lumaRecReuse = false;
+  m_lumaRecCU    = nullptr;
+
+  m_downsampleLuma = xDownsampleLuma;
+
+#if ENABLE_SIMD_OPT_CCLM
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
+
 #if JVET_O0119_BASE_PALETTE_444
   m_runTypeRD   = nullptr;
   m_runLengthRD = nullptr;
@@ -168,8 +179,6 @@ void IntraPrediction::destroy()
     }
   }
 
-  delete[] m_piTemp;
-  m_piTemp = nullptr;
   delete[] m_pMdlmTemp;
   m_pMdlmTemp = nullptr;
 #if JVET_O0119_BASE_PALETTE_444
@@ -227,10 +236,6 @@ void IntraPrediction::init(ChromaFormat chromaFormatIDC, const unsigned bitDepth
     }
   }
 
-  if (m_piTemp == nullptr)
-  {
-    m_piTemp = new Pel[(MAX_CU_SIZE + 1) * (MAX_CU_SIZE + 1)];
-  }
   if (m_pMdlmTemp == nullptr)
   {
     m_pMdlmTemp = new Pel[(2 * MAX_CU_SIZE + 1)*(2 * MAX_CU_SIZE + 1)];//MDLM will use top-above and left-below samples.
@@ -327,6 +332,7 @@ void IntraPrediction::setReferenceArrayLengths( const CompArea &area )
 
 void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu)
 {
+  PROFILE_STAGE( PROF_STAGE_INTRA_PRED );
   const ComponentID    compID       = MAP_CHROMA( compId );
   const ChannelType    channelType  = toChannelType( compID );
   const int            iWidth       = piPred.width;
@@ -420,18 +426,9 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
 void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred, const PredictionUnit &pu, const CompArea& chromaArea, int intraDir)
 {
-  int  iLumaStride = 0;
-  PelBuf Temp;
-  if ((intraDir == MDLM_L_IDX) || (intraDir == MDLM_T_IDX))
-  {
-    iLumaStride = 2 * MAX_CU_SIZE + 1;
-    Temp = PelBuf(m_pMdlmTemp + iLumaStride + 1, iLumaStride, Size(chromaArea));
-  }
-  else
-  {
-    iLumaStride = MAX_CU_SIZE + 1;
-    Temp = PelBuf(m_piTemp + iLumaStride + 1, iLumaStride, Size(chromaArea));
-  }
+  const int    iLumaStride = 2 * MAX_CU_SIZE + 1;
+  const PelBuf Temp        = PelBuf(m_pMdlmTemp + iLumaStride + 1, iLumaStride, Size(chromaArea));
+
   int a, b, iShift;
   xGetLMParameters(pu, compID, chromaArea, a, b, iShift);
 
@@ -1860,22 +1857,48 @@ int isBelowLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const
   return numIntra;
 }
 
-// LumaRecPixels
-void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chromaArea)
+void IntraPrediction::xDownsampleLuma( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const ChromaFormat chFmt, const bool collocated )
 {
-  int iDstStride = 0;
-  Pel* pDst0 = 0;
-  int curChromaMode = pu.intraDir[1];
-  if ((curChromaMode == MDLM_L_IDX) || (curChromaMode == MDLM_T_IDX))
+  const ptrdiff_t srcStep = chFmt == CHROMA_420 ? 2 * srcStride : srcStride;
+
+  for( int j = 0; j < height; j++, src += srcStep, dst += dstStride )
   {
-    iDstStride = 2 * MAX_CU_SIZE + 1;
-    pDst0 = m_pMdlmTemp + iDstStride + 1;
+    for( int i = 0; i < width; i++ )
+    {
+      if( chFmt == CHROMA_444 )
+      {
+        dst[i] = src[i];
+      }
+      else if( chFmt == CHROMA_422 )
+      {
+        dst[i] = collocated ? src[2 * i] : ( 2 * src[2 * i] + src[2 * i - 1] + src[2 * i + 1] + 2 ) >> 2;
+      }
+      else if( collocated )
+      {
+        dst[i] = ( src[2 * i - srcStride] + 4 * src[2 * i] + src[2 * i - 1] + src[2 * i + 1] + src[2 * i + srcStride] + 4 ) >> 3;
+      }
+      else
+      {
+        dst[i] = ( 2 * src[2 * i]             + src[2 * i - 1]             + src[2 * i + 1]
+                 + 2 * src[2 * i + srcStride] + src[2 * i - 1 + srcStride] + src[2 * i + 1 + srcStride] + 4 ) >> 3;
+      }
+    }
   }
-  else
+}
+
+// LumaRecPixels
+void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chromaArea)
+{
+  // the buffer is filled including the MDLM template extensions, such that it serves all three LM modes
+  if( m_lumaRecReuse && m_lumaRecCU == pu.cu && m_lumaRecArea.pos() == chromaArea.pos() && m_lumaRecArea.size() == chromaArea.size() )
   {
-    iDstStride = MAX_CU_SIZE + 1;
-    pDst0 = m_piTemp + iDstStride + 1; //MMLM_SAMPLE_NEIGHBOR_LINES;
+    return;
   }
+  m_lumaRecCU   = pu.cu;
+  m_lumaRecArea = chromaArea;
+
+  const int iDstStride = 2 * MAX_CU_SIZE + 1;
+  Pel*      pDst0      = m_pMdlmTemp + iDstStride + 1;
   //assert 420 chroma subsampling
   CompArea lumaArea = CompArea( COMPONENT_Y, pu.chromaFormat, chromaArea.lumaPos(), recalcSize( pu.chromaFormat, CHANNEL_TYPE_CHROMA, CHANNEL_TYPE_LUMA, chromaArea.size() ) );//needed for correct pos/size (4x4 Tus)
 
@@ -1983,11 +2006,7 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
   if( bAboveAvaillable )
   {
     pDst  = pDst0    - iDstStride;
-    int addedAboveRight = 0;
-    if ((curChromaMode == MDLM_L_IDX) || (curChromaMode == MDLM_T_IDX))
-    {
-      addedAboveRight = avaiAboveRightUnits*chromaUnitWidth;
-    }
+    const int addedAboveRight = avaiAboveRightUnits*chromaUnitWidth;
     for (int i = 0; i < uiCWidth + addedAboveRight; i++)
     {
       if (isFirstRowOfCtu)
@@ -2043,11 +2062,7 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
     piSrc = pRecSrc0 - 2 - logSubWidthC;
 
-    int addedLeftBelow = 0;
-    if ((curChromaMode == MDLM_L_IDX) || (curChromaMode == MDLM_T_IDX))
-    {
-      addedLeftBelow = avaiLeftBelowUnits*chromaUnitHeight;
-    }
+    const int addedLeftBelow = avaiLeftBelowUnits*chromaUnitHeight;
 
     for (int j = 0; j < uiCHeight + addedLeftBelow; j++)
     {
@@ -2078,11 +2093,18 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
   }
 
   // inner part from reconstructed picture buffer
-  for( int j = 0; j < uiCHeight; j++ )
+  const bool collocated = pu.cs->sps->getCclmCollocatedChromaFlag();
+
+  m_downsampleLuma( pRecSrc0, iRecStride, pDst0, iDstStride, uiCWidth, uiCHeight, pu.chromaFormat, collocated );
+
+  // samples next to unavailable neighbours, the other samples are not modified by the special cases below
+  const int numBorderRows = !bLeftAvaillable ? uiCHeight : collocated && !bAboveAvaillable ? 1 : 0;
+  for( int j = 0; j < numBorderRows; j++ )
   {
-    for( int i = 0; i < uiCWidth; i++ )
+    const int numBorderCols = collocated && !bAboveAvaillable && j == 0 ? uiCWidth : bLeftAvaillable ? 0 : 1;
+    for( int i = 0; i < numBorderCols; i++ )
     {
-      if( pu.cs->sps->getCclmCollocatedChromaFlag() )
+      if( collocated )
       {
         if( i == 0 && !bLeftAvaillable )
         {
@@ -2109,7 +2131,6 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
       }
       else
       {
-
         if ((i == 0 && !bLeftAvaillable) || (i == uiCWidth - 1 + logSubWidthC))
         {
           pDst0[i] = (pRecSrc0[mult * i] * c0_2tap + pRecSrc0[mult * i + strOffset] * c1_2tap + offset_2tap) >> shift_2tap;
@@ -2135,6 +2156,7 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     pRecSrc0 += iRecStride2;
   }
 }
+
 void IntraPrediction::xGetLMParameters(const PredictionUnit &pu, const ComponentID compID,
                                               const CompArea &chromaArea,
                                               int &a, int &b, int &iShift)
@@ -2208,17 +2230,8 @@ void IntraPrediction::xGetLMParameters(const PredictionUnit &pu, const Component
   int  srcStride, curStride;
 #endif
 
-  PelBuf temp;
-  if ((curChromaMode == MDLM_L_IDX) || (curChromaMode == MDLM_T_IDX))
-  {
-    srcStride = 2 * MAX_CU_SIZE + 1;
-    temp = PelBuf(m_pMdlmTemp + srcStride + 1, srcStride, Size(chromaArea));
-  }
-  else
-  {
-    srcStride = MAX_CU_SIZE + 1;
-    temp        = PelBuf(m_piTemp + srcStride + 1, srcStride, Size(chromaArea));
-  }
+  srcStride = 2 * MAX_CU_SIZE + 1;
+  PelBuf temp = PelBuf(m_pMdlmTemp + srcStride + 1, srcStride, Size(chromaArea));
   srcColor0 = temp.bufAt(0, 0);
   curChroma0 = getPredictorPtr(compID);
 
@@ -2408,6 +2421,7 @@ void IntraPrediction::initIntraMip( const PredictionUnit &pu )
 
 void IntraPrediction::predIntraMip( const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu )
 {
+  PROFILE_STAGE( PROF_STAGE_INTRA_PRED );
   CHECK( compId != COMPONENT_Y, "Error: chroma not supported" );
 #if JVET_O0545_MAX_TB_SIGNALLING
   CHECK( pu.lwidth() > pu.cs->sps->getMaxTbSize() || pu.lheight() > pu.cs->sps->getMaxTbSize(), "Error: block size not supported for MIP" );
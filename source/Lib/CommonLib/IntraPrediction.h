@@ -127,8 +127,11 @@ private:
 
   IntraPredParam m_ipaParam;
 
-  Pel* m_piTemp;
-  Pel* m_pMdlmTemp; // for MDLM mode
+  Pel* m_pMdlmTemp; // down-sampled luma of the LM modes, including the MDLM template extensions
+
+  bool              m_lumaRecReuse; // the down-sampled luma of m_lumaRecArea is still valid (encoder chroma search)
+  Area              m_lumaRecArea;
+  const CodingUnit* m_lumaRecCU;
   MatrixIntraPrediction m_matrixIntraPred;
 
 
@@ -195,6 +198,19 @@ public:
   // Cross-component Chroma
   void predIntraChromaLM(const ComponentID compID, PelBuf &piPred, const PredictionUnit &pu, const CompArea& chromaArea, int intraDir);
   void xGetLumaRecPixels(const PredictionUnit &pu, CompArea chromaArea);
+  /// while enabled, xGetLumaRecPixels skips the down-sampling when called again for the same chroma area, the luma reconstruction must not change meanwhile
+  void setLumaRecPixelsReuse( const bool reuse ) { m_lumaRecReuse = reuse; m_lumaRecCU = nullptr; }
+
+  /// down-samples the luma of a block to the chroma grid without the special cases at unavailable neighbours, src points to the collocated luma sample of the first chroma sample
+  void ( *m_downsampleLuma )( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const ChromaFormat chFmt, const bool collocated );
+
+  static void xDownsampleLuma( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const ChromaFormat chFmt, const bool collocated );
+
+#ifdef TARGET_SIMD_X86
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
   /// set parameters from CU data for accessing intra data
   void initIntraPatternChType     (const CodingUnit &cu, const CompArea &area, const bool forceRefFilterFlag = false); // use forceRefFilterFlag to get both filtered and unfiltered buffers
 #if JVET_O0502_ISP_CLEANUP
@@ -41,6 +41,7 @@
 #include "Unit.h"
 #include "UnitTools.h"
 #include "UnitPartitioner.h"
+#include "StageProfiler.h"
 #include "dtrace_codingstruct.h"
 #include "dtrace_buffer.h"
 
@@ -153,6 +154,7 @@ void LoopFilter::destroy()
 void LoopFilter::loopFilterPic( CodingStructure& cs
                                 )
 {
+  PROFILE_STAGE( PROF_STAGE_DEBLOCK );
   const PreCalcValues& pcv = *cs.pcv;
   m_shiftHor = ::getComponentScaleX( COMPONENT_Cb, cs.pcv->chrFormat );
   m_shiftVer = ::getComponentScaleY( COMPONENT_Cb, cs.pcv->chrFormat );
@@ -38,6 +38,7 @@
 
 #include <sstream>
 #include <list>
+#include <vector>
 #include "CommonDef.h"
 
 class OutputBitstream;
@@ -135,7 +136,7 @@ struct OutputNALUnit;
  */
 struct NALUnitEBSP : public NALUnit
 {
-  std::ostringstream m_nalUnitData;
+  std::vector<uint8_t> m_nalUnitData;
 
   /**
    * convert the OutputNALUnit nalu into EBSP format by writing out
@@ -858,6 +858,7 @@ Picture::Picture()
   brickMap             = nullptr;
   cs                   = nullptr;
   m_bIsBorderExtended  = false;
+  m_borderExtendedHeight = 0;
   usedByCurr           = false;
   longTerm             = false;
   reconstructed        = false;
@@ -866,6 +867,7 @@ Picture::Picture()
   layer                = std::numeric_limits<uint32_t>::max();
   fieldPic             = false;
   topField             = false;
+  outputRefCount       = 0;
 #if JVET_N0494_DRAP
   precedingDRAP        = false;
 #endif
@@ -1324,7 +1326,7 @@ const TFilterCoeff DownsamplingFilterSRC[8][16][12] =
     }
 };
 
-void Picture::sampleRateConv( const Pel* orgSrc, SizeType orgWidth, SizeType orgHeight, SizeType orgStride, Pel* scaledSrc, SizeType scaledWidth, SizeType scaledHeight, SizeType paddedWidth, SizeType paddedHeight, SizeType scaledStride, const int bitDepth, const bool useLumaFilter, const bool downsampling )
+void Picture::sampleRateConv( const Pel* orgSrc, SizeType orgWidth, SizeType orgHeight, SizeType orgStride, Pel* scaledSrc, SizeType scaledWidth, SizeType scaledHeight, SizeType paddedWidth, SizeType paddedHeight, SizeType scaledStride, const int bitDepth, const bool useLumaFilter, const bool downsampling, const int numThreads )
 {
   if( orgWidth == scaledWidth && orgHeight == scaledHeight )
   {
@@ -1373,62 +1375,99 @@ void Picture::sampleRateConv( const Pel* orgSrc, SizeType orgWidth, SizeType org
 
   CHECK( bitDepth > 17, "Overflow may happen!" );
 
+  // phase tables: integer source position and filter of each output column and row
+  std::vector<int>                 horInt( paddedWidth ), verInt( paddedHeight );
+  std::vector<const TFilterCoeff*> horCoeff( paddedWidth ), verCoeff( paddedHeight );
+
   for( int i = 0; i < paddedWidth; i++ )
   {
-    const Pel* org = orgSrc;
     int integer = ( i * orgWidth ) / scaledWidth;
     int frac = ( ( i * orgWidth << numFracShift ) / scaledWidth ) & numFracPositions;
 
-    int* tmp = buf + i;
+    horInt[i]   = integer;
+    horCoeff[i] = filterHor + frac * filerLength;
+  }
 
-    for( int j = 0; j < orgHeight; j++ )
+  for( int j = 0; j < paddedHeight; j++ )
+  {
+    int integer = ( j * orgHeight ) / scaledHeight;
+    int frac = ( ( j * orgHeight << numFracShift ) / scaledHeight ) & numFracPositions;
+
+    verInt[j]   = integer;
+    verCoeff[j] = filterVer + frac * filerLength;
+  }
+
+  // each source row is copied into a line with replicated edge samples, so the filter taps need no clipping
+  const int padLeft  = filerLength / 2 - 1;
+  const int padRight = std::max<int>( 0, horInt[paddedWidth - 1] + filerLength / 2 - ( (int)orgWidth - 1 ) );
+
+#pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+  {
+    std::vector<Pel> line( padLeft + orgWidth + padRight );
+
+#pragma omp for
+    for( int j = 0; j < (int)orgHeight; j++ )
     {
-      int sum = 0;
-      const TFilterCoeff* f = filterHor + frac * filerLength;
+      const Pel* org = orgSrc + j * orgStride;
+      int* tmp = buf + j * paddedWidth;
 
-      for( int k = 0; k < filerLength; k++ )
+      std::fill( line.begin(), line.begin() + padLeft, org[0] );
+      std::copy( org, org + orgWidth, line.begin() + padLeft );
+      std::fill( line.begin() + padLeft + orgWidth, line.end(), org[orgWidth - 1] );
+
+      for( int i = 0; i < paddedWidth; i++ )
       {
-        int xInt = std::min<int>( std::max( 0, integer + k - filerLength / 2 + 1 ), orgWidth - 1 );
-        sum += f[k] * org[xInt]; // postpone horizontal filtering gain removal after vertical filtering
-      }
+        const Pel* src = line.data() + horInt[i];
+        const TFilterCoeff* f = horCoeff[i];
+        int sum = 0;
 
-      *tmp = sum;
+        for( int k = 0; k < filerLength; k++ )
+        {
+          sum += f[k] * src[k]; // postpone horizontal filtering gain removal after vertical filtering
+        }
 
-      tmp += paddedWidth;
-      org += orgStride;
+        tmp[i] = sum;
+      }
     }
   }
 
-  Pel* dst = scaledSrc;
-
-  for( int j = 0; j < paddedHeight; j++ )
+#pragma omp parallel num_threads(numThreads) if(numThreads > 1)
   {
-    int integer = ( j * orgHeight ) / scaledHeight;
-    int frac = ( ( j * orgHeight << numFracShift ) / scaledHeight ) & numFracPositions;
+    std::vector<int> sum( paddedWidth );
 
-    for( int i = 0; i < paddedWidth; i++ )
+#pragma omp for
+    for( int j = 0; j < paddedHeight; j++ )
     {
-      int sum = 0;
-      int* tmp = buf + i;
-      const TFilterCoeff* f = filterVer + frac * filerLength;
+      const TFilterCoeff* f = verCoeff[j];
+      Pel* dst = scaledSrc + j * scaledStride;
+
+      std::fill( sum.begin(), sum.end(), 0 );
 
+      // accumulate whole rows per tap to allow vectorization of the inner loop
       for( int k = 0; k < filerLength; k++ )
       {
-        int yInt = std::min<int>( std::max( 0, integer + k - filerLength / 2 + 1 ), orgHeight - 1 );
-        sum += f[k] * tmp[yInt*paddedWidth];
+        const int  yInt = std::min<int>( std::max( 0, verInt[j] + k - filerLength / 2 + 1 ), orgHeight - 1 );
+        const int* tmp  = buf + yInt * paddedWidth;
+        const int  coef = f[k];
+
+        for( int i = 0; i < paddedWidth; i++ )
+        {
+          sum[i] += coef * tmp[i];
+        }
       }
 
-      dst[i] = std::min<int>( std::max( 0, ( sum + ( 1 << ( log2Norm - 1 ) ) ) >> log2Norm ), maxVal );
+      for( int i = 0; i < paddedWidth; i++ )
+      {
+        dst[i] = std::min<int>( std::max( 0, ( sum[i] + ( 1 << ( log2Norm - 1 ) ) ) >> log2Norm ), maxVal );
+      }
     }
-
-    dst += scaledStride;
   }
 
   delete[] buf;
 }
 
 #if RPR_CONF_WINDOW
-void Picture::rescalePicture( const CPelUnitBuf& beforeScaling, const Window& confBefore, const PelUnitBuf& afterScaling, const Window& confAfter, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling )
+void Picture::rescalePicture( const CPelUnitBuf& beforeScaling, const Window& confBefore, const PelUnitBuf& afterScaling, const Window& confAfter, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling, const int numThreads )
 {
   for( int comp = 0; comp < ::getNumberValidComponents( chromaFormatIDC ); comp++ )
   {
@@ -1440,11 +1479,11 @@ void Picture::rescalePicture( const CPelUnitBuf& beforeScaling, const Window& co
     int widthAfter = afterScale.width - (((confAfter.getWindowLeftOffset() + confAfter.getWindowRightOffset()) * SPS::getWinUnitX(chromaFormatIDC)) >> getChannelTypeScaleX((ChannelType)(comp > 0), chromaFormatIDC));
     int heightAfter = afterScale.height - (((confAfter.getWindowTopOffset() + confAfter.getWindowBottomOffset()) * SPS::getWinUnitY(chromaFormatIDC)) >> getChannelTypeScaleY((ChannelType)(comp > 0), chromaFormatIDC));
 
-    Picture::sampleRateConv( beforeScale.buf,  widthBefore, heightBefore, beforeScale.stride, afterScale.buf, widthAfter, heightAfter, afterScale.width, afterScale.height, afterScale.stride, bitDepths.recon[comp], downsampling || useLumaFilter ? true : isLuma(compID), downsampling );
+    Picture::sampleRateConv( beforeScale.buf,  widthBefore, heightBefore, beforeScale.stride, afterScale.buf, widthAfter, heightAfter, afterScale.width, afterScale.height, afterScale.stride, bitDepths.recon[comp], downsampling || useLumaFilter ? true : isLuma(compID), downsampling, numThreads );
   }
 }
 #else
-void Picture::rescalePicture(const CPelUnitBuf& beforeScaling, const PelUnitBuf& afterScaling, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling)
+void Picture::rescalePicture(const CPelUnitBuf& beforeScaling, const PelUnitBuf& afterScaling, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling, const int numThreads)
 {
   for (int comp = 0; comp < ::getNumberValidComponents(chromaFormatIDC); comp++)
   {
@@ -1452,7 +1491,7 @@ void Picture::rescalePicture(const CPelUnitBuf& beforeScaling, const PelUnitBuf&
     const CPelBuf& beforeScale = beforeScaling.get(compID);
     const PelBuf& afterScale = afterScaling.get(compID);
 
-    Picture::sampleRateConv(beforeScale.buf, beforeScale.width, beforeScale.height, beforeScale.stride, afterScale.buf, afterScale.width, afterScale.height, afterScale.width, afterScale.height, afterScale.stride, bitDepths.recon[comp], downsampling || useLumaFilter ? true : isLuma(compID), downsampling);
+    Picture::sampleRateConv(beforeScale.buf, beforeScale.width, beforeScale.height, beforeScale.stride, afterScale.buf, afterScale.width, afterScale.height, afterScale.width, afterScale.height, afterScale.stride, bitDepths.recon[comp], downsampling || useLumaFilter ? true : isLuma(compID), downsampling, numThreads);
   }
 }
 #endif
@@ -1465,51 +1504,74 @@ void Picture::extendPicBorder()
     return;
   }
 
+  extendPicBorder( M_BUFS( 0, PIC_RECONSTRUCTION ).get( COMPONENT_Y ).height );
+}
+
+/** extends the margins next to the luma rows [m_borderExtendedHeight, lumaHeight) and the corresponding chroma rows,
+    the top margin once the first rows are extended and the bottom margin once the last rows are extended.
+    Called with increasing heights as CTU rows get final, e.g. during the last in-loop filter stage.
+    \param lumaHeight number of luma rows from the top of the picture which are final
+ */
+void Picture::extendPicBorder( const int lumaHeight )
+{
+  const int picHeight = M_BUFS( 0, PIC_RECONSTRUCTION ).get( COMPONENT_Y ).height;
+  const int yEndLuma  = std::min( lumaHeight, picHeight );
+
+  if ( m_bIsBorderExtended || yEndLuma <= m_borderExtendedHeight )
+  {
+    return;
+  }
+
   for(int comp=0; comp<getNumberValidComponents( cs->area.chromaFormat ); comp++)
   {
     ComponentID compID = ComponentID( comp );
     PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
-    Pel *piTxt = p.bufAt(0,0);
     int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
     int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
+    const int yStart = m_borderExtendedHeight >> getComponentScaleY( compID, cs->area.chromaFormat );
+    const int yEnd   = yEndLuma == picHeight ? p.height : yEndLuma >> getComponentScaleY( compID, cs->area.chromaFormat );
 
-    Pel*  pi = piTxt;
+    Pel*  pi = p.bufAt( 0, yStart );
     // do left and right margins
-      for (int y = 0; y < p.height; y++)
+    for (int y = yStart; y < yEnd; y++)
+    {
+      for (int x = 0; x < xmargin; x++ )
       {
-        for (int x = 0; x < xmargin; x++ )
-        {
-          pi[ -xmargin + x ] = pi[0];
-          pi[  p.width + x ] = pi[p.width-1];
-        }
-        pi += p.stride;
+        pi[ -xmargin + x ] = pi[0];
+        pi[  p.width + x ] = pi[p.width-1];
       }
+      pi += p.stride;
+    }
 
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (p.stride + xmargin);
-    // pi is now the (-marginX, height-1)
-    for (int y = 0; y < ymargin; y++ )
+    if (yStart == 0)
     {
-      ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
+      // pi is now (-marginX, 0)
+      pi = p.bufAt( -xmargin, 0 );
+      for (int y = 0; y < ymargin; y++ )
+      {
+        ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
+      }
     }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((p.height-1) * p.stride);
-    // pi is now (-marginX, 0)
-    for (int y = 0; y < ymargin; y++ )
+    if (yEnd == p.height)
     {
-      ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
+      // pi is now (-marginX, height-1)
+      pi = p.bufAt( -xmargin, p.height - 1 );
+      for (int y = 0; y < ymargin; y++ )
+      {
+        ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
+      }
     }
 
     // reference picture with horizontal wrapped boundary
     if (cs->sps->getWrapAroundEnabledFlag())
     {
+      const PelBuf rec = p;
       p = M_BUFS( 0, PIC_RECON_WRAP ).get( compID );
-      p.copyFrom(M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID ));
-      piTxt = p.bufAt(0,0);
-      pi = piTxt;
+      p.subBuf( 0, yStart, p.width, yEnd - yStart ).copyFrom( rec.subBuf( 0, yStart, rec.width, yEnd - yStart ) );
+      pi = p.bufAt( 0, yStart );
       int xoffset = cs->sps->getWrapAroundOffset() >> getComponentScaleX( compID, cs->area.chromaFormat );
-      for (int y = 0; y < p.height; y++)
+      for (int y = yStart; y < yEnd; y++)
       {
         for (int x = 0; x < xmargin; x++ )
         {
@@ -1526,20 +1588,27 @@ void Picture::extendPicBorder()
         }
         pi += p.stride;
       }
-      pi -= (p.stride + xmargin);
-      for (int y = 0; y < ymargin; y++ )
+      if (yStart == 0)
       {
-        ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
+        pi = p.bufAt( -xmargin, 0 );
+        for (int y = 0; y < ymargin; y++ )
+        {
+          ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
+        }
       }
-      pi -= ((p.height-1) * p.stride);
-      for (int y = 0; y < ymargin; y++ )
+      if (yEnd == p.height)
       {
-        ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
+        pi = p.bufAt( -xmargin, p.height - 1 );
+        for (int y = 0; y < ymargin; y++ )
+        {
+          ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
+        }
       }
     }
   }
 
-  m_bIsBorderExtended = true;
+  m_borderExtendedHeight = yEndLuma;
+  m_bIsBorderExtended    = yEndLuma == picHeight;
 }
 
 PelBuf Picture::getBuf( const ComponentID compID, const PictureType &type )
@@ -1666,7 +1735,7 @@ bool Picture::getSpliceFull()
   return true;
 }
 
-void Picture::addPictureToHashMapForInter()
+void Picture::addPictureToHashMapForInter( int numThreads )
 {
 #if JVET_O1164_PS
   int picWidth = slices[0]->getPPS()->getPicWidthInLumaSamples();
@@ -1690,7 +1759,7 @@ void Picture::addPictureToHashMapForInter()
       bIsBlockSame[i][j] = new bool[picWidth*picHeight];
     }
   }
-  m_hashMap.create(picWidth, picHeight);
+  m_hashMap.create(picWidth, picHeight, numThreads);
   m_hashMap.generateBlock2x2HashValue(getOrigBuf(), picWidth, picHeight, slices[0]->getSPS()->getBitDepths(), blockHashValues[0], bIsBlockSame[0]);//2x2
   m_hashMap.generateBlockHashValue(picWidth, picHeight, 4, 4, blockHashValues[0], blockHashValues[1], bIsBlockSame[0], bIsBlockSame[1]);//4x4
   m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[1], bIsBlockSame[1][2], picWidth, picHeight, 4, 4);
@@ -49,6 +49,7 @@
 #include "Hash.h"
 #include "MCTS.h"
 #include <deque>
+#include <atomic>
 
 #if JVET_O1164_RPR
 #include "CommonLib/InterpolationFilter.h"
@@ -249,6 +250,7 @@ struct Picture : public UnitArea
   const CPelUnitBuf getBuf(const UnitArea &unit,     const PictureType &type) const;
 
   void extendPicBorder();
+  void extendPicBorder( const int lumaHeight );
 #if JVET_O0299_APS_SCALINGLIST
   void finalInit( const SPS& sps, const PPS& pps, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
 #else
@@ -256,7 +258,7 @@ struct Picture : public UnitArea
 #endif
 
   int  getPOC()                               const { return poc; }
-  void setBorderExtension( bool bFlag)              { m_bIsBorderExtended = bFlag;}
+  void setBorderExtension( bool bFlag)              { m_bIsBorderExtended = bFlag; m_borderExtendedHeight = 0; }
   Pel* getOrigin( const PictureType &type, const ComponentID compID ) const;
 
   int           getSpliceIdx(uint32_t idx) const { return m_spliceIdx[idx]; }
@@ -264,17 +266,18 @@ struct Picture : public UnitArea
   void          createSpliceIdx(int nums);
   bool          getSpliceFull();
 #if JVET_O1164_RPR
-  static void   sampleRateConv( const Pel* orgSrc, SizeType orgWidth, SizeType orgHeight, SizeType orgStride, Pel* scaledSrc, SizeType scaledWidth, SizeType scaledHeight, SizeType paddedWidth, SizeType paddedHeight, SizeType scaledStride, const int bitDepth, const bool useLumaFilter, const bool downsampling = false );
+  static void   sampleRateConv( const Pel* orgSrc, SizeType orgWidth, SizeType orgHeight, SizeType orgStride, Pel* scaledSrc, SizeType scaledWidth, SizeType scaledHeight, SizeType paddedWidth, SizeType paddedHeight, SizeType scaledStride, const int bitDepth, const bool useLumaFilter, const bool downsampling = false, const int numThreads = 1 );
 
 #if RPR_CONF_WINDOW
-  static void   rescalePicture(const CPelUnitBuf& beforeScaling, const Window& confBefore, const PelUnitBuf& afterScaling, const Window& confAfter, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling = false);
+  static void   rescalePicture(const CPelUnitBuf& beforeScaling, const Window& confBefore, const PelUnitBuf& afterScaling, const Window& confAfter, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling = false, const int numThreads = 1);
 #else
-  static void   rescalePicture(const CPelUnitBuf& beforeScaling, const PelUnitBuf& afterScaling, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling = false);
+  static void   rescalePicture(const CPelUnitBuf& beforeScaling, const PelUnitBuf& afterScaling, const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling = false, const int numThreads = 1);
 #endif
 #endif
 
 public:
   bool m_bIsBorderExtended;
+  int  m_borderExtendedHeight;   ///< number of luma rows from the top whose left and right margins are extended
   bool referenced;
   bool reconstructed;
   bool neededForOutput;
@@ -282,6 +285,7 @@ public:
   bool longTerm;
   bool topField;
   bool fieldPic;
+  std::atomic<int> outputRefCount; ///< number of references held by the application after output (DecStream), the buffer is not reused while non-zero
   int  m_prevQP[MAX_NUM_CHANNEL_TYPE];
 #if JVET_N0494_DRAP
   bool precedingDRAP; // preceding a DRAP picture in decoding order
@@ -310,7 +314,7 @@ public:
   TComHash           m_hashMap;
   TComHash*          getHashMap() { return &m_hashMap; }
   const TComHash*    getHashMap() const { return &m_hashMap; }
-  void               addPictureToHashMapForInter();
+  void               addPictureToHashMapForInter( int numThreads = 1 );
 
   CodingStructure*   cs;
   std::deque<Slice*> slices;
@@ -0,0 +1,268 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     PictureMetrics.cpp
+    \brief    objective quality metrics of a picture plane
+*/
+
+#include "PictureMetrics.h"
+
+#include <cmath>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+static const int    MSSSIM_MAX_SCALES                 = 5;
+static const double MSSSIM_WEIGHTS[MSSSIM_MAX_SCALES] = { 0.0448, 0.2856, 0.3001, 0.2363, 0.1333 };
+
+// ====================================================================================================================
+// Scalar kernels
+// ====================================================================================================================
+
+uint64_t PictureMetrics::xSSERow( const Pel* src0, const Pel* src1, const int width )
+{
+  uint64_t sum = 0;
+  for( int x = 0; x < width; x++ )
+  {
+    const Intermediate_Int diff = src0[x] - src1[x];
+    sum += uint64_t( diff * diff );
+  }
+  return sum;
+}
+
+void PictureMetrics::xSSIMStats4x4( const Pel* src0, const ptrdiff_t stride0, const Pel* src1, const ptrdiff_t stride1, int64_t* stats, const int numBlocks )
+{
+  for( int b = 0; b < numBlocks; b++, stats += 4 )
+  {
+    int     sum0  = 0, sum1  = 0;
+    int64_t sumSq = 0, sum01 = 0;
+    for( int y = 0; y < 4; y++ )
+    {
+      const Pel* p0 = src0 + y * stride0 + ( b << 2 );
+      const Pel* p1 = src1 + y * stride1 + ( b << 2 );
+      for( int x = 0; x < 4; x++ )
+      {
+        sum0  += p0[x];
+        sum1  += p1[x];
+        sumSq += int64_t( p0[x] ) * p0[x] + int64_t( p1[x] ) * p1[x];
+        sum01 += int64_t( p0[x] ) * p1[x];
+      }
+    }
+    stats[0] = sum0;
+    stats[1] = sum1;
+    stats[2] = sumSq;
+    stats[3] = sum01;
+  }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+PictureMetrics::PictureMetrics()
+  : m_numThreads( 1 )
+{
+  m_sseRow       = xSSERow;
+  m_ssimStats4x4 = xSSIMStats4x4;
+
+#if ENABLE_SIMD_OPT_METRICS
+#ifdef TARGET_SIMD_X86
+  initPictureMetricsX86();
+#endif
+#endif
+}
+
+uint64_t PictureMetrics::getSSE( const CPelBuf& pic0, const CPelBuf& pic1 ) const
+{
+  CHECK( pic0.width  != pic1.width , "Unspecified error" );
+  CHECK( pic0.height != pic1.height, "Unspecified error" );
+
+  const int height = pic0.height;
+  uint64_t  sum    = 0;
+
+#pragma omp parallel for reduction(+:sum) num_threads(m_numThreads) if(m_numThreads > 1)
+  for( int y = 0; y < height; y++ )
+  {
+    sum += m_sseRow( pic0.bufAt( 0, y ), pic1.bufAt( 0, y ), pic0.width );
+  }
+  return sum;
+}
+
+double PictureMetrics::getSSIM( const CPelBuf& pic0, const CPelBuf& pic1, const int bitDepth ) const
+{
+  double cs;
+  return xGetSSIM( pic0, pic1, bitDepth, cs );
+}
+
+/** MS-SSIM over up to five dyadic scales, the number of scales is reduced for pictures too small to hold
+    an 8x8 window at the coarsest scale and the weights are renormalized over the scales used */
+double PictureMetrics::getMSSSIM( const CPelBuf& pic0, const CPelBuf& pic1, const int bitDepth ) const
+{
+  int numScales = 1;
+  while( numScales < MSSSIM_MAX_SCALES && std::min( pic0.width, pic0.height ) >> numScales >= 8 )
+  {
+    numScales++;
+  }
+
+  double weightSum = 0.0;
+  for( int s = 0; s < numScales; s++ )
+  {
+    weightSum += MSSSIM_WEIGHTS[s];
+  }
+
+  std::vector<Pel> scaleBuf[2][2];
+  CPelBuf          cur[2] = { pic0, pic1 };
+  double           msssim = 1.0;
+
+  for( int s = 0; s < numScales; s++ )
+  {
+    double       cs;
+    const double ssim   = xGetSSIM( cur[0], cur[1], bitDepth, cs );
+    const double weight = MSSSIM_WEIGHTS[s] / weightSum;
+
+    msssim *= pow( std::max( s == numScales - 1 ? ssim : cs, 0.0 ), weight );
+
+    if( s == numScales - 1 )
+    {
+      break;
+    }
+
+    // 2x2 average down-sampling into the buffer not referenced by the current scale
+    const int width  = cur[0].width  >> 1;
+    const int height = cur[0].height >> 1;
+    for( int i = 0; i < 2; i++ )
+    {
+      std::vector<Pel>& dst = scaleBuf[i][s & 1];
+      dst.resize( width * height );
+      const CPelBuf src = cur[i];
+
+#pragma omp parallel for num_threads(m_numThreads) if(m_numThreads > 1)
+      for( int y = 0; y < height; y++ )
+      {
+        const Pel* s0 = src.bufAt( 0, 2 * y );
+        const Pel* s1 = s0 + src.stride;
+        Pel*       d  = &dst[y * width];
+        for( int x = 0; x < width; x++ )
+        {
+          d[x] = ( s0[2 * x] + s0[2 * x + 1] + s1[2 * x] + s1[2 * x + 1] + 2 ) >> 2;
+        }
+      }
+      cur[i] = CPelBuf( dst.data(), width, width, height );
+    }
+  }
+
+  return msssim;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** SSIM of 8x8 windows on a 4x4 grid, built from the statistics of 4x4 blocks; the contrast-structure term
+    is returned in cs for MS-SSIM. Samples right and below the last complete 4x4 block are not considered */
+double PictureMetrics::xGetSSIM( const CPelBuf& pic0, const CPelBuf& pic1, const int bitDepth, double& cs ) const
+{
+  CHECK( pic0.width  != pic1.width , "Unspecified error" );
+  CHECK( pic0.height != pic1.height, "Unspecified error" );
+
+  const int numBlocksX = pic0.width  >> 2;
+  const int numBlocksY = pic0.height >> 2;
+
+  if( numBlocksX < 2 || numBlocksY < 2 )
+  {
+    cs = 1.0;
+    return 1.0;
+  }
+
+  std::vector<int64_t> stats( numBlocksX * numBlocksY * 4 );
+
+#pragma omp parallel for num_threads(m_numThreads) if(m_numThreads > 1)
+  for( int by = 0; by < numBlocksY; by++ )
+  {
+    m_ssimStats4x4( pic0.bufAt( 0, by << 2 ), pic0.stride, pic1.bufAt( 0, by << 2 ), pic1.stride, &stats[by * numBlocksX * 4], numBlocksX );
+  }
+
+  const double maxVal = double( ( 1 << bitDepth ) - 1 );
+  const double c1     = ( 0.01 * maxVal ) * ( 0.01 * maxVal );
+  const double c2     = ( 0.03 * maxVal ) * ( 0.03 * maxVal );
+  const int    numRows = numBlocksY - 1;
+
+  // per row partial sums, accumulated in order so that the result does not depend on the number of threads
+  std::vector<double> rowSSIM( numRows ), rowCS( numRows );
+
+#pragma omp parallel for num_threads(m_numThreads) if(m_numThreads > 1)
+  for( int by = 0; by < numRows; by++ )
+  {
+    const int64_t* top    = &stats[by * numBlocksX * 4];
+    const int64_t* bottom = top + numBlocksX * 4;
+    double     ssimSum = 0.0, csSum = 0.0;
+
+    for( int bx = 0; bx < numBlocksX - 1; bx++, top += 4, bottom += 4 )
+    {
+      int64_t s[4];
+      for( int k = 0; k < 4; k++ )
+      {
+        s[k] = top[k] + top[k + 4] + bottom[k] + bottom[k + 4];
+      }
+      const double mu0 = s[0] / 64.0;
+      const double mu1 = s[1] / 64.0;
+      const double var = s[2] / 64.0 - mu0 * mu0 - mu1 * mu1;
+      const double cov = s[3] / 64.0 - mu0 * mu1;
+      const double csW = ( 2.0 * cov + c2 ) / ( var + c2 );
+
+      ssimSum += ( 2.0 * mu0 * mu1 + c1 ) / ( mu0 * mu0 + mu1 * mu1 + c1 ) * csW;
+      csSum   += csW;
+    }
+    rowSSIM[by] = ssimSum;
+    rowCS[by]   = csSum;
+  }
+
+  double ssim = 0.0;
+  cs          = 0.0;
+  for( int by = 0; by < numRows; by++ )
+  {
+    ssim += rowSSIM[by];
+    cs   += rowCS[by];
+  }
+
+  const double numWindows = double( numBlocksX - 1 ) * numRows;
+  cs /= numWindows;
+  return ssim / numWindows;
+}
+
+//! \}
@@ -0,0 +1,83 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Declaration of PictureMetrics class
+ */
+
+#ifndef __PICTUREMETRICS__
+#define __PICTUREMETRICS__
+
+#include "CommonDef.h"
+#include "Unit.h"
+
+//! \ingroup CommonLib
+//! \{
+
+/// objective quality metrics (SSE, SSIM, MS-SSIM) of a picture plane with respect to a reference plane
+class PictureMetrics
+{
+public:
+  PictureMetrics();
+  ~PictureMetrics() {}
+
+  void     setNumThreads( int numThreads ) { m_numThreads = std::max( numThreads, 1 ); }
+  int      getNumThreads()           const { return m_numThreads; }
+
+  uint64_t getSSE   ( const CPelBuf& pic0, const CPelBuf& pic1 ) const;
+  double   getSSIM  ( const CPelBuf& pic0, const CPelBuf& pic1, const int bitDepth ) const;
+  double   getMSSSIM( const CPelBuf& pic0, const CPelBuf& pic1, const int bitDepth ) const;
+
+  uint64_t( *m_sseRow )      ( const Pel* src0, const Pel* src1, const int width );
+  /// statistics of a row of 4x4 blocks, four values per block: sum0, sum1, sum of the squares of both and sum of the products
+  void    ( *m_ssimStats4x4 )( const Pel* src0, const ptrdiff_t stride0, const Pel* src1, const ptrdiff_t stride1, int64_t* stats, const int numBlocks );
+
+  static uint64_t xSSERow      ( const Pel* src0, const Pel* src1, const int width );
+  static void     xSSIMStats4x4( const Pel* src0, const ptrdiff_t stride0, const Pel* src1, const ptrdiff_t stride1, int64_t* stats, const int numBlocks );
+
+#ifdef TARGET_SIMD_X86
+  void initPictureMetricsX86();
+  template <X86_VEXT vext>
+  void _initPictureMetricsX86();
+#endif
+
+private:
+  double   xGetSSIM( const CPelBuf& pic0, const CPelBuf& pic1, const int bitDepth, double& cs ) const;
+
+  int      m_numThreads;
+};
+
+//! \}
+
+#endif
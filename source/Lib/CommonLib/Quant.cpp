@@ -199,6 +199,15 @@ QpParam::QpParam(const TransformUnit& tu, const ComponentID &compIDX, const int
 Quant::Quant( const Quant* other )
 {
   xInitScalingList( other );
+
+  m_deQuantCoeffs = xDeQuantCoeffs;
+  m_quantCoeffs   = xQuantCoeffs;
+
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  initQuantX86();
+#endif
+#endif
 }
 
 Quant::~Quant()
@@ -420,6 +429,58 @@ void Quant::xSignBitHidingHDQ( TCoeff* pQCoef, const TCoeff* pCoef, TCoeff* delt
   return;
 }
 
+void Quant::xDeQuantCoeffs( const TCoeff* src, TCoeff* dst, const int num, const int* scales, const int scale, const int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff outputMin, const TCoeff outputMax )
+{
+  if( rightShift > 0 )
+  {
+    const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
+
+    for( int n = 0; n < num; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMin, inputMax, src[n]));
+      const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * (scales ? scales[n] : scale)) + iAdd ) >> rightShift;
+
+      dst[n] = TCoeff(Clip3<Intermediate_Int>(outputMin,outputMax,iCoeffQ));
+    }
+  }
+  else
+  {
+    const int leftShift = -rightShift;
+
+    for( int n = 0; n < num; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMin, inputMax, src[n]));
+      const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * (scales ? scales[n] : scale)) << leftShift;
+
+      dst[n] = TCoeff(Clip3<Intermediate_Int>(outputMin,outputMax,iCoeffQ));
+    }
+  }
+}
+
+TCoeff Quant::xQuantCoeffs( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int num, const int* scales, const int scale, const int qBits, const int64_t add, const TCoeff outputMin, const TCoeff outputMax )
+{
+  const int qBits8 = qBits - 8;
+  TCoeff    absSum = 0;
+
+  for( int n = 0; n < num; n++ )
+  {
+    const TCoeff iLevel   = src[n];
+    const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+
+    const int64_t  tmpLevel = (int64_t)abs(iLevel) * (scales ? scales[n] : scale);
+
+    const TCoeff quantisedMagnitude = TCoeff((tmpLevel + add ) >> qBits);
+    deltaU[n] = (TCoeff)((tmpLevel - ((int64_t)quantisedMagnitude<<qBits) )>> qBits8);
+
+    absSum += quantisedMagnitude;
+    const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+
+    dst[n] = Clip3<TCoeff>( outputMin, outputMax, quantisedCoefficient );
+  }
+
+  return absSum;
+}
+
 void Quant::dequant(const TransformUnit &tu,
                              CoeffBuf      &dstCoeff,
                        const ComponentID   &compID,
@@ -484,30 +545,7 @@ void Quant::dequant(const TransformUnit &tu,
     const uint32_t uiLog2TrHeight = floorLog2(uiHeight);
     int *piDequantCoef        = getDequantCoeff(scalingListType, QP_rem, uiLog2TrWidth, uiLog2TrHeight);
 
-    if(rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const int leftShift = -rightShift;
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    m_deQuantCoeffs( piQCoef, piCoef, numSamplesInBlock, piDequantCoef, 0, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
   else
   {
@@ -521,30 +559,7 @@ void Quant::dequant(const TransformUnit &tu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    if (rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const int leftShift = -rightShift;
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    m_deQuantCoeffs( piQCoef, piCoef, numSamplesInBlock, nullptr, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
 }
 
@@ -1049,30 +1064,15 @@ void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
     // QBits will be OK for any internal bit depth as the reduction in transform shift is balanced by an increase in Qp_per due to QpBDOffset
 
     const int64_t iAdd = int64_t(tu.cs->slice->isIRAP() ? 171 : 85) << int64_t(iQBits - 9);
-    const int qBits8 = iQBits - 8;
 
 #if JVET_O0094_LFNST_ZERO_PRIM_COEFFS
     const uint32_t lfnstIdx = tu.cu->lfnstIdx;
     const int maxNumberOfCoeffs = lfnstIdx > 0 ? ((( uiWidth == 4 && uiHeight == 4 ) || ( uiWidth == 8 && uiHeight == 8) ) ? 8 : 16) : piQCoef.area();
     memset( piQCoef.buf, 0, sizeof(TCoeff) * piQCoef.area() );
-    for (int uiBlockPos = 0; uiBlockPos < maxNumberOfCoeffs; uiBlockPos++ )
 #else
-    for (int uiBlockPos = 0; uiBlockPos < piQCoef.area(); uiBlockPos++)
+    const int maxNumberOfCoeffs = piQCoef.area();
 #endif
-    {
-      const TCoeff iLevel   = piCoef.buf[uiBlockPos];
-      const TCoeff iSign    = (iLevel < 0 ? -1: 1);
-
-      const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
-
-      const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
-      deltaU[uiBlockPos] = (TCoeff)((tmpLevel - ((int64_t)quantisedMagnitude<<iQBits) )>> qBits8);
-
-      uiAbsSum += quantisedMagnitude;
-      const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
-
-      piQCoef.buf[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
-    } // for n
+    uiAbsSum += m_quantCoeffs( piCoef.buf, piQCoef.buf, deltaU, maxNumberOfCoeffs, enableScalingLists ? piQuantCoeff : nullptr, defaultQuantisationCoefficient, iQBits, iAdd, entropyCodingMinimum, entropyCodingMaximum );
     if( tu.cu->bdpcmMode && isLuma(compID) )
     {
       fwdResDPCM( tu, compID );
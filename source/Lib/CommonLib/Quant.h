@@ -163,6 +163,20 @@ public:
   virtual void copyState         ( const Quant& other );
 #endif
 
+  /// dst[n] = clip( ( clip( src[n] ) * scale[n] + rounding ) >> rightShift ), a non-positive rightShift shifts left; scales == nullptr selects the flat scale
+  void   ( *m_deQuantCoeffs )    ( const TCoeff* src, TCoeff* dst, const int num, const int* scales, const int scale, const int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff outputMin, const TCoeff outputMax );
+  /// quantises num coefficients, writes the rounding errors to deltaU and returns the sum of the quantised magnitudes
+  TCoeff ( *m_quantCoeffs )      ( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int num, const int* scales, const int scale, const int qBits, const int64_t add, const TCoeff outputMin, const TCoeff outputMax );
+
+  static void   xDeQuantCoeffs   ( const TCoeff* src, TCoeff* dst, const int num, const int* scales, const int scale, const int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff outputMin, const TCoeff outputMax );
+  static TCoeff xQuantCoeffs     ( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int num, const int* scales, const int scale, const int qBits, const int64_t add, const TCoeff outputMin, const TCoeff outputMax );
+
+#ifdef TARGET_SIMD_X86
+  void initQuantX86();
+  template <X86_VEXT vext>
+  void _initQuantX86();
+#endif
+
 protected:
 
 #if T0196_SELECTIVE_RDOQ
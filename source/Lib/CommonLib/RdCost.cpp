@@ -49,6 +49,7 @@
 
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
+FpDMVRSADFunc RdCost::m_fpDMVRSADs = nullptr;
 
 RdCost::RdCost()
 {
@@ -166,6 +167,8 @@ void RdCost::init()
 
   m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD;
 
+  m_fpDMVRSADs                 = RdCost::xGetDMVRSADs;
+
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
   initRdCostX86();
@@ -483,6 +486,35 @@ Distortion RdCost::xGetSAD( const DistParam& rcDtParam )
   return ( uiSum >> distortionShift );
 }
 
+void RdCost::xGetDMVRSADs( const Pel* pL0, const Pel* pL1, int stride, int width, int height, int bitDepth, Distortion* sads )
+{
+  // matches xGetSAD with subShift = 1: the offset is added to L0 and mirrored on L1
+  const int      range           = DMVR_NUM_ITERATION;
+  const uint32_t distortionShift = DISTORTION_PRECISION_ADJUSTMENT( bitDepth );
+
+  for( int ver = -range; ver <= range; ver++ )
+  {
+    for( int hor = -range; hor <= range; hor++ )
+    {
+      const Pel* piOrg = pL0 + hor + ver * stride;
+      const Pel* piCur = pL1 - hor - ver * stride;
+      Distortion uiSum = 0;
+
+      for( int y = 0; y < height; y += 2 )
+      {
+        for( int n = 0; n < width; n++ )
+        {
+          uiSum += abs( piOrg[n] - piCur[n] );
+        }
+        piOrg += 2 * stride;
+        piCur += 2 * stride;
+      }
+
+      *sads++ = ( uiSum << 1 ) >> distortionShift;
+    }
+  }
+}
+
 Distortion RdCost::xGetSAD4( const DistParam& rcDtParam )
 {
   if ( rcDtParam.applyWeight )
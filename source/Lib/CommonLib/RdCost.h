@@ -58,6 +58,7 @@ class EncCfg;
 
 // for function pointer
 typedef Distortion (*FpDistFunc) (const DistParam&);
+typedef void       (*FpDMVRSADFunc) (const Pel*, const Pel*, int, int, int, int, Distortion*);
 
 // ====================================================================================================================
 // Class definition
@@ -102,6 +103,7 @@ private:
   // for distortion
 
   static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  static FpDMVRSADFunc    m_fpDMVRSADs;
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -160,6 +162,8 @@ public:
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRefY , int iRefStride, int bitDepth, ComponentID compID, int subShiftMode = 0, int step = 1, bool useHadamard = false );
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const CPelBuf &cur, int bitDepth, ComponentID compID, bool useHadamard = false );
   void           setDistParam( DistParam &rcDP, const Pel* pOrg, const Pel* piRefY, int iOrgStride, int iRefStride, int bitDepth, ComponentID compID, int width, int height, int subShiftMode = 0, int step = 1, bool useHadamard = false, bool bioApplied = false );
+  // even-row SADs of all (2 * DMVR_NUM_ITERATION + 1)^2 mirrored integer offsets of the DMVR search window, stored row by row
+  void           getDMVRSADs ( const Pel* pL0, const Pel* pL1, int stride, int width, int height, int bitDepth, Distortion* sads ) const { m_fpDMVRSADs( pL0, pL1, stride, width, height, bitDepth, sads ); }
 
   double         getMotionLambda          ( bool bIsTransquantBypass ) { return m_dLambdaMotionSAD[(bIsTransquantBypass && m_costMode==COST_MIXED_LOSSLESS_LOSSY_CODING)?1:0]; }
   void           selectMotionLambda       ( bool bIsTransquantBypass ) { m_motionLambda = getMotionLambda( bIsTransquantBypass ); }
@@ -296,7 +300,7 @@ public:
 #if WCG_EXT
          void    saveUnadjustedLambda       ();
          void    initLumaLevelToWeightTable ();
-  inline double  getWPSNRLumaLevelWeight    (int val) { return m_lumaLevelToWeightPLUT[val]; }
+  inline double  getWPSNRLumaLevelWeight    (int val) const { return m_lumaLevelToWeightPLUT[val]; }
   void           initLumaLevelToWeightTableReshape();
   void           updateReshapeLumaLevelToWeightTableChromaMD (std::vector<Pel>& ILUT);
   void           restoreReshapeLumaLevelToWeightTable        ();
@@ -342,6 +346,8 @@ private:
 
   static Distortion xGetSAD_full      ( const DistParam& pcDtParam );
 
+  static void       xGetDMVRSADs      ( const Pel* pL0, const Pel* pL1, int stride, int width, int height, int bitDepth, Distortion* sads );
+
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD4        ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD8        ( const DistParam& pcDtParam );
@@ -376,6 +382,8 @@ private:
   static Distortion xGetSAD_NxN_SIMD( const DistParam& pcDtParam );
   template<X86_VEXT vext>
   static Distortion xGetSAD_IBD_SIMD( const DistParam& pcDtParam );
+  template<X86_VEXT vext>
+  static void       xGetDMVRSADs_SIMD( const Pel* pL0, const Pel* pL1, int stride, int width, int height, int bitDepth, Distortion* sads );
 
   template<X86_VEXT vext>
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
@@ -51,6 +51,8 @@
 Reshape::Reshape()
 : m_CTUFlag (false)
 , m_recReshaped (false)
+, m_fwdMapping ()
+, m_invMapping ()
 , m_reshape (true)
 #if  JVET_O1109_UNFIY_CRS
 , m_chromaScale (1 << CSCALE_FP_PREC)
@@ -274,6 +276,35 @@ int Reshape::getPWLIdxInv(int lumaVal)
 #endif
 }
 
+/** derive the segment description of the forward and inverse mapping from the codewords
+*  the mappings reproduce the forward and inverse LUTs for all samples in range
+*/
+void Reshape::updatePWLMappings()
+{
+  const int log2InitCW = floorLog2(m_initCW);
+  const Pel maxVal     = (Pel)((1 << m_lumaBD) - 1);
+
+  for (int i = 0; i < PIC_CODE_CW_BINS; i++)
+  {
+    m_fwdMapping.inBase[i]  = (Pel)(i * m_initCW);
+    m_fwdMapping.outBase[i] = m_reshapePivot[i];
+    m_fwdMapping.scale[i]   = ((int32_t)m_binCW[i] * (1 << FP_PREC) + (1 << (log2InitCW - 1))) >> log2InitCW;
+
+    m_invMapping.inBase[i]  = m_reshapePivot[i];
+    m_invMapping.outBase[i] = (Pel)(i * m_initCW);
+    m_invMapping.scale[i]   = m_binCW[i] == 0 ? 0 : (int32_t)(m_initCW * (1 << FP_PREC) / m_binCW[i]);
+  }
+  // forward segments are uniform, inverse segments follow getPWLIdxInv()
+  for (int j = 0; j < PIC_CODE_CW_BINS - 1; j++)
+  {
+    m_fwdMapping.threshold[j] = (Pel)((j + 1) * m_initCW);
+    m_invMapping.threshold[j] = j < m_sliceReshapeInfo.reshaperModelMinBinIdx ? std::numeric_limits<Pel>::min()
+                              : j > m_sliceReshapeInfo.reshaperModelMaxBinIdx ? std::numeric_limits<Pel>::max() : m_reshapePivot[j + 1];
+  }
+  m_fwdMapping.maxVal = maxVal;
+  m_invMapping.maxVal = maxVal;
+}
+
 /**
 -copy Slice reshaper info structure
 \param   tInfo describing the target Slice reshaper info structure
@@ -360,6 +391,7 @@ void Reshape::constructReshaper()
   reverseLUT(m_fwdLUT, m_invLUT, m_reshapeLUTSize);
   updateChromaScaleLUT();
 #endif
+  updatePWLMappings();
 }
 
 #if !JVET_O0428_LMCS_CLEANUP
@@ -59,6 +59,8 @@ protected:
   bool                    m_recReshaped;
   std::vector<Pel>        m_invLUT;
   std::vector<Pel>        m_fwdLUT;
+  PWLMapping              m_fwdMapping;
+  PWLMapping              m_invMapping;
   std::vector<int>        m_chromaAdjHelpLUT;
   std::vector<uint16_t>   m_binCW;
   uint16_t                m_initCW;
@@ -76,6 +78,8 @@ protected:
   int                     m_vpduX;
   int                     m_vpduY;
 #endif
+
+  void updatePWLMappings();
 public:
   Reshape();
 #if ENABLE_SPLIT_PARALLELISM
@@ -92,6 +96,8 @@ public:
 #endif
   std::vector<Pel>&  getFwdLUT() { return m_fwdLUT; }
   std::vector<Pel>&  getInvLUT() { return m_invLUT; }
+  const PWLMapping&  getFwdMapping() const { return m_fwdMapping; }
+  const PWLMapping&  getInvMapping() const { return m_invMapping; }
   std::vector<int>&  getChromaAdjHelpLUT() { return m_chromaAdjHelpLUT; }
 
   bool getCTUFlag()              { return m_CTUFlag; }
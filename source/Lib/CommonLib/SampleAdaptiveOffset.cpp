@@ -40,6 +40,7 @@
 #include "UnitTools.h"
 #include "UnitPartitioner.h"
 #include "CodingStructure.h"
+#include "StageProfiler.h"
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
 
@@ -617,6 +618,7 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
 void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                                       )
 {
+  PROFILE_STAGE( PROF_STAGE_SAO );
   CHECK(!saoBlkParams, "No parameters present");
 
   xReconstructBlkSAOParams(cs, saoBlkParams);
@@ -787,7 +789,7 @@ void SampleAdaptiveOffset::xLosslessSampleRestoration(CodingUnit& cu, const Comp
       dstBuf.copyFrom( pcmBuf );
       if (cu.slice->getLmcsEnabledFlag() && isLuma(compID))
       {
-        dstBuf.rspSignal(m_pcReshape->getInvLUT());
+        dstBuf.rspSignal(m_pcReshape->getInvMapping());
       }
     }
 
@@ -810,7 +812,7 @@ void SampleAdaptiveOffset::xLosslessSampleRestoration(CodingUnit& cu, const Comp
   }
   if (cu.slice->getLmcsEnabledFlag()&& isLuma(compID))
   {
-    dstBuf.rspSignal(m_pcReshape->getInvLUT());
+    dstBuf.rspSignal(m_pcReshape->getInvMapping());
   }
 #endif
 }
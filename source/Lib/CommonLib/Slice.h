@@ -507,6 +507,7 @@ struct ReshapeCW
   int       updateCtrl;
   int       adpOption;
   uint32_t  initialCW;
+  int       numThreads;
 #endif
   int rspPicSize;
 #if !JVET_O0432_LMCS_ENCODER
@@ -2264,9 +2265,9 @@ public:
   bool                        getDisableSATDForRD() { return m_disableSATDForRd; }
 #if JVET_O1164_RPR
 #if JVET_O0299_APS_SCALINGLIST
-  void                        scaleRefPicList( Picture *scaledRefPic[ ], APS** apss, APS* lmcsAps, APS* scalingListAps, const bool isDecoder );
+  void                        scaleRefPicList( Picture *scaledRefPic[ ], APS** apss, APS* lmcsAps, APS* scalingListAps, const bool isDecoder, const int numThreads = 1 );
 #else
-  void                        scaleRefPicList( Picture *scaledRefPic[], APS** apss, APS& lmcsAps, const bool isDecoder );
+  void                        scaleRefPicList( Picture *scaledRefPic[], APS** apss, APS& lmcsAps, const bool isDecoder, const int numThreads = 1 );
 #endif
   void                        freeScaledRefPicList( Picture *scaledRefPic[] );
   bool                        checkRPR();
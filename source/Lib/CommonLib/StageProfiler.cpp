@@ -0,0 +1,201 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageProfiler.cpp
+    \brief    per-stage timers and counters
+*/
+
+#include "StageProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+//! \ingroup CommonLib
+//! \{
+
+StageProfiler g_stageProfiler;
+
+static const char* const g_stageNames[NUM_PROF_STAGES] =
+{
+  "parse",
+  "intraPred",
+  "interPred",
+  "transform",
+  "rdo",
+  "deblock",
+  "sao",
+  "alf",
+  "read",
+  "write",
+};
+
+void StageStats::reset()
+{
+  std::fill_n( time,          NUM_PROF_STAGES,     0 );
+  std::fill_n( count,         NUM_PROF_STAGES,     0 );
+  std::fill_n( modeTestTime,  PROF_MAX_MODE_TESTS, 0 );
+  std::fill_n( modeTestCount, PROF_MAX_MODE_TESTS, 0 );
+}
+
+void StageStats::add( const StageStats& other )
+{
+  for( int i = 0; i < NUM_PROF_STAGES; i++ )
+  {
+    time [i] += other.time [i];
+    count[i] += other.count[i];
+  }
+  for( int i = 0; i < PROF_MAX_MODE_TESTS; i++ )
+  {
+    modeTestTime [i] += other.modeTestTime [i];
+    modeTestCount[i] += other.modeTestCount[i];
+  }
+}
+
+void StageStats::subtract( const StageStats& other )
+{
+  for( int i = 0; i < NUM_PROF_STAGES; i++ )
+  {
+    time [i] -= other.time [i];
+    count[i] -= other.count[i];
+  }
+  for( int i = 0; i < PROF_MAX_MODE_TESTS; i++ )
+  {
+    modeTestTime [i] -= other.modeTestTime [i];
+    modeTestCount[i] -= other.modeTestCount[i];
+  }
+}
+
+void StageProfiler::setModeTestName( int modeTest, const std::string& name )
+{
+  CHECK( modeTest < 0 || modeTest >= PROF_MAX_MODE_TESTS, "Invalid mode test index" );
+  if( (int)m_modeTestNames.size() <= modeTest )
+  {
+    m_modeTestNames.resize( modeTest + 1 );
+  }
+  m_modeTestNames[modeTest] = name;
+}
+
+StageStats& StageProfiler::getThreadStats()
+{
+  // each thread accumulates into its own statistics, which are only summed up for reporting
+  static thread_local StageStats* threadStats = nullptr;
+  if( threadStats == nullptr )
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_threadStats.emplace_back( new StageStats );
+    threadStats = m_threadStats.back().get();
+  }
+  return *threadStats;
+}
+
+void StageProfiler::xSumThreads( StageStats& sum )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  sum.reset();
+  for( auto& stats : m_threadStats )
+  {
+    sum.add( *stats );
+  }
+}
+
+void StageProfiler::finishPicture( int poc )
+{
+  if( !m_enabled )
+  {
+    return;
+  }
+  // everything accumulated since the previous picture is attributed to this picture
+  PictureStats picStats;
+  picStats.poc = poc;
+  xSumThreads( picStats.stats );
+  const StageStats sum = picStats.stats;
+  picStats.stats.subtract( m_lastSum );
+  m_lastSum = sum;
+  m_pictureStats.push_back( picStats );
+}
+
+void StageProfiler::xWriteStats( std::ostream& os, const StageStats& stats, const char* indent ) const
+{
+  os << indent << "\"stages\": {";
+  for( int i = 0; i < NUM_PROF_STAGES; i++ )
+  {
+    os << ( i ? ", " : " " ) << "\"" << g_stageNames[i] << "\": { \"timeMs\": " << stats.time[i] * 1e-6 << ", \"count\": " << stats.count[i] << " }";
+  }
+  os << " },\n" << indent << "\"modeTests\": {";
+  bool first = true;
+  for( int i = 0; i < (int)m_modeTestNames.size(); i++ )
+  {
+    if( m_modeTestNames[i].empty() )
+    {
+      continue;
+    }
+    os << ( first ? " " : ", " ) << "\"" << m_modeTestNames[i] << "\": { \"timeMs\": " << stats.modeTestTime[i] * 1e-6 << ", \"count\": " << stats.modeTestCount[i] << " }";
+    first = false;
+  }
+  os << " }";
+}
+
+void StageProfiler::writeJson( const std::string& fileName )
+{
+  if( !m_enabled )
+  {
+    return;
+  }
+  std::ofstream os( fileName.c_str() );
+  CHECK( !os.is_open(), "Unable to open stage statistics file " << fileName );
+
+  StageStats sum;
+  xSumThreads( sum );
+
+  os << std::fixed << std::setprecision( 3 );
+  os << "{\n  \"pictures\": [\n";
+  for( size_t i = 0; i < m_pictureStats.size(); i++ )
+  {
+    os << "    {\n      \"poc\": " << m_pictureStats[i].poc << ",\n";
+    xWriteStats( os, m_pictureStats[i].stats, "      " );
+    os << "\n    }" << ( i + 1 < m_pictureStats.size() ? "," : "" ) << "\n";
+  }
+  os << "  ],\n  \"sequence\": {\n";
+  xWriteStats( os, sum, "    " );
+  os << ",\n    \"threads\": [\n";
+  for( size_t i = 0; i < m_threadStats.size(); i++ )
+  {
+    os << "      {\n";
+    xWriteStats( os, *m_threadStats[i], "        " );
+    os << "\n      }" << ( i + 1 < m_threadStats.size() ? "," : "" ) << "\n";
+  }
+  os << "    ]\n  }\n}\n";
+}
+
+//! \}
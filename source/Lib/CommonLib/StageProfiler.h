@@ -0,0 +1,183 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageProfiler.h
+    \brief    per-stage timers and counters (header)
+*/
+
+#ifndef __STAGEPROFILER__
+#define __STAGEPROFILER__
+
+#include "CommonDef.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+enum ProfilingStage
+{
+  PROF_STAGE_PARSE = 0,     ///< slice data parsing
+  PROF_STAGE_INTRA_PRED,    ///< intra prediction
+  PROF_STAGE_INTER_PRED,    ///< motion compensation
+  PROF_STAGE_TRANSFORM,     ///< forward and inverse transform including quantization
+  PROF_STAGE_RDO,           ///< encoder mode decision, see the mode test counters for details
+  PROF_STAGE_DEBLOCK,       ///< deblocking filter
+  PROF_STAGE_SAO,           ///< sample adaptive offset, including the encoder estimation
+  PROF_STAGE_ALF,           ///< adaptive loop filter, including the encoder estimation
+  PROF_STAGE_READ,          ///< reading of input pictures or bitstream
+  PROF_STAGE_WRITE,         ///< writing of reconstructed pictures or bitstream
+  NUM_PROF_STAGES
+};
+
+static const int PROF_MAX_MODE_TESTS = 32;
+
+/// accumulated time (in ns) and number of calls
+struct StageStats
+{
+  uint64_t time        [NUM_PROF_STAGES];
+  uint64_t count       [NUM_PROF_STAGES];
+  uint64_t modeTestTime [PROF_MAX_MODE_TESTS];
+  uint64_t modeTestCount[PROF_MAX_MODE_TESTS];
+  int      activeScopes [NUM_PROF_STAGES];    ///< open timers per stage of the owning thread, not part of the statistics
+
+  StageStats() { reset(); std::fill_n( activeScopes, NUM_PROF_STAGES, 0 ); }
+  void reset   ();
+  void add     ( const StageStats& other );
+  void subtract( const StageStats& other );
+};
+
+/// collects the statistics of all threads and reports them per picture and per sequence
+class StageProfiler
+{
+public:
+  StageProfiler() : m_enabled( false ) {}
+  ~StageProfiler() {}
+
+  void        setEnabled        ( bool enabled )  { m_enabled = enabled; }
+  bool        isEnabled         () const          { return m_enabled; }
+  void        setModeTestName   ( int modeTest, const std::string& name );
+
+  StageStats& getThreadStats    ();
+  void        finishPicture     ( int poc );
+  void        writeJson         ( const std::string& fileName );
+
+private:
+  void        xSumThreads       ( StageStats& sum );
+  void        xWriteStats       ( std::ostream& os, const StageStats& stats, const char* indent ) const;
+
+  struct PictureStats
+  {
+    int        poc;
+    StageStats stats;
+  };
+
+  bool                                      m_enabled;
+  std::mutex                                m_mutex;
+  std::vector<std::unique_ptr<StageStats>>  m_threadStats;
+  std::vector<std::string>                  m_modeTestNames;
+  std::vector<PictureStats>                 m_pictureStats;
+  StageStats                                m_lastSum;
+};
+
+extern StageProfiler g_stageProfiler;
+
+/// adds the lifetime of the object to a stage (or a mode test) of the calling thread
+/// only the outermost scope of a stage is counted, nested mode test scopes are counted inclusively
+class StageTimer
+{
+public:
+  StageTimer( ProfilingStage stage, int modeTest = -1 )
+    : m_stats( g_stageProfiler.isEnabled() ? &g_stageProfiler.getThreadStats() : nullptr )
+    , m_stage( stage )
+    , m_modeTest( modeTest )
+    , m_timed( false )
+  {
+    if( m_stats )
+    {
+      m_timed = m_modeTest >= 0 || m_stats->activeScopes[m_stage]++ == 0;
+      if( m_timed )
+      {
+        m_start = std::chrono::steady_clock::now();
+      }
+    }
+  }
+
+  ~StageTimer()
+  {
+    if( m_stats && m_modeTest < 0 )
+    {
+      m_stats->activeScopes[m_stage]--;
+    }
+    if( m_timed )
+    {
+      const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_start ).count();
+      if( m_modeTest < 0 )
+      {
+        m_stats->time [m_stage] += ns;
+        m_stats->count[m_stage]++;
+      }
+      else if( m_modeTest < PROF_MAX_MODE_TESTS )
+      {
+        // mode tests recurse through the split modes, keep them out of the stage totals
+        m_stats->modeTestTime [m_modeTest] += ns;
+        m_stats->modeTestCount[m_modeTest]++;
+      }
+    }
+  }
+
+private:
+  StageStats*                           m_stats;
+  ProfilingStage                        m_stage;
+  int                                   m_modeTest;
+  bool                                  m_timed;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+#if ENABLE_STAGE_PROFILING
+#define PROFILE_STAGE_CAT2( a, b )        a##b
+#define PROFILE_STAGE_CAT( a, b )         PROFILE_STAGE_CAT2( a, b )
+#define PROFILE_STAGE( stage )            StageTimer PROFILE_STAGE_CAT( stageTimer, __LINE__ )( stage )
+#define PROFILE_MODE_TEST( modeTest )     StageTimer PROFILE_STAGE_CAT( stageTimer, __LINE__ )( PROF_STAGE_RDO, int( modeTest ) )
+#else
+#define PROFILE_STAGE( stage )
+#define PROFILE_MODE_TEST( modeTest )
+#endif
+
+//! \}
+
+#endif // __STAGEPROFILER__
@@ -42,6 +42,7 @@
 #include "ContextModelling.h"
 #include "CodingStructure.h"
 #include "CrossCompPrediction.h"
+#include "StageProfiler.h"
 
 
 #include "dtrace_buffer.h"
@@ -161,7 +162,7 @@ template<int signedMode> void invTransformCbCr( PelBuf &resCb, PelBuf &resCr )
 // ====================================================================================================================
 // TrQuant class member functions
 // ====================================================================================================================
-TrQuant::TrQuant() : m_quant( nullptr )
+TrQuant::TrQuant() : m_quant( nullptr ), m_useFwdTrCache( false ), m_fwdTrCacheNext( 0 )
 {
   // allocate temporary buffers
 #if JVET_O0105_ICT
@@ -183,6 +184,15 @@ TrQuant::TrQuant() : m_quant( nullptr )
     m_fwdICT[ 3]  = fwdTransformCbCr< 3>;
     m_fwdICT[-3]  = fwdTransformCbCr<-3>;
   }
+#endif
+
+  m_fwdLfnstMatMul = xFwdLfnstMatMul;
+  m_invLfnstMatMul = xInvLfnstMatMul;
+
+#if ENABLE_SIMD_OPT_LFNST
+#ifdef TARGET_SIMD_X86
+  initTrQuantX86();
+#endif
 #endif
 }
 
@@ -231,20 +241,23 @@ void TrQuant::init( const Quant* otherQuant,
   {
     m_quant->init( uiMaxTrSize, bUseRDOQ, bUseRDOQTS, useSelectiveRDOQ );
   }
+
+  m_useFwdTrCache  = bEnc;
+  m_fwdTrCacheNext = 0;
+  for( int i = 0; i < FWD_TR_CACHE_SIZE; i++ )
+  {
+    m_fwdTrCache[i].key.width = 0;
+  }
 }
 
-void TrQuant::fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
+void TrQuant::xFwdLfnstMatMul( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize )
 {
-  const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
-  const int     trSize = ( size > 4 ) ? 48 : 16;
-  int           coef;
-  int*          out    = dst;
-
-  assert( index < 3 );
+  int  coef;
+  int* out = dst;
 
   for( int j = 0; j < zeroOutSize; j++ )
   {
-    int*          srcPtr   = src;
+    const int*    srcPtr   = src;
     const int8_t* trMatTmp = trMat;
     coef = 0;
     for( int i = 0; i < trSize; i++ )
@@ -254,37 +267,53 @@ void TrQuant::fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32
     *out++ = ( coef + 64 ) >> 7;
     trMat += trSize;
   }
-
-  ::memset( out, 0, ( trSize - zeroOutSize ) * sizeof( int ) );
 }
 
-void TrQuant::invLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
+void TrQuant::xInvLfnstMatMul( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const int outputMin, const int outputMax )
 {
-  int             maxLog2TrDynamicRange =  15;
-  const TCoeff    outputMinimum         = -( 1 << maxLog2TrDynamicRange );
-  const TCoeff    outputMaximum         =  ( 1 << maxLog2TrDynamicRange ) - 1;
-  const int8_t*   trMat                 =  ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
-  const int       trSize                =  ( size > 4 ) ? 48 : 16;
-  int             resi;
-  int*            out                   =  dst;
-
-  assert( index < 3 );
+  int  resi;
+  int* out = dst;
 
   for( int j = 0; j < trSize; j++ )
   {
     resi = 0;
     const int8_t* trMatTmp = trMat;
-    int*          srcPtr   = src;
+    const int*    srcPtr   = src;
     for( int i = 0; i < zeroOutSize; i++ )
     {
       resi += *srcPtr++ * *trMatTmp;
       trMatTmp += trSize;
     }
-    *out++ = Clip3( outputMinimum, outputMaximum, ( int ) ( resi + 64 ) >> 7 );
+    *out++ = Clip3( outputMin, outputMax, ( int ) ( resi + 64 ) >> 7 );
     trMat++;
   }
 }
 
+void TrQuant::fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
+{
+  const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
+  const int     trSize = ( size > 4 ) ? 48 : 16;
+
+  assert( index < 3 );
+
+  m_fwdLfnstMatMul( src, dst, trMat, trSize, zeroOutSize );
+
+  ::memset( dst + zeroOutSize, 0, ( trSize - zeroOutSize ) * sizeof( int ) );
+}
+
+void TrQuant::invLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
+{
+  int             maxLog2TrDynamicRange =  15;
+  const TCoeff    outputMinimum         = -( 1 << maxLog2TrDynamicRange );
+  const TCoeff    outputMaximum         =  ( 1 << maxLog2TrDynamicRange ) - 1;
+  const int8_t*   trMat                 =  ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
+  const int       trSize                =  ( size > 4 ) ? 48 : 16;
+
+  assert( index < 3 );
+
+  m_invLfnstMatMul( src, dst, trMat, trSize, zeroOutSize, outputMinimum, outputMaximum );
+}
+
 uint32_t TrQuant::getLFNSTIntraMode( int wideAngPredMode )
 {
   uint32_t intraMode;
@@ -555,6 +584,7 @@ void TrQuant::xFwdLfnst( const TransformUnit &tu, const ComponentID compID, cons
 
 void TrQuant::invTransformNxN( TransformUnit &tu, const ComponentID &compID, PelBuf &pResi, const QpParam &cQP )
 {
+  PROFILE_STAGE( PROF_STAGE_TRANSFORM );
   const CompArea &area    = tu.blocks[compID];
   const uint32_t uiWidth      = area.width;
   const uint32_t uiHeight     = area.height;
@@ -888,10 +918,42 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
     const int      shift_2nd              =  (floorLog2(height))            + TRANSFORM_MATRIX_SHIFT                          + COM16_C806_TRANS_PREC;
     CHECK( shift_1st < 0, "Negative shift" );
     CHECK( shift_2nd < 0, "Negative shift" );
-  TCoeff *tmp = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
 
-  fastFwdTrans[trTypeHor][transformWidthIndex ](block,        tmp, shift_1st, height,        0, skipWidth);
-  fastFwdTrans[trTypeVer][transformHeightIndex](tmp, dstCoeff.buf, shift_2nd, width, skipWidth, skipHeight);
+    // the RD search transforms the same residual repeatedly (LFNST indices, MTS candidates sharing a horizontal
+    // transform, repeated ISP and chroma tests), the cache entries are matched against the full residual block
+    FwdTrKey key = { 0, width, height, shift_1st, trTypeHor, trTypeVer, skipWidth, skipHeight };
+    if( m_useFwdTrCache )
+    {
+      for( int n = 0; n < width * height; n++ )
+      {
+        key.hash = ( key.hash << 5 ) + key.hash + uint32_t( block[n] );
+      }
+
+      if( xLoadFwdTr( key, block, dstCoeff.buf ) )
+      {
+        return;
+      }
+    }
+
+    TCoeff *tmp = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
+
+    FwdTrKey horKey   = key;
+    horKey.trTypeVer  = -1;
+    horKey.skipHeight = 0;
+    if( !m_useFwdTrCache || !xLoadFwdTr( horKey, block, tmp ) )
+    {
+      fastFwdTrans[trTypeHor][transformWidthIndex ](block,        tmp, shift_1st, height,        0, skipWidth);
+      if( m_useFwdTrCache )
+      {
+        xStoreFwdTr( horKey, block, tmp );
+      }
+    }
+    fastFwdTrans[trTypeVer][transformHeightIndex](tmp, dstCoeff.buf, shift_2nd, width, skipWidth, skipHeight);
+
+    if( m_useFwdTrCache )
+    {
+      xStoreFwdTr( key, block, dstCoeff.buf );
+    }
   }
   else if( height == 1 ) //1-D horizontal transform
   {
@@ -909,6 +971,34 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
   }
 }
 
+bool TrQuant::xLoadFwdTr( const FwdTrKey &key, const TCoeff* resi, TCoeff* coeff ) const
+{
+  const int numCoeff = key.width * key.height;
+
+  for( int i = 0; i < FWD_TR_CACHE_SIZE; i++ )
+  {
+    const FwdTrCacheEntry& entry = m_fwdTrCache[i];
+    if( entry.key == key && !::memcmp( entry.resi.data(), resi, numCoeff * sizeof( TCoeff ) ) )
+    {
+      ::memcpy( coeff, entry.coeff.data(), numCoeff * sizeof( TCoeff ) );
+      return true;
+    }
+  }
+  return false;
+}
+
+void TrQuant::xStoreFwdTr( const FwdTrKey &key, const TCoeff* resi, const TCoeff* coeff )
+{
+  const int        numCoeff = key.width * key.height;
+  FwdTrCacheEntry& entry    = m_fwdTrCache[m_fwdTrCacheNext];
+
+  entry.key = key;
+  entry.resi .assign( resi,  resi  + numCoeff );
+  entry.coeff.assign( coeff, coeff + numCoeff );
+
+  m_fwdTrCacheNext = ( m_fwdTrCacheNext + 1 ) % FWD_TR_CACHE_SIZE;
+}
+
 void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pCoeff, PelBuf &pResidual )
 {
   const int      width                  = pCoeff.width;
@@ -1046,6 +1136,7 @@ void TrQuant::transformNxN( TransformUnit& tu, const ComponentID& compID, const
 void TrQuant::transformNxN( TransformUnit &tu, const ComponentID &compID, const QpParam &cQP, std::vector<TrMode>* trModes, const int maxCand, double* diagRatio, double* horVerRatio )
 #endif
 {
+  PROFILE_STAGE( PROF_STAGE_TRANSFORM );
         CodingStructure &cs = *tu.cs;
   const CompArea &rect      = tu.blocks[compID];
   const uint32_t width      = rect.width;
@@ -1124,6 +1215,7 @@ void TrQuant::transformNxN( TransformUnit& tu, const ComponentID& compID, const
 void TrQuant::transformNxN( TransformUnit &tu, const ComponentID &compID, const QpParam &cQP, TCoeff &uiAbsSum, const Ctx &ctx, const bool loadTr, double* diagRatio, double* horVerRatio )
 #endif
 {
+  PROFILE_STAGE( PROF_STAGE_TRANSFORM );
         CodingStructure &cs = *tu.cs;
   const SPS &sps            = *cs.sps;
   const CompArea &rect      = tu.blocks[compID];
@@ -85,6 +85,20 @@ public:
   uint32_t getLFNSTIntraMode( int wideAngPredMode );
   bool     getTransposeFlag ( uint32_t intraMode  );
 
+  /// dst[j] = ( sum_i src[i] * trMat[j * trSize + i] + 64 ) >> 7 for j < zeroOutSize
+  void ( *m_fwdLfnstMatMul )( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize );
+  /// dst[j] = clip( ( sum_i src[i] * trMat[i * trSize + j] + 64 ) >> 7 ) for j < trSize, i < zeroOutSize
+  void ( *m_invLfnstMatMul )( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const int outputMin, const int outputMax );
+
+  static void xFwdLfnstMatMul( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize );
+  static void xInvLfnstMatMul( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const int outputMin, const int outputMax );
+
+#ifdef TARGET_SIMD_X86
+  void initTrQuantX86();
+  template <X86_VEXT vext>
+  void _initTrQuantX86();
+#endif
+
 protected:
 
   void xFwdLfnst( const TransformUnit &tu, const ComponentID compID, const bool loadTr = false );
@@ -132,7 +146,38 @@ protected:
   TCoeff   m_tempCoeff[MAX_TB_SIZEY * MAX_TB_SIZEY];
 
 private:
+  /// parameters identifying a forward primary transform of a residual block, trTypeVer < 0 denotes the horizontal stage only
+  struct FwdTrKey
+  {
+    uint32_t hash;
+    int      width;
+    int      height;
+    int      shift;
+    int      trTypeHor;
+    int      trTypeVer;
+    int      skipWidth;
+    int      skipHeight;
+
+    bool operator==( const FwdTrKey& other ) const
+    {
+      return hash == other.hash && width == other.width && height == other.height && shift == other.shift && trTypeHor == other.trTypeHor
+          && trTypeVer == other.trTypeVer && skipWidth == other.skipWidth && skipHeight == other.skipHeight;
+    }
+  };
+
+  struct FwdTrCacheEntry
+  {
+    FwdTrKey            key;
+    std::vector<TCoeff> resi;
+    std::vector<TCoeff> coeff;
+  };
+
+  static const int FWD_TR_CACHE_SIZE = 32;
+
   DepQuant *m_quant;          //!< Quantizer
+  bool            m_useFwdTrCache;                        //!< encoder only: reuse primary transform results of identical residual blocks
+  FwdTrCacheEntry m_fwdTrCache[FWD_TR_CACHE_SIZE];
+  int             m_fwdTrCacheNext;
   TCoeff    m_mtsCoeffs[NUM_TRAFO_MODES_MTS][MAX_TB_SIZEY * MAX_TB_SIZEY];
   TCoeff   m_tempInMatrix [ 48 ];
   TCoeff   m_tempOutMatrix[ 48 ];
@@ -147,6 +192,8 @@ private:
 
   // forward Transform
   void xT               (const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, CoeffBuf &dstCoeff, const int width, const int height);
+  bool xLoadFwdTr       (const FwdTrKey &key, const TCoeff* resi, TCoeff* coeff) const;
+  void xStoreFwdTr      (const FwdTrKey &key, const TCoeff* resi, const TCoeff* coeff);
 
   // skipping Transform
   void xTransformSkip   (const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, TCoeff* psCoeff);
@@ -402,6 +402,10 @@ typedef std::pair<int, int>  TrCost;
 #endif
 #endif
 
+#ifndef ENABLE_STAGE_PROFILING
+#define ENABLE_STAGE_PROFILING                            1 // per-stage timers and counters, only active when a statistics file is given (StageStatsFile)
+#endif
+
 #define WCG_EXT                                           1
 #define WCG_WPSNR                                         WCG_EXT
 
@@ -467,6 +471,11 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_HASH                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the hash motion estimation CRC (SSE4.2), no impact on RD performance
+#define ENABLE_SIMD_OPT_METRICS                         ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the picture quality metrics (PSNR, SSIM), no impact on RD performance
+#define ENABLE_SIMD_OPT_QUANT                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the scalar quantisation and dequantisation, no impact on RD performance
+#define ENABLE_SIMD_OPT_LFNST                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the low-frequency non-separable transform, no impact on RD performance
+#define ENABLE_SIMD_OPT_CCLM                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the luma down-sampling of the cross-component linear model, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_GBI                               1                                                 ///< SIMD optimization for GBi
 #endif
@@ -1992,13 +1992,10 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
   RefPicList eColRefPicList = slice.getCheckLDC() ? eRefPicList : RefPicList(slice.getColFromL0Flag());
 
-  const MotionInfo& mi = pColPic->cs->getMotionInfo( pos );
+  const ColMotionField &colMotion = pColPic->cs->getColMotionField();
+  const int             colIdx    = colMotion.idx( pos );
 
-  if( !mi.isInter )
-  {
-    return false;
-  }
-  if (mi.isIBCmot)
+  if( !colMotion.isAvailable( colIdx ) )
   {
     return false;
   }
@@ -2006,12 +2003,12 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
   {
     return false;
   }
-  int iColRefIdx = mi.refIdx[eColRefPicList];
+  int iColRefIdx = colMotion.refIdx[eColRefPicList][colIdx];
 
   if (sbFlag && !slice.getCheckLDC())
   {
     eColRefPicList = eRefPicList;
-    iColRefIdx = mi.refIdx[eColRefPicList];
+    iColRefIdx = colMotion.refIdx[eColRefPicList][colIdx];
     if (iColRefIdx < 0)
     {
       return false;
@@ -2022,7 +2019,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
     if (iColRefIdx < 0)
     {
       eColRefPicList = RefPicList(1 - eColRefPicList);
-      iColRefIdx = mi.refIdx[eColRefPicList];
+      iColRefIdx = colMotion.refIdx[eColRefPicList][colIdx];
 
       if (iColRefIdx < 0)
       {
@@ -2035,7 +2032,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
   for( const auto s : pColPic->slices )
   {
-    if( s->getIndependentSliceIdx() == mi.sliceIdx )
+    if( s->getIndependentSliceIdx() == colMotion.sliceIdx[colIdx] )
     {
       pColSlice = s;
       break;
@@ -2056,7 +2053,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
 
   // Scale the vector.
-  Mv cColMv = mi.mv[eColRefPicList];
+  Mv cColMv = colMotion.mv[eColRefPicList][colIdx];
   cColMv.setHor(roundMvComp(cColMv.getHor()));
   cColMv.setVer(roundMvComp(cColMv.getVer()));
 
@@ -3688,9 +3685,9 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
   centerPos = Position{ PosType(centerPos.x & mask), PosType(centerPos.y & mask) };
 
   // derivation of center motion parameters from the collocated CU
-  const MotionInfo &mi = pColPic->cs->getMotionInfo(centerPos);
+  const ColMotionField &colMotion = pColPic->cs->getColMotionField();
 
-  if (mi.isInter && mi.isIBCmot == false)
+  if (colMotion.isAvailable(colMotion.idx(centerPos)))
   {
     mrgCtx.interDirNeighbours[count] = 0;
 
@@ -3738,15 +3735,13 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
 
       colPos = Position{ PosType(colPos.x & mask), PosType(colPos.y & mask) };
 
-      const MotionInfo &colMi = pColPic->cs->getMotionInfo(colPos);
-
       MotionInfo mi;
 
       found = false;
       mi.isInter = true;
       mi.sliceIdx = slice.getIndependentSliceIdx();
       mi.isIBCmot = false;
-      if (colMi.isInter && colMi.isIBCmot == false)
+      if (colMotion.isAvailable(colMotion.idx(colPos)))
       {
         for (unsigned currRefListId = 0; currRefListId < (bBSlice ? 2 : 1); currRefListId++)
         {
@@ -3971,6 +3966,13 @@ void PU::getTriangleMergeCandidates( const PredictionUnit &pu, MergeCtx& triangl
 {
   MergeCtx tmpMergeCtx;
 
+  PU::getInterMergeCandidates( pu, tmpMergeCtx, 0 );
+
+  getTriangleMergeCandidates( pu, triangleMrgCtx, tmpMergeCtx );
+}
+
+void PU::getTriangleMergeCandidates( const PredictionUnit &pu, MergeCtx& triangleMrgCtx, const MergeCtx &tmpMergeCtx )
+{
   const Slice &slice = *pu.cs->slice;
   const uint32_t maxNumMergeCand = slice.getMaxNumMergeCand();
 
@@ -3990,8 +3992,6 @@ void PU::getTriangleMergeCandidates( const PredictionUnit &pu, MergeCtx& triangl
 #endif
   }
 
-  PU::getInterMergeCandidates(pu, tmpMergeCtx, 0);
-
   for (int32_t i = 0; i < maxNumMergeCand; i++)
   {
     int parity = i & 1;
@@ -210,6 +210,7 @@ namespace PU
   bool isLMCModeEnabled               (const PredictionUnit &pu, unsigned mode);
   bool isChromaIntraModeCrossCheckMode(const PredictionUnit &pu);
   void getTriangleMergeCandidates     (const PredictionUnit &pu, MergeCtx &triangleMrgCtx);
+  void getTriangleMergeCandidates     (const PredictionUnit &pu, MergeCtx &triangleMrgCtx, const MergeCtx &tmpMergeCtx);
   void spanTriangleMotionInfo         (      PredictionUnit &pu, MergeCtx &triangleMrgCtx, const bool splitDir, const uint8_t candIdx0, const uint8_t candIdx1);
   int32_t mappingRefPic               (const PredictionUnit &pu, int32_t refPicPoc, bool targetRefPicList);
   bool isAddNeighborMv  (const Mv& currMv, Mv* neighborMvs, int numNeighborMv);
@@ -1239,6 +1239,104 @@ void linTf_SSE_entry( const Pel* src, int srcStride, Pel *dst, int dstStride, in
   }
 }
 
+static inline __m128i pwlLookup16( const __m128i &lo, const __m128i &hi, const __m128i &sel )
+{
+  return _mm_or_si128( _mm_shuffle_epi8( lo, sel ), _mm_slli_epi16( _mm_shuffle_epi8( hi, sel ), 8 ) );
+}
+
+template<X86_VEXT vext>
+void mapPWL_SSE( Pel *ptr, int stride, int width, int height, const PWLMapping& pwl )
+{
+  if( pwl.maxVal > 1023 || ( width & 3 ) )
+  {
+    mapPWLCore( ptr, stride, width, height, pwl );
+    return;
+  }
+
+  // byte planes of the per-segment parameters, looked up with pshufb using the segment index
+  const __m128i vLow8  = _mm_set1_epi16( 0xff );
+  const __m128i vLow32 = _mm_set1_epi32( 0xff );
+  __m128i vOutLo, vOutHi, vInLo, vInHi, vScale[3];
+  {
+    __m128i a = _mm_loadu_si128( ( const __m128i* ) &pwl.outBase[0] );
+    __m128i b = _mm_loadu_si128( ( const __m128i* ) &pwl.outBase[8] );
+    vOutLo = _mm_packus_epi16( _mm_and_si128( a, vLow8 ), _mm_and_si128( b, vLow8 ) );
+    vOutHi = _mm_packus_epi16( _mm_srli_epi16( a, 8 ), _mm_srli_epi16( b, 8 ) );
+    a = _mm_loadu_si128( ( const __m128i* ) &pwl.inBase[0] );
+    b = _mm_loadu_si128( ( const __m128i* ) &pwl.inBase[8] );
+    vInLo  = _mm_packus_epi16( _mm_and_si128( a, vLow8 ), _mm_and_si128( b, vLow8 ) );
+    vInHi  = _mm_packus_epi16( _mm_srli_epi16( a, 8 ), _mm_srli_epi16( b, 8 ) );
+
+    const __m128i s0 = _mm_loadu_si128( ( const __m128i* ) &pwl.scale[0] );
+    const __m128i s1 = _mm_loadu_si128( ( const __m128i* ) &pwl.scale[4] );
+    const __m128i s2 = _mm_loadu_si128( ( const __m128i* ) &pwl.scale[8] );
+    const __m128i s3 = _mm_loadu_si128( ( const __m128i* ) &pwl.scale[12] );
+    for( int k = 0; k < 3; k++ )
+    {
+      const __m128i vShift = _mm_cvtsi32_si128( 8 * k );
+      __m128i p01 = _mm_packus_epi32( _mm_and_si128( _mm_srl_epi32( s0, vShift ), vLow32 ), _mm_and_si128( _mm_srl_epi32( s1, vShift ), vLow32 ) );
+      __m128i p23 = _mm_packus_epi32( _mm_and_si128( _mm_srl_epi32( s2, vShift ), vLow32 ), _mm_and_si128( _mm_srl_epi32( s3, vShift ), vLow32 ) );
+      vScale[k] = _mm_packus_epi16( p01, p23 );
+    }
+  }
+
+  __m128i vThreshold[PIC_CODE_CW_BINS - 1];
+  for( int j = 0; j < PIC_CODE_CW_BINS - 1; j++ )
+  {
+    vThreshold[j] = _mm_set1_epi16( pwl.threshold[j] );
+  }
+
+  const __m128i vLastIdx = _mm_set1_epi16( PIC_CODE_CW_BINS - 1 );
+  const __m128i vSelHigh = _mm_set1_epi16( ( short ) 0x8000 );
+  const __m128i vRound   = _mm_set1_epi32( 1 << ( FP_PREC - 1 ) );
+  const __m128i vLow16   = _mm_set1_epi32( 0xffff );
+  const __m128i vMin     = _mm_setzero_si128();
+  const __m128i vMax     = _mm_set1_epi16( pwl.maxVal );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      const bool half = x + 8 > width;
+      __m128i vVal = half ? _mm_loadl_epi64( ( const __m128i* ) &ptr[x] ) : _mm_loadu_si128( ( const __m128i* ) &ptr[x] );
+
+      // segment index: the number of thresholds not above the sample
+      __m128i vIdx = vLastIdx;
+      for( int j = 0; j < PIC_CODE_CW_BINS - 1; j++ )
+      {
+        vIdx = _mm_add_epi16( vIdx, _mm_cmplt_epi16( vVal, vThreshold[j] ) );
+      }
+      // the high byte of every selector has its MSB set, so pshufb zeroes it
+      const __m128i vSel = _mm_or_si128( vIdx, vSelHigh );
+
+      const __m128i vOut   = pwlLookup16( vOutLo, vOutHi, vSel );
+      const __m128i vIn    = pwlLookup16( vInLo, vInHi, vSel );
+      const __m128i vScLo  = pwlLookup16( vScale[0], vScale[1], vSel );
+      const __m128i vScHi  = _mm_shuffle_epi8( vScale[2], vSel );
+
+      const __m128i vDiff  = _mm_sub_epi16( vVal, vIn );
+      __m128i vProd0 = _mm_mullo_epi32( _mm_cvtepi16_epi32( vDiff ), _mm_unpacklo_epi16( vScLo, vScHi ) );
+      __m128i vProd1 = _mm_mullo_epi32( _mm_cvtepi16_epi32( _mm_srli_si128( vDiff, 8 ) ), _mm_unpackhi_epi16( vScLo, vScHi ) );
+      vProd0 = _mm_srai_epi32( _mm_add_epi32( vProd0, vRound ), FP_PREC );
+      vProd1 = _mm_srai_epi32( _mm_add_epi32( vProd1, vRound ), FP_PREC );
+      // keep the low 16 bits, the scalar mapping converts to Pel before clipping
+      const __m128i vDelta = _mm_packus_epi32( _mm_and_si128( vProd0, vLow16 ), _mm_and_si128( vProd1, vLow16 ) );
+
+      vVal = _mm_min_epi16( vMax, _mm_max_epi16( vMin, _mm_add_epi16( vOut, vDelta ) ) );
+
+      if( half )
+      {
+        _mm_storel_epi64( ( __m128i* ) &ptr[x], vVal );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) &ptr[x], vVal );
+      }
+    }
+    ptr += stride;
+  }
+}
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -1256,6 +1354,7 @@ void PelBufferOps::_initPelBufOpsX86()
 
   copyBuffer = copyBufferSimd<vext>;
   padding    = paddingSimd<vext>;
+  mapPWL     = mapPWL_SSE<vext>;
   reco8 = reco_SSE<vext, 8>;
   reco4 = reco_SSE<vext, 4>;
 
@@ -0,0 +1,104 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the hash motion estimation CRC functions
+ */
+
+#include "CommonDefX86.h"
+#include "../Unit.h"
+#include "../Hash.h"
+
+#ifdef TARGET_SIMD_X86
+
+#include <nmmintrin.h>
+#include <cstring>
+
+static inline uint32_t swapBytes32(uint32_t val)
+{
+  return (val >> 24) | ((val >> 8) & 0xff00) | ((val << 8) & 0xff0000) | (val << 24);
+}
+
+// hardware CRC32-C truncated to 24 bits, identical to TComHash::xGetCRCValue1/2
+// the second hash value uses another seed and processes the data backwards (byte-swapped words)
+template<X86_VEXT vext, int hashIdx>
+static uint32_t simdGetCRCValue(const unsigned char* p, int length)
+{
+  uint32_t crc;
+  uint32_t val;
+
+  if (hashIdx == 0)
+  {
+    crc = 0;
+    int i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+      memcpy(&val, p + i, sizeof(val));
+      crc = _mm_crc32_u32(crc, val);
+    }
+    for (; i < length; i++)
+    {
+      crc = _mm_crc32_u8(crc, p[i]);
+    }
+  }
+  else
+  {
+    crc = 0xffffffff;
+    int i = length;
+    for (; i >= 4; i -= 4)
+    {
+      memcpy(&val, p + i - 4, sizeof(val));
+      crc = _mm_crc32_u32(crc, swapBytes32(val));
+    }
+    for (; i > 0; i--)
+    {
+      crc = _mm_crc32_u8(crc, p[i - 1]);
+    }
+  }
+
+  return crc & 0xffffff;
+}
+
+template <X86_VEXT vext>
+void TComHash::_initHashX86()
+{
+  m_getCRCValue[0] = simdGetCRCValue<vext, 0>;
+  m_getCRCValue[1] = simdGetCRCValue<vext, 1>;
+}
+
+template void TComHash::_initHashX86<SIMDX86>();
+
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -42,17 +42,42 @@
 #ifdef TARGET_SIMD_X86
 
 #include <nmmintrin.h>
+#include <cstring>
 
 template<X86_VEXT vext>
-static uint32_t simdComputeCrc32c16bit(uint32_t crc, const Pel pel)
+static uint32_t simdCalcBlockCrc32c(const Pel* pel, const int stride, const int width, const int height, uint32_t crc)
 {
-  return _mm_crc32_u16(crc, pel);
+  if (sizeof(Pel) == 2 && (width & 1) == 0)
+  {
+    // two 16-bit samples per step, same result as hashing the samples one by one
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x += 2)
+      {
+        uint32_t val;
+        memcpy(&val, pel + x, sizeof(val));
+        crc = _mm_crc32_u32(crc, val);
+      }
+      pel += stride;
+    }
+    return crc;
+  }
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      crc = _mm_crc32_u16(crc, pel[x]);
+    }
+    pel += stride;
+  }
+  return crc;
 }
 
 template <X86_VEXT vext>
 void IbcHashMap::_initIbcHashMapX86()
 {
-  m_computeCrc32c = simdComputeCrc32c16bit<vext>;
+  m_calcBlockCrc32c = simdCalcBlockCrc32c<vext>;
 }
 
 template void IbcHashMap::_initIbcHashMapX86<SIMDX86>();
@@ -50,6 +50,14 @@
 
 #include "CommonLib/IbcHashMap.h"
 
+#include "CommonLib/Hash.h"
+
+#include "CommonLib/PictureMetrics.h"
+
+#include "CommonLib/Quant.h"
+
+#include "CommonLib/IntraPrediction.h"
+
 #ifdef TARGET_SIMD_X86
 
 
@@ -186,5 +194,108 @@ void IbcHashMap::initIbcHashMapX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_METRICS
+void PictureMetrics::initPictureMetricsX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initPictureMetricsX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initPictureMetricsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_QUANT
+void Quant::initQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initQuantX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_LFNST
+void TrQuant::initTrQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initTrQuantX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initTrQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_CCLM
+void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_HASH
+void TComHash::initHashX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+  case AVX:
+  case SSE42:
+    _initHashX86<SSE42>();
+    break;
+  case SSE41:
+  default:
+    break;
+  }
+}
+#endif
+
 #endif
 
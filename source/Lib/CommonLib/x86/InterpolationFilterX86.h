@@ -1289,6 +1289,45 @@ void xWeightedTriangleBlk_SSE(const PredictionUnit &pu, const uint32_t width, co
       weight += 4;
     }
   }
+#ifdef USE_AVX2
+  else if (vext >= AVX2 && (width & 15) == 0)
+  {
+    const __m256i mmEight256  = _mm256_set1_epi16(8);
+    const __m256i mmOffset256 = _mm256_set1_epi32(offsetWeighted);
+    const __m256i mmMin256    = _mm256_set1_epi16(clpRng.min);
+    const __m256i mmMax256    = _mm256_set1_epi16(clpRng.max);
+
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x += 16)
+      {
+        __m256i s0 = _mm256_lddqu_si256((__m256i *) (src0 + x));
+        __m256i s1 = _mm256_lddqu_si256((__m256i *) (src1 + x));
+        __m256i w0 = _mm256_lddqu_si256((__m256i *) (weight + x));
+        __m256i w1 = _mm256_sub_epi16(mmEight256, w0);
+
+        // unpack and pack both work within 128-bit lanes, so the sample order is preserved
+        __m256i s0tmp = _mm256_unpacklo_epi16(s0, s1);
+        __m256i w0tmp = _mm256_unpacklo_epi16(w0, w1);
+        s0tmp = _mm256_add_epi32(_mm256_madd_epi16(s0tmp, w0tmp), mmOffset256);
+        s0tmp = _mm256_sra_epi32(s0tmp, mmShift);
+
+        s0 = _mm256_unpackhi_epi16(s0, s1);
+        w0 = _mm256_unpackhi_epi16(w0, w1);
+        s0 = _mm256_add_epi32(_mm256_madd_epi16(s0, w0), mmOffset256);
+        s0 = _mm256_sra_epi32(s0, mmShift);
+
+        s0 = _mm256_packs_epi32(s0tmp, s0);
+        s0 = _mm256_min_epi16(mmMax256, _mm256_max_epi16(s0, mmMin256));
+        _mm256_storeu_si256((__m256i *) (dst + x), s0);
+      }
+      dst += strideDst;
+      src0 += strideSrc0;
+      src1 += strideSrc1;
+      weight += width;
+    }
+  }
+#endif
   else
   {
     for (int y = 0; y < height; y++)
@@ -1323,6 +1362,59 @@ void xWeightedTriangleBlk_SSE(const PredictionUnit &pu, const uint32_t width, co
 }
 #endif
 
+#if JVET_O1164_RPR
+template<X86_VEXT vext>
+static void simdFilterHorPhase( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int const *srcOffsets, TFilterCoeff const *coeffs )
+{
+  const int headRoom = std::max<int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) );
+  const int shift    = IF_FILTER_PREC - headRoom;
+
+  const __m128i vOffset = _mm_set1_epi32( -IF_INTERNAL_OFFS << shift );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+
+  int col = 0;
+
+  // four columns at a time, the taps of each column stay in a register for the whole block
+  for( ; col + 4 <= width; col += 4 )
+  {
+    const __m128i vCoeff0 = _mm_loadu_si128( ( const __m128i* ) ( coeffs + ( col + 0 ) * NTAPS_LUMA ) );
+    const __m128i vCoeff1 = _mm_loadu_si128( ( const __m128i* ) ( coeffs + ( col + 1 ) * NTAPS_LUMA ) );
+    const __m128i vCoeff2 = _mm_loadu_si128( ( const __m128i* ) ( coeffs + ( col + 2 ) * NTAPS_LUMA ) );
+    const __m128i vCoeff3 = _mm_loadu_si128( ( const __m128i* ) ( coeffs + ( col + 3 ) * NTAPS_LUMA ) );
+
+    const Pel* src0 = src + srcOffsets[col + 0];
+    const Pel* src1 = src + srcOffsets[col + 1];
+    const Pel* src2 = src + srcOffsets[col + 2];
+    const Pel* src3 = src + srcOffsets[col + 3];
+    Pel*       d    = dst + col;
+
+    for( int row = 0; row < height; row++ )
+    {
+      __m128i vSum0 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) src0 ), vCoeff0 );
+      __m128i vSum1 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) src1 ), vCoeff1 );
+      __m128i vSum2 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) src2 ), vCoeff2 );
+      __m128i vSum3 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) src3 ), vCoeff3 );
+
+      __m128i vSum  = _mm_hadd_epi32( _mm_hadd_epi32( vSum0, vSum1 ), _mm_hadd_epi32( vSum2, vSum3 ) );
+      vSum          = _mm_sra_epi32( _mm_add_epi32( vSum, vOffset ), vShift );
+
+      _mm_storel_epi64( ( __m128i* ) d, _mm_packs_epi32( vSum, vSum ) );
+
+      src0 += srcStride;
+      src1 += srcStride;
+      src2 += srcStride;
+      src3 += srcStride;
+      d    += dstStride;
+    }
+  }
+
+  if( col < width )
+  {
+    InterpolationFilter::filterHorPhase( clpRng, src, srcStride, dst + col, dstStride, width - col, height, srcOffsets + col, coeffs + col * NTAPS_LUMA );
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 void InterpolationFilter::_initInterpolationFilterX86()
 {
@@ -1362,6 +1454,10 @@ void InterpolationFilter::_initInterpolationFilterX86()
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
   m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
 
+#if JVET_O1164_RPR
+  m_filterHorPhase     = simdFilterHorPhase<vext>;
+#endif
+
 #if JVET_O0280_SIMD_TRIANGLE_WEIGHTING
   m_weightedTriangleBlk = xWeightedTriangleBlk_SSE<vext>;
 #endif
@@ -0,0 +1,144 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the intra prediction kernels
+ */
+
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// each output of the 4:2:0 and 4:2:2 filters is the weighted sum of the centre sample src[2i], its right neighbour
+// src[2i+1] and its left neighbour src[2i-1], the centre and the right one form a pair of a load at src+2i and the
+// left one is the first sample of a pair of a load at src+2i-1, such that both are weighted with a single madd
+template<X86_VEXT vext>
+static void simdDownsampleLuma( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const ptrdiff_t dstStride, const int width, const int height, const ChromaFormat chFmt, const bool collocated )
+{
+  if( chFmt == CHROMA_444 || ( chFmt == CHROMA_422 && collocated ) || width < 4 )
+  {
+    IntraPrediction::xDownsampleLuma( src, srcStride, dst, dstStride, width, height, chFmt, collocated );
+    return;
+  }
+
+  const bool      is420   = chFmt == CHROMA_420;
+  const bool      twoRows = is420 && !collocated;
+  const bool      upDown  = is420 && collocated;
+  const int       shift   = is420 ? 3 : 2;
+  const int       centre  = upDown ? 4 : 2;
+  const ptrdiff_t srcStep = is420 ? 2 * srcStride : srcStride;
+
+  for( int j = 0; j < height; j++, src += srcStep, dst += dstStride )
+  {
+    int i = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vcr  = _mm256_set1_epi32( ( 1 << 16 ) | centre );
+      const __m256i vl   = _mm256_set1_epi32( 1 );
+      const __m256i voff = _mm256_set1_epi32( 1 << ( shift - 1 ) );
+
+      for( ; i + 8 <= width; i += 8 )
+      {
+        const Pel* s   = src + 2 * i;
+        __m256i    sum = _mm256_add_epi32( voff, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) s ), vcr ) );
+        sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) ( s - 1 ) ), vl ) );
+        if( twoRows )
+        {
+          sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) ( s + srcStride ) ), vcr ) );
+          sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) ( s + srcStride - 1 ) ), vl ) );
+        }
+        else if( upDown )
+        {
+          sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) ( s - srcStride ) ), vl ) );
+          sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) ( s + srcStride ) ), vl ) );
+        }
+        sum = _mm256_srai_epi32( sum, shift );
+        sum = _mm256_permute4x64_epi64( _mm256_packs_epi32( sum, sum ), 0x08 );
+        _mm_storeu_si128( ( __m128i* ) ( dst + i ), _mm256_castsi256_si128( sum ) );
+      }
+    }
+#endif
+
+    const __m128i vcr  = _mm_set1_epi32( ( 1 << 16 ) | centre );
+    const __m128i vl   = _mm_set1_epi32( 1 );
+    const __m128i voff = _mm_set1_epi32( 1 << ( shift - 1 ) );
+
+    for( ; i + 4 <= width; i += 4 )
+    {
+      const Pel* s   = src + 2 * i;
+      __m128i    sum = _mm_add_epi32( voff, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) s ), vcr ) );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s - 1 ) ), vl ) );
+      if( twoRows )
+      {
+        sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s + srcStride ) ), vcr ) );
+        sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s + srcStride - 1 ) ), vl ) );
+      }
+      else if( upDown )
+      {
+        sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s - srcStride ) ), vl ) );
+        sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s + srcStride ) ), vl ) );
+      }
+      sum = _mm_srai_epi32( sum, shift );
+      _mm_storel_epi64( ( __m128i* ) ( dst + i ), _mm_packs_epi32( sum, sum ) );
+    }
+
+    if( i < width )
+    {
+      IntraPrediction::xDownsampleLuma( src + 2 * i, srcStride, dst + i, dstStride, width - i, 1, chFmt, collocated );
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+  m_downsampleLuma = simdDownsampleLuma<vext>;
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
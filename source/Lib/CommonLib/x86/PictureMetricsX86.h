@@ -0,0 +1,203 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the picture quality metric kernels
+ */
+
+#include "CommonDefX86.h"
+#include "../PictureMetrics.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+template<X86_VEXT vext>
+static uint64_t simdSSERow( const Pel* src0, const Pel* src1, const int width )
+{
+  int      x   = 0;
+  uint64_t sum = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    const __m256i vzero = _mm256_setzero_si256();
+    __m256i       vsum  = vzero;
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m256i vdiff = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( src0 + x ) ), _mm256_loadu_si256( ( const __m256i* ) ( src1 + x ) ) );
+      const __m256i vsq   = _mm256_madd_epi16( vdiff, vdiff );
+      vsum = _mm256_add_epi64( vsum, _mm256_unpacklo_epi32( vsq, vzero ) );
+      vsum = _mm256_add_epi64( vsum, _mm256_unpackhi_epi32( vsq, vzero ) );
+    }
+    const __m128i vsum128 = _mm_add_epi64( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+    sum = _mm_cvtsi128_si64( vsum128 ) + _mm_extract_epi64( vsum128, 1 );
+  }
+#endif
+
+  if( x + 8 <= width )
+  {
+    const __m128i vzero = _mm_setzero_si128();
+    __m128i       vsum  = vzero;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vdiff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) ( src0 + x ) ), _mm_loadu_si128( ( const __m128i* ) ( src1 + x ) ) );
+      const __m128i vsq   = _mm_madd_epi16( vdiff, vdiff );
+      vsum = _mm_add_epi64( vsum, _mm_unpacklo_epi32( vsq, vzero ) );
+      vsum = _mm_add_epi64( vsum, _mm_unpackhi_epi32( vsq, vzero ) );
+    }
+    sum += _mm_cvtsi128_si64( vsum ) + _mm_extract_epi64( vsum, 1 );
+  }
+
+  for( ; x < width; x++ )
+  {
+    const int diff = src0[x] - src1[x];
+    sum += uint64_t( diff * diff );
+  }
+  return sum;
+}
+
+// the squares and products are summed pairwise by madd (at most 2 * 32767^2, which fits into 32 bits)
+// and accumulated in 64 bits, so the statistics are exact for all sample bit depths
+template<X86_VEXT vext>
+static void simdSSIMStats4x4( const Pel* src0, const ptrdiff_t stride0, const Pel* src1, const ptrdiff_t stride1, int64_t* stats, const int numBlocks )
+{
+  int b = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vone  = _mm256_set1_epi16( 1 );
+    const __m256i vzero = _mm256_setzero_si256();
+    for( ; b + 4 <= numBlocks; b += 4 )
+    {
+      // 32 bit sums: lanes 0-1 block 0, 2-3 block 1, 4-5 block 2, 6-7 block 3
+      __m256i vs0 = vzero, vs1 = vzero;
+      // 64 bit sums: the even accumulators hold blocks 0 and 2, the odd ones blocks 1 and 3
+      __m256i vssE = vzero, vssO = vzero, vs01E = vzero, vs01O = vzero;
+      for( int y = 0; y < 4; y++ )
+      {
+        const __m256i va  = _mm256_loadu_si256( ( const __m256i* ) ( src0 + y * stride0 + ( b << 2 ) ) );
+        const __m256i vb  = _mm256_loadu_si256( ( const __m256i* ) ( src1 + y * stride1 + ( b << 2 ) ) );
+        const __m256i vaa = _mm256_madd_epi16( va, va );
+        const __m256i vbb = _mm256_madd_epi16( vb, vb );
+        const __m256i vab = _mm256_madd_epi16( va, vb );
+        vs0   = _mm256_add_epi32( vs0, _mm256_madd_epi16( va, vone ) );
+        vs1   = _mm256_add_epi32( vs1, _mm256_madd_epi16( vb, vone ) );
+        vssE  = _mm256_add_epi64( vssE,  _mm256_add_epi64( _mm256_unpacklo_epi32( vaa, vzero ), _mm256_unpacklo_epi32( vbb, vzero ) ) );
+        vssO  = _mm256_add_epi64( vssO,  _mm256_add_epi64( _mm256_unpackhi_epi32( vaa, vzero ), _mm256_unpackhi_epi32( vbb, vzero ) ) );
+        vs01E = _mm256_add_epi64( vs01E, _mm256_unpacklo_epi32( vab, vzero ) );
+        vs01O = _mm256_add_epi64( vs01O, _mm256_unpackhi_epi32( vab, vzero ) );
+      }
+      int32_t s0[8], s1[8];
+      int64_t ss[2][4], s01[2][4];
+      _mm256_storeu_si256( ( __m256i* ) s0,     vs0 );
+      _mm256_storeu_si256( ( __m256i* ) s1,     vs1 );
+      _mm256_storeu_si256( ( __m256i* ) ss[0],  vssE );
+      _mm256_storeu_si256( ( __m256i* ) ss[1],  vssO );
+      _mm256_storeu_si256( ( __m256i* ) s01[0], vs01E );
+      _mm256_storeu_si256( ( __m256i* ) s01[1], vs01O );
+      for( int k = 0; k < 4; k++ )
+      {
+        const int idx = ( k >> 1 ) << 1;   // position of the block in its accumulator
+        int64_t*  st  = stats + 4 * ( b + k );
+        st[0] = s0[2 * k] + s0[2 * k + 1];
+        st[1] = s1[2 * k] + s1[2 * k + 1];
+        st[2] = ss [k & 1][idx] + ss [k & 1][idx + 1];
+        st[3] = s01[k & 1][idx] + s01[k & 1][idx + 1];
+      }
+    }
+  }
+#endif
+
+  const __m128i vone  = _mm_set1_epi16( 1 );
+  const __m128i vzero = _mm_setzero_si128();
+  for( ; b + 2 <= numBlocks; b += 2 )
+  {
+    // 32 bit sums: lanes 0-1 block 0, 2-3 block 1; 64 bit sums: one accumulator per block
+    __m128i vs0 = vzero, vs1 = vzero;
+    __m128i vss0 = vzero, vss1 = vzero, vs010 = vzero, vs011 = vzero;
+    for( int y = 0; y < 4; y++ )
+    {
+      const __m128i va  = _mm_loadu_si128( ( const __m128i* ) ( src0 + y * stride0 + ( b << 2 ) ) );
+      const __m128i vb  = _mm_loadu_si128( ( const __m128i* ) ( src1 + y * stride1 + ( b << 2 ) ) );
+      const __m128i vaa = _mm_madd_epi16( va, va );
+      const __m128i vbb = _mm_madd_epi16( vb, vb );
+      const __m128i vab = _mm_madd_epi16( va, vb );
+      vs0   = _mm_add_epi32( vs0, _mm_madd_epi16( va, vone ) );
+      vs1   = _mm_add_epi32( vs1, _mm_madd_epi16( vb, vone ) );
+      vss0  = _mm_add_epi64( vss0,  _mm_add_epi64( _mm_unpacklo_epi32( vaa, vzero ), _mm_unpacklo_epi32( vbb, vzero ) ) );
+      vss1  = _mm_add_epi64( vss1,  _mm_add_epi64( _mm_unpackhi_epi32( vaa, vzero ), _mm_unpackhi_epi32( vbb, vzero ) ) );
+      vs010 = _mm_add_epi64( vs010, _mm_unpacklo_epi32( vab, vzero ) );
+      vs011 = _mm_add_epi64( vs011, _mm_unpackhi_epi32( vab, vzero ) );
+    }
+    vs0 = _mm_hadd_epi32( vs0, vs1 );   // [s0 s0' s1 s1']
+    vss0  = _mm_add_epi64( _mm_unpacklo_epi64( vss0,  vss1  ), _mm_unpackhi_epi64( vss0,  vss1  ) );
+    vs010 = _mm_add_epi64( _mm_unpacklo_epi64( vs010, vs011 ), _mm_unpackhi_epi64( vs010, vs011 ) );
+
+    int64_t* st = stats + 4 * b;
+    st[0] = _mm_extract_epi32( vs0, 0 );
+    st[1] = _mm_extract_epi32( vs0, 2 );
+    st[2] = _mm_cvtsi128_si64( vss0 );
+    st[3] = _mm_cvtsi128_si64( vs010 );
+    st[4] = _mm_extract_epi32( vs0, 1 );
+    st[5] = _mm_extract_epi32( vs0, 3 );
+    st[6] = _mm_extract_epi64( vss0, 1 );
+    st[7] = _mm_extract_epi64( vs010, 1 );
+  }
+
+  if( b < numBlocks )
+  {
+    PictureMetrics::xSSIMStats4x4( src0 + ( b << 2 ), stride0, src1 + ( b << 2 ), stride1, stats + 4 * b, numBlocks - b );
+  }
+}
+
+template <X86_VEXT vext>
+void PictureMetrics::_initPictureMetricsX86()
+{
+  m_sseRow       = simdSSERow<vext>;
+  m_ssimStats4x4 = simdSSIMStats4x4<vext>;
+}
+
+template void PictureMetrics::_initPictureMetricsX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -0,0 +1,232 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the quantisation and dequantisation kernels
+ */
+
+#include "CommonDefX86.h"
+#include "../Quant.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+template<X86_VEXT vext>
+static void simdDeQuantCoeffs( const TCoeff* src, TCoeff* dst, const int num, const int* scales, const int scale, const int rightShift, const Intermediate_Int inputMin, const Intermediate_Int inputMax, const TCoeff outputMin, const TCoeff outputMax )
+{
+  // the dequantisation ranges are chosen such that the products fit into Intermediate_Int, which is 32 bit with SIMD enabled
+  const int leftShift = rightShift > 0 ? 0 : -rightShift;
+  const int add       = rightShift > 0 ? 1 << ( rightShift - 1 ) : 0;
+  const int shift     = rightShift > 0 ? rightShift : 0;
+  int       n         = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vinMin  = _mm256_set1_epi32( inputMin );
+    const __m256i vinMax  = _mm256_set1_epi32( inputMax );
+    const __m256i voutMin = _mm256_set1_epi32( outputMin );
+    const __m256i voutMax = _mm256_set1_epi32( outputMax );
+    const __m256i vadd    = _mm256_set1_epi32( add );
+    const __m128i vshr    = _mm_cvtsi32_si128( shift );
+    const __m128i vshl    = _mm_cvtsi32_si128( leftShift );
+    __m256i       vscale  = _mm256_set1_epi32( scale );
+
+    for( ; n + 8 <= num; n += 8 )
+    {
+      if( scales )
+      {
+        vscale = _mm256_loadu_si256( ( const __m256i* ) ( scales + n ) );
+      }
+      __m256i vcoeff = _mm256_loadu_si256( ( const __m256i* ) ( src + n ) );
+      vcoeff = _mm256_min_epi32( vinMax, _mm256_max_epi32( vinMin, vcoeff ) );
+      vcoeff = _mm256_mullo_epi32( vcoeff, vscale );
+      vcoeff = _mm256_sll_epi32( _mm256_sra_epi32( _mm256_add_epi32( vcoeff, vadd ), vshr ), vshl );
+      vcoeff = _mm256_min_epi32( voutMax, _mm256_max_epi32( voutMin, vcoeff ) );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + n ), vcoeff );
+    }
+  }
+#endif
+
+  {
+    const __m128i vinMin  = _mm_set1_epi32( inputMin );
+    const __m128i vinMax  = _mm_set1_epi32( inputMax );
+    const __m128i voutMin = _mm_set1_epi32( outputMin );
+    const __m128i voutMax = _mm_set1_epi32( outputMax );
+    const __m128i vadd    = _mm_set1_epi32( add );
+    const __m128i vshr    = _mm_cvtsi32_si128( shift );
+    const __m128i vshl    = _mm_cvtsi32_si128( leftShift );
+    __m128i       vscale  = _mm_set1_epi32( scale );
+
+    for( ; n + 4 <= num; n += 4 )
+    {
+      if( scales )
+      {
+        vscale = _mm_loadu_si128( ( const __m128i* ) ( scales + n ) );
+      }
+      __m128i vcoeff = _mm_loadu_si128( ( const __m128i* ) ( src + n ) );
+      vcoeff = _mm_min_epi32( vinMax, _mm_max_epi32( vinMin, vcoeff ) );
+      vcoeff = _mm_mullo_epi32( vcoeff, vscale );
+      vcoeff = _mm_sll_epi32( _mm_sra_epi32( _mm_add_epi32( vcoeff, vadd ), vshr ), vshl );
+      vcoeff = _mm_min_epi32( voutMax, _mm_max_epi32( voutMin, vcoeff ) );
+      _mm_storeu_si128( ( __m128i* ) ( dst + n ), vcoeff );
+    }
+  }
+
+  if( n < num )
+  {
+    Quant::xDeQuantCoeffs( src + n, dst + n, num - n, scales ? scales + n : nullptr, scale, rightShift, inputMin, inputMax, outputMin, outputMax );
+  }
+}
+
+template<X86_VEXT vext>
+static TCoeff simdQuantCoeffs( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int num, const int* scales, const int scale, const int qBits, const int64_t add, const TCoeff outputMin, const TCoeff outputMax )
+{
+  // the rounding error (tmpLevel - (magnitude << qBits)) lies in ( -2^qBits, 2^qBits ) and is evaluated in 32 bit
+  if( qBits > 30 )
+  {
+    return Quant::xQuantCoeffs( src, dst, deltaU, num, scales, scale, qBits, add, outputMin, outputMax );
+  }
+
+  const __m128i vqBits  = _mm_cvtsi32_si128( qBits );
+  const __m128i vqBits8 = _mm_cvtsi32_si128( qBits - 8 );
+  TCoeff        absSum  = 0;
+  int           n       = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i voutMin = _mm256_set1_epi32( outputMin );
+    const __m256i voutMax = _mm256_set1_epi32( outputMax );
+    const __m256i vadd    = _mm256_set1_epi64x( add );
+    __m256i       vscale  = _mm256_set1_epi32( scale );
+    __m256i       vsum    = _mm256_setzero_si256();
+
+    for( ; n + 8 <= num; n += 8 )
+    {
+      if( scales )
+      {
+        vscale = _mm256_loadu_si256( ( const __m256i* ) ( scales + n ) );
+      }
+      const __m256i vlevel = _mm256_loadu_si256( ( const __m256i* ) ( src + n ) );
+      const __m256i vabs   = _mm256_abs_epi32( vlevel );
+      // 64 bit products of the even and the odd lanes
+      const __m256i vtmp0  = _mm256_mul_epu32( vabs, vscale );
+      const __m256i vtmp1  = _mm256_mul_epu32( _mm256_srli_epi64( vabs, 32 ), _mm256_srli_epi64( vscale, 32 ) );
+      const __m256i vmag0  = _mm256_srl_epi64( _mm256_add_epi64( vtmp0, vadd ), vqBits );
+      const __m256i vmag1  = _mm256_srl_epi64( _mm256_add_epi64( vtmp1, vadd ), vqBits );
+      const __m256i vrem0  = _mm256_sub_epi64( vtmp0, _mm256_sll_epi64( vmag0, vqBits ) );
+      const __m256i vrem1  = _mm256_sub_epi64( vtmp1, _mm256_sll_epi64( vmag1, vqBits ) );
+      const __m256i vmag   = _mm256_blend_epi16( vmag0, _mm256_slli_epi64( vmag1, 32 ), 0xCC );
+      const __m256i vrem   = _mm256_blend_epi16( vrem0, _mm256_slli_epi64( vrem1, 32 ), 0xCC );
+
+      _mm256_storeu_si256( ( __m256i* ) ( deltaU + n ), _mm256_sra_epi32( vrem, vqBits8 ) );
+      vsum = _mm256_add_epi32( vsum, vmag );
+
+      const __m256i vcoeff = _mm256_min_epi32( voutMax, _mm256_max_epi32( voutMin, _mm256_sign_epi32( vmag, vlevel ) ) );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + n ), vcoeff );
+    }
+
+    __m128i vsum128 = _mm_add_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+    vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+    vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+    absSum += _mm_cvtsi128_si32( vsum128 );
+  }
+#endif
+
+  if( n + 4 <= num )
+  {
+    const __m128i voutMin = _mm_set1_epi32( outputMin );
+    const __m128i voutMax = _mm_set1_epi32( outputMax );
+    const __m128i vadd    = _mm_set1_epi64x( add );
+    __m128i       vscale  = _mm_set1_epi32( scale );
+    __m128i       vsum    = _mm_setzero_si128();
+
+    for( ; n + 4 <= num; n += 4 )
+    {
+      if( scales )
+      {
+        vscale = _mm_loadu_si128( ( const __m128i* ) ( scales + n ) );
+      }
+      const __m128i vlevel = _mm_loadu_si128( ( const __m128i* ) ( src + n ) );
+      const __m128i vabs   = _mm_abs_epi32( vlevel );
+      // 64 bit products of the even and the odd lanes
+      const __m128i vtmp0  = _mm_mul_epu32( vabs, vscale );
+      const __m128i vtmp1  = _mm_mul_epu32( _mm_srli_epi64( vabs, 32 ), _mm_srli_epi64( vscale, 32 ) );
+      const __m128i vmag0  = _mm_srl_epi64( _mm_add_epi64( vtmp0, vadd ), vqBits );
+      const __m128i vmag1  = _mm_srl_epi64( _mm_add_epi64( vtmp1, vadd ), vqBits );
+      const __m128i vrem0  = _mm_sub_epi64( vtmp0, _mm_sll_epi64( vmag0, vqBits ) );
+      const __m128i vrem1  = _mm_sub_epi64( vtmp1, _mm_sll_epi64( vmag1, vqBits ) );
+      const __m128i vmag   = _mm_blend_epi16( vmag0, _mm_slli_epi64( vmag1, 32 ), 0xCC );
+      const __m128i vrem   = _mm_blend_epi16( vrem0, _mm_slli_epi64( vrem1, 32 ), 0xCC );
+
+      _mm_storeu_si128( ( __m128i* ) ( deltaU + n ), _mm_sra_epi32( vrem, vqBits8 ) );
+      vsum = _mm_add_epi32( vsum, vmag );
+
+      const __m128i vcoeff = _mm_min_epi32( voutMax, _mm_max_epi32( voutMin, _mm_sign_epi32( vmag, vlevel ) ) );
+      _mm_storeu_si128( ( __m128i* ) ( dst + n ), vcoeff );
+    }
+
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    absSum += _mm_cvtsi128_si32( vsum );
+  }
+
+  if( n < num )
+  {
+    absSum += Quant::xQuantCoeffs( src + n, dst + n, deltaU + n, num - n, scales ? scales + n : nullptr, scale, qBits, add, outputMin, outputMax );
+  }
+
+  return absSum;
+}
+
+template <X86_VEXT vext>
+void Quant::_initQuantX86()
+{
+  m_deQuantCoeffs = simdDeQuantCoeffs<vext>;
+  m_quantCoeffs   = simdQuantCoeffs<vext>;
+}
+
+template void Quant::_initQuantX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
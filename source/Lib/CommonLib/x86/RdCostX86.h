@@ -300,6 +300,73 @@ Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
   return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
 
+template< X86_VEXT vext >
+void RdCost::xGetDMVRSADs_SIMD( const Pel* pL0, const Pel* pL1, int stride, int width, int height, int bitDepth, Distortion* sads )
+{
+  if( bitDepth > 10 || ( width & 7 ) )
+  {
+    RdCost::xGetDMVRSADs( pL0, pL1, stride, width, height, bitDepth, sads );
+    return;
+  }
+
+  const int range     = DMVR_NUM_ITERATION;
+  const int rowStride = 2 * stride;
+
+  for( int ver = -range; ver <= range; ver++ )
+  {
+    for( int hor = -range; hor <= range; hor++ )
+    {
+      const short* pSrc1 = (const short*)( pL0 + hor + ver * stride );
+      const short* pSrc2 = (const short*)( pL1 - hor - ver * stride );
+      uint32_t uiSum = 0;
+
+#ifdef USE_AVX2
+      if( vext >= AVX2 && ( width & 15 ) == 0 )
+      {
+        const __m256i vone   = _mm256_set1_epi16( 1 );
+        __m256i       vsum32 = _mm256_setzero_si256();
+        for( int y = 0; y < height; y += 2 )
+        {
+          for( int x = 0; x < width; x += 16 )
+          {
+            __m256i vsrc1 = _mm256_lddqu_si256( ( __m256i* )( &pSrc1[x] ) );
+            __m256i vsrc2 = _mm256_lddqu_si256( ( __m256i* )( &pSrc2[x] ) );
+            vsum32 = _mm256_add_epi32( vsum32, _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( vsrc1, vsrc2 ) ), vone ) );
+          }
+          pSrc1 += rowStride;
+          pSrc2 += rowStride;
+        }
+        __m128i vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum32 ), _mm256_extracti128_si256( vsum32, 1 ) );
+        vsum  = _mm_hadd_epi32( vsum, vsum );
+        vsum  = _mm_hadd_epi32( vsum, vsum );
+        uiSum = _mm_cvtsi128_si32( vsum );
+      }
+      else
+#endif
+      {
+        const __m128i vone   = _mm_set1_epi16( 1 );
+        __m128i       vsum32 = _mm_setzero_si128();
+        for( int y = 0; y < height; y += 2 )
+        {
+          for( int x = 0; x < width; x += 8 )
+          {
+            __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* )( &pSrc1[x] ) );
+            __m128i vsrc2 = _mm_loadu_si128( ( const __m128i* )( &pSrc2[x] ) );
+            vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( vsrc1, vsrc2 ) ), vone ) );
+          }
+          pSrc1 += rowStride;
+          pSrc2 += rowStride;
+        }
+        vsum32 = _mm_hadd_epi32( vsum32, vsum32 );
+        vsum32 = _mm_hadd_epi32( vsum32, vsum32 );
+        uiSum  = _mm_cvtsi128_si32( vsum32 );
+      }
+
+      *sads++ = ( Distortion( uiSum ) << 1 ) >> DISTORTION_PRECISION_ADJUSTMENT( bitDepth );
+    }
+  }
+}
+
 template< X86_VEXT vext >
 Distortion RdCost::xGetSAD_IBD_SIMD(const DistParam &rcDtParam)
 {
@@ -2150,6 +2217,8 @@ void RdCost::_initRdCostX86()
   m_afpDistortFunc[DF_HAD16N]  = RdCost::xGetHADs_SIMD<vext>;
 
   m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD_IBD_SIMD<vext>;
+
+  m_fpDMVRSADs = RdCost::xGetDMVRSADs_SIMD<vext>;
 }
 
 template void RdCost::_initRdCostX86<SIMDX86>();
@@ -0,0 +1,160 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the low-frequency non-separable transform kernels
+ */
+
+#include "CommonDefX86.h"
+#include "../TrQuant.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// the LFNST matrices are stored row-major as int8, the forward kernel takes the dot product of the input with four rows,
+// the inverse kernel accumulates rows scaled by the broadcast input, both widen the matrix entries to 32 bit on load
+// such that the products are computed in the same precision as in the scalar code
+
+template<X86_VEXT vext>
+static void simdFwdLfnstMatMul( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize )
+{
+  const __m128i vadd = _mm_set1_epi32( 64 );
+
+  for( int j = 0; j < zeroOutSize; j += 4, trMat += 4 * trSize )
+  {
+    __m128i vsum;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      __m256i vacc[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+      for( int i = 0; i < trSize; i += 8 )
+      {
+        const __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) ( src + i ) );
+        for( int k = 0; k < 4; k++ )
+        {
+          const __m256i vmat = _mm256_cvtepi8_epi32( _mm_loadl_epi64( ( const __m128i* ) ( trMat + k * trSize + i ) ) );
+          vacc[k] = _mm256_add_epi32( vacc[k], _mm256_mullo_epi32( vsrc, vmat ) );
+        }
+      }
+      const __m256i vhadd = _mm256_hadd_epi32( _mm256_hadd_epi32( vacc[0], vacc[1] ), _mm256_hadd_epi32( vacc[2], vacc[3] ) );
+      vsum = _mm_add_epi32( _mm256_castsi256_si128( vhadd ), _mm256_extracti128_si256( vhadd, 1 ) );
+    }
+    else
+#endif
+    {
+      __m128i vacc[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+      for( int i = 0; i < trSize; i += 4 )
+      {
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) ( src + i ) );
+        for( int k = 0; k < 4; k++ )
+        {
+          const __m128i vmat = _mm_cvtepi8_epi32( _mm_cvtsi32_si128( *( const int32_t* ) ( trMat + k * trSize + i ) ) );
+          vacc[k] = _mm_add_epi32( vacc[k], _mm_mullo_epi32( vsrc, vmat ) );
+        }
+      }
+      vsum = _mm_hadd_epi32( _mm_hadd_epi32( vacc[0], vacc[1] ), _mm_hadd_epi32( vacc[2], vacc[3] ) );
+    }
+    _mm_storeu_si128( ( __m128i* ) ( dst + j ), _mm_srai_epi32( _mm_add_epi32( vsum, vadd ), 7 ) );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdInvLfnstMatMul( const int* src, int* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const int outputMin, const int outputMax )
+{
+  for( int j = 0; j < trSize; j += 16 )
+  {
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vadd = _mm256_set1_epi32( 64 );
+      const __m256i vmin = _mm256_set1_epi32( outputMin );
+      const __m256i vmax = _mm256_set1_epi32( outputMax );
+      __m256i       vacc0 = _mm256_setzero_si256();
+      __m256i       vacc1 = _mm256_setzero_si256();
+      for( int i = 0; i < zeroOutSize; i++ )
+      {
+        const __m256i vsrc = _mm256_set1_epi32( src[i] );
+        const __m128i vmat = _mm_loadu_si128( ( const __m128i* ) ( trMat + i * trSize + j ) );
+        vacc0 = _mm256_add_epi32( vacc0, _mm256_mullo_epi32( vsrc, _mm256_cvtepi8_epi32( vmat ) ) );
+        vacc1 = _mm256_add_epi32( vacc1, _mm256_mullo_epi32( vsrc, _mm256_cvtepi8_epi32( _mm_srli_si128( vmat, 8 ) ) ) );
+      }
+      vacc0 = _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, _mm256_srai_epi32( _mm256_add_epi32( vacc0, vadd ), 7 ) ) );
+      vacc1 = _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, _mm256_srai_epi32( _mm256_add_epi32( vacc1, vadd ), 7 ) ) );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + j ),     vacc0 );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + j + 8 ), vacc1 );
+    }
+    else
+#endif
+    {
+      const __m128i vadd = _mm_set1_epi32( 64 );
+      const __m128i vmin = _mm_set1_epi32( outputMin );
+      const __m128i vmax = _mm_set1_epi32( outputMax );
+      __m128i       vacc[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+      for( int i = 0; i < zeroOutSize; i++ )
+      {
+        const __m128i vsrc = _mm_set1_epi32( src[i] );
+        const __m128i vmat = _mm_loadu_si128( ( const __m128i* ) ( trMat + i * trSize + j ) );
+        vacc[0] = _mm_add_epi32( vacc[0], _mm_mullo_epi32( vsrc, _mm_cvtepi8_epi32( vmat ) ) );
+        vacc[1] = _mm_add_epi32( vacc[1], _mm_mullo_epi32( vsrc, _mm_cvtepi8_epi32( _mm_srli_si128( vmat, 4 ) ) ) );
+        vacc[2] = _mm_add_epi32( vacc[2], _mm_mullo_epi32( vsrc, _mm_cvtepi8_epi32( _mm_srli_si128( vmat, 8 ) ) ) );
+        vacc[3] = _mm_add_epi32( vacc[3], _mm_mullo_epi32( vsrc, _mm_cvtepi8_epi32( _mm_srli_si128( vmat, 12 ) ) ) );
+      }
+      for( int k = 0; k < 4; k++ )
+      {
+        const __m128i vres = _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_srai_epi32( _mm_add_epi32( vacc[k], vadd ), 7 ) ) );
+        _mm_storeu_si128( ( __m128i* ) ( dst + j + 4 * k ), vres );
+      }
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+  m_fwdLfnstMatMul = simdFwdLfnstMatMul<vext>;
+  m_invLfnstMatMul = simdInvLfnstMatMul<vext>;
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
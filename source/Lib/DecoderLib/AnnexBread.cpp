@@ -38,6 +38,9 @@
 
 
 #include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
 #include <vector>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -49,6 +52,87 @@ using namespace std;
 //! \ingroup DecoderLib
 //! \{
 
+const uint8_t* findAnnexBDelimiter(const uint8_t* begin, const uint8_t* end)
+{
+  const uint8_t* p = begin;
+  while (end - p >= 3)
+  {
+    // every delimiter starts with a zero byte, let memchr skip the (vectorised) rest
+    p = (const uint8_t*) memchr(p, 0, end - p - 2);
+    if (p == NULL)
+    {
+      return end;
+    }
+    if (p[1] != 0)
+    {
+      p += 2;
+    }
+    else if (p[2] <= 2)
+    {
+      return p;
+    }
+    else
+    {
+      p += 3;
+    }
+  }
+  return end;
+}
+
+bool InputByteStream::readUntilDelimiter(std::vector<uint8_t>& data)
+{
+  const size_t startPos = data.size();
+
+  // bytes that have already been peeked come first
+  while (m_NumFutureBytes)
+  {
+    data.push_back(readByte());
+  }
+
+  std::streambuf* buf = m_Input.rdbuf();
+  size_t scanPos  = startPos;
+  size_t blockPos = data.size();
+  size_t delimPos = std::string::npos;
+
+  for (;;)
+  {
+    const uint8_t* begin = data.data();
+    const uint8_t* end   = begin + data.size();
+    const uint8_t* delim = findAnnexBDelimiter(begin + scanPos, end);
+    if (delim != end)
+    {
+      delimPos = delim - begin;
+      break;
+    }
+    // a delimiter may straddle two blocks
+    scanPos = std::max(startPos, data.size() - std::min<size_t>(data.size(), 2));
+
+    // only take what is in the get area, so that the last block can be put back
+    if (buf->sgetc() == std::char_traits<char>::eof())
+    {
+      return false;
+    }
+    const std::streamsize avail = std::max<std::streamsize>(buf->in_avail(), 1);
+    blockPos = data.size();
+    data.resize(blockPos + size_t(avail));
+    const std::streamsize read = buf->sgetn((char*) data.data() + blockPos, avail);
+    data.resize(blockPos + size_t(read));
+  }
+
+  // return the bytes following the delimiter position to the stream
+  for (size_t pos = data.size(); pos > std::max(delimPos, blockPos); pos--)
+  {
+    buf->sungetc();
+  }
+  for (size_t pos = delimPos; pos < blockPos; pos++)
+  {
+    m_FutureBytes = (m_FutureBytes << 8) | data[pos];
+    m_NumFutureBytes++;
+  }
+  data.resize(delimPos);
+  return true;
+}
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
@@ -145,6 +229,15 @@ _byteStreamNALUnit(
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::SStat &bodyStats=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
 #endif
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  const size_t bodyStart = nalUnit.size();
+  bs.readUntilDelimiter(nalUnit);
+  bodyStats.bits  += 8 * uint32_t(nalUnit.size() - bodyStart);
+  bodyStats.count += uint32_t(nalUnit.size() - bodyStart);
+#else
+  bs.readUntilDelimiter(nalUnit);
+#endif
+  // only remaining at the end of the stream
   while (bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) > 2)
   {
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
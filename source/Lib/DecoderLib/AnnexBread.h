@@ -160,6 +160,17 @@ public:
     return val;
   }
 
+  /**
+   * consume bytes up to, but not including, the next byte-aligned
+   * three-byte sequence 0x000000, 0x000001 or 0x000002 and append them
+   * to data. The bytes are taken block-wise from the stream buffer
+   * instead of one at a time.
+   *
+   * Returns false if the end of the stream was reached before such a
+   * sequence was found; all remaining bytes have been appended then.
+   */
+  bool readUntilDelimiter(std::vector<uint8_t>& data);
+
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   uint32_t GetNumBufferedBytes() const { return m_NumFutureBytes; }
 #endif
@@ -192,6 +203,12 @@ struct AnnexBStats
   }
 };
 
+/**
+ * Return the first byte-aligned three-byte sequence 0x000000, 0x000001 or
+ * 0x000002 in [begin, end), or end if there is none.
+ */
+const uint8_t* findAnnexBDelimiter(const uint8_t* begin, const uint8_t* end);
+
 bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
 //! \}
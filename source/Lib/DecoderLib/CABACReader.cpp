@@ -3619,7 +3619,15 @@ void CABACReader::residual_coding( TransformUnit& tu, ComponentID compID )
           continue;
         }
       }
-      residual_coding_subblock( cctx, coeff, stateTransTab, state );
+      // subblocks away from the right and bottom block boundary derive their contexts without neighbour bound checks
+      if( cctx.isInnerSubblock() )
+      {
+        residual_coding_subblock<false>( cctx, coeff, stateTransTab, state );
+      }
+      else
+      {
+        residual_coding_subblock<true>( cctx, coeff, stateTransTab, state );
+      }
     }
 
 }
@@ -3916,6 +3924,7 @@ int CABACReader::last_sig_coeff( CoeffCodingContext& cctx, TransformUnit& tu, Co
 
 
 
+template<bool checkBounds>
 void CABACReader::residual_coding_subblock( CoeffCodingContext& cctx, TCoeff* coeff, const int stateTransTable, int& state )
 {
   // NOTE: All coefficients of the subblock must be set to zero before calling this function
@@ -3973,14 +3982,14 @@ void CABACReader::residual_coding_subblock( CoeffCodingContext& cctx, TCoeff* co
     if( !sigFlag )
     {
       RExt__DECODER_DEBUG_BIT_STATISTICS_SET( ctype_map );
-      const unsigned sigCtxId = cctx.sigCtxIdAbs( nextSigPos, coeff, state );
+      const unsigned sigCtxId = cctx.sigCtxIdAbs<checkBounds>( nextSigPos, coeff, state );
       sigFlag = m_BinDecoder.decodeBin( sigCtxId );
       DTRACE( g_trace_ctx, D_SYNTAX_RESI, "sig_bin() bin=%d ctx=%d\n", sigFlag, sigCtxId );
       remRegBins--;
     }
     else if( nextSigPos != cctx.scanPosLast() )
     {
-      cctx.sigCtxIdAbs( nextSigPos, coeff, state ); // required for setting variables that are needed for gtx/par context selection
+      cctx.sigCtxIdAbs<checkBounds>( nextSigPos, coeff, state ); // required for setting variables that are needed for gtx/par context selection
     }
 
     if( sigFlag )
@@ -4025,7 +4034,7 @@ void CABACReader::residual_coding_subblock( CoeffCodingContext& cctx, TCoeff* co
   unsigned ricePar = 0;
   for( int scanPos = firstSigPos; scanPos > firstPosMode2; scanPos-- )
   {
-    int       sumAll = cctx.templateAbsSum(scanPos, coeff, 4);
+    int       sumAll = cctx.templateAbsSum<checkBounds>(scanPos, coeff, 4);
     ricePar = g_auiGoRiceParsCoeff[sumAll];
     TCoeff& tcoeff = coeff[ cctx.blockPos( scanPos ) ];
     if( tcoeff >= 4 )
@@ -4040,7 +4049,7 @@ void CABACReader::residual_coding_subblock( CoeffCodingContext& cctx, TCoeff* co
   //===== coeff bypass ====
   for( int scanPos = firstPosMode2; scanPos >= minSubPos; scanPos-- )
   {
-    int       sumAll = cctx.templateAbsSum(scanPos, coeff, 0);
+    int       sumAll = cctx.templateAbsSum<checkBounds>(scanPos, coeff, 0);
     int       rice      = g_auiGoRiceParsCoeff                        [sumAll];
     int       pos0      = g_auiGoRicePosCoeff0[std::max(0, state - 1)][sumAll];
     RExt__DECODER_DEBUG_BIT_STATISTICS_SET(ctype_escs);
@@ -42,6 +42,7 @@
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/Buffer.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <fstream>
 #include <stdio.h>
@@ -421,6 +422,9 @@ DecLib::DecLib()
   , m_prefixSEINALUs()
   , m_debugPOC( -1 )
   , m_debugCTU( -1 )
+#if JVET_O1164_RPR
+  , m_rescaleThreads( 1 )
+#endif
 {
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
@@ -512,6 +516,10 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
   for(auto * p: m_cListPic)
   {
     pcPic = p;  // workaround because range-based for-loops don't work with existing variables
+    if( pcPic->outputRefCount > 0 )
+    {
+      continue;
+    }
     if ( pcPic->reconstructed == false && ! pcPic->neededForOutput )
     {
       pcPic->neededForOutput = false;
@@ -568,6 +576,22 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
 }
 
 
+/** whether the borders of the picture are extended right after the in-loop filters, while the samples are in the cache.
+    Pictures which are not expected to be referenced are only extended when they are actually used as a reference
+    (reference picture list construction), as no picture is kept for reference or they are in the highest temporal
+    sub-layer of a hierarchical GOP.
+ */
+static bool isExpectedReference( const Slice& slice )
+{
+  const SPS*     sps = slice.getSPS();
+  const uint32_t tid = slice.getTLayer();
+  if( sps->getMaxDecPicBuffering( tid ) <= 1 )
+  {
+    return false;
+  }
+  return tid == 0 || tid + 1 < sps->getMaxTLayers();
+}
+
 void DecLib::executeLoopFilters()
 {
   if( !m_pcPic )
@@ -577,18 +601,20 @@ void DecLib::executeLoopFilters()
 
   m_pcPic->cs->slice->startProcessingTimer();
 
-  CodingStructure& cs = *m_pcPic->cs;
+  CodingStructure& cs              = *m_pcPic->cs;
+  const bool       extendPicBorder = isExpectedReference( *cs.slice );
 
   if (cs.sps->getUseReshaper() && m_cReshaper.getSliceReshaperInfo().getUseSliceReshaper())
   {
       CHECK((m_cReshaper.getRecReshaped() == false), "Rec picture is not reshaped!");
-      m_pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
+      m_pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_cReshaper.getInvMapping());
       m_cReshaper.setRecReshaped(false);
       m_cSAO.setReshaper(&m_cReshaper);
   }
   // deblocking filter
   m_cLoopFilter.loopFilterPic( cs );
   CS::setRefinedMotionField(cs);
+  cs.storeColMotionField();
   if( cs.sps->getSAOEnabledFlag() )
   {
     m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
@@ -601,12 +627,20 @@ void DecLib::executeLoopFilters()
       // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
       // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
       // copy in case the APS gets used more than once.
-      m_cALF.ALFProcess(cs);
+      m_cALF.ALFProcess(cs, extendPicBorder);
     }
 
   }
 
+  if( extendPicBorder )
+  {
+    // make the picture ready for use as a reference, ALF already extends the borders CTU row by CTU row when applied
+    m_pcPic->extendPicBorder();
+  }
+
   m_pcPic->cs->slice->stopProcessingTimer();
+
+  g_stageProfiler.finishPicture( m_pcPic->getPOC() );
 }
 
 void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
@@ -1552,9 +1586,9 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
 
 #if JVET_O1164_RPR
 #if JVET_O0299_APS_SCALINGLIST
-  pcSlice->scaleRefPicList( scaledRefPic, m_parameterSetManager.getAPSs(), pcSlice->getLmcsAPS(), pcSlice->getscalingListAPS(), true );
+  pcSlice->scaleRefPicList( scaledRefPic, m_parameterSetManager.getAPSs(), pcSlice->getLmcsAPS(), pcSlice->getscalingListAPS(), true, m_rescaleThreads );
 #else
-  pcSlice->scaleRefPicList( scaledRefPic, m_parameterSetManager.getAPSs(), pcSlice->getLmcsAPS(), true );
+  pcSlice->scaleRefPicList( scaledRefPic, m_parameterSetManager.getAPSs(), pcSlice->getLmcsAPS(), true, m_rescaleThreads );
 #endif
 #endif
 
@@ -135,6 +135,9 @@ private:
   std::list<InputNALUnit*> m_prefixSEINALUs; /// Buffered up prefix SEI NAL Units.
   int                     m_debugPOC;
   int                     m_debugCTU;
+#if JVET_O1164_RPR
+  int                     m_rescaleThreads;         ///< number of threads used to resample the reference pictures
+#endif
 
 #if JVET_O0245_VPS_DPS_APS
   std::vector<std::pair<NalUnitType, int>> m_accessUnitNals;
@@ -149,6 +152,9 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+#if JVET_O1164_RPR
+  void  setRescaleThreads( int numThreads )          { m_rescaleThreads = numThreads; }
+#endif
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -38,6 +38,7 @@
 #include "DecSlice.h"
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_next.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <vector>
 
@@ -222,7 +223,10 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
       isLastCtuOfSliceSegment = true; // get out here
       break;
     }
-    isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    {
+      PROFILE_STAGE( PROF_STAGE_PARSE );
+      isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    }
 
     m_pcCuDecoder->decompressCtu( cs, ctuArea );
 
@@ -0,0 +1,601 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DecStream.cpp
+    \brief    decoder library interface for embedding applications
+*/
+
+#include "DecStream.h"
+#include "DecStreamC.h"
+#include "AnnexBread.h"
+#include "NALread.h"
+
+#include "CommonLib/Rom.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+//! \ingroup DecoderLib
+//! \{
+
+static std::mutex s_romMutex;
+static int        s_romUsers = 0;
+
+/// decoder and picture buffers of a stream, shared between the stream and its output pictures.
+/// The decoder and the ROM are only destroyed when the stream and all of its output pictures have been released.
+struct DecStreamPool
+{
+  DecLib decLib;
+
+  DecStreamPool();
+  ~DecStreamPool();
+};
+
+DecStreamPool::DecStreamPool()
+{
+  {
+    std::lock_guard<std::mutex> lock( s_romMutex );
+    if( s_romUsers++ == 0 )
+    {
+      initROM();
+    }
+  }
+
+  decLib.create();
+  decLib.init(
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+    std::string()
+#endif
+  );
+}
+
+DecStreamPool::~DecStreamPool()
+{
+  decLib.deletePicBuffer();
+  decLib.destroy();
+
+  std::lock_guard<std::mutex> lock( s_romMutex );
+  if( --s_romUsers == 0 )
+  {
+    destroyROM();
+  }
+}
+
+// ====================================================================================================================
+// DecStreamPicture
+// ====================================================================================================================
+
+DecStreamPicture::DecStreamPicture( Picture* pic, const std::shared_ptr<DecStreamPool>& pool )
+  : m_pic       ( pic )
+  , m_poc       ( pic->getPOC() )
+  , m_temporalId( pic->slices[0]->getTLayer() )
+  , m_pool      ( pool )
+{
+  // the parameter sets may be replaced while the application holds the picture, keep what is needed
+  const SPS* sps = pic->cs->sps;
+#if JVET_O1164_PS
+  m_confWindow   = pic->cs->pps->getConformanceWindow();
+#else
+  m_confWindow   = sps->getConformanceWindow();
+#endif
+  m_chromaFormat = sps->getChromaFormatIdc();
+  m_bitDepths    = sps->getBitDepths();
+
+  const int         left   = m_confWindow.getWindowLeftOffset()   * SPS::getWinUnitX( m_chromaFormat );
+  const int         right  = m_confWindow.getWindowRightOffset()  * SPS::getWinUnitX( m_chromaFormat );
+  const int         top    = m_confWindow.getWindowTopOffset()    * SPS::getWinUnitY( m_chromaFormat );
+  const int         bottom = m_confWindow.getWindowBottomOffset() * SPS::getWinUnitY( m_chromaFormat );
+  const CPelUnitBuf reco   = pic->getRecoBuf();
+
+  m_buf = reco.subBuf( UnitArea( m_chromaFormat, Area( left, top, reco.Y().width - left - right, reco.Y().height - top - bottom ) ) );
+}
+
+void DecStreamPicture::xRelease( DecStreamPicture* pic )
+{
+  pic->m_pic->outputRefCount--;
+  // releasing the last reference to the pool of a destroyed stream destroys the decoder
+  delete pic;
+}
+
+// ====================================================================================================================
+// DecStream
+// ====================================================================================================================
+
+DecStream::DecStream()
+  : m_created       ( false )
+  , m_pcListPic     ( nullptr )
+  , m_pocLastDisplay( -MAX_INT )
+  , m_skipFrames    ( 0 )
+  , m_loopFiltered  ( false )
+  , m_nalStart      ( std::string::npos )
+  , m_scanPos       ( 0 )
+{
+}
+
+DecStream::~DecStream()
+{
+  destroy();
+}
+
+void DecStream::create( const DecStreamParams& params )
+{
+  CHECK( m_created, "Decoder stream already created" );
+
+  m_params = params;
+  m_pool   = std::make_shared<DecStreamPool>();
+
+  m_pool->decLib.setDecodedPictureHashSEIEnabled( m_params.decodedPictureHashSEIEnabled );
+  m_pool->decLib.setTargetDecLayer( m_params.targetLayer );
+
+  m_pcListPic      = nullptr;
+  m_pocLastDisplay = -MAX_INT;
+  m_skipFrames     = 0;
+  m_loopFiltered   = false;
+  m_nalStart       = std::string::npos;
+  m_scanPos        = 0;
+  m_byteStream.clear();
+  m_created        = true;
+}
+
+void DecStream::destroy()
+{
+  if( !m_created )
+  {
+    return;
+  }
+
+  for( auto pic : m_outputQueue )
+  {
+    pic->outputRefCount--;
+  }
+  m_outputQueue.clear();
+
+  // pictures still held by the application keep the decoder alive until they are released
+  m_pool.reset();
+
+  m_byteStream.clear();
+  m_pcListPic = nullptr;
+  m_created   = false;
+}
+
+static inline size_t xFindStartCode( const std::vector<uint8_t>& buf, size_t pos )
+{
+  const uint8_t* end = buf.data() + buf.size();
+  const uint8_t* p   = buf.data() + pos;
+  while( ( p = findAnnexBDelimiter( p, end ) ) != end )
+  {
+    if( p[2] == 1 )
+    {
+      return p - buf.data();
+    }
+    p++;
+  }
+  return std::string::npos;
+}
+
+void DecStream::pushData( const uint8_t* data, size_t size )
+{
+  CHECK( !m_created, "Decoder stream not created" );
+
+  m_byteStream.insert( m_byteStream.end(), data, data + size );
+
+  if( m_nalStart == std::string::npos )
+  {
+    // skip leading_zero_8bits up to the first start code
+    const size_t startCode = xFindStartCode( m_byteStream, 0 );
+    if( startCode == std::string::npos )
+    {
+      m_byteStream.erase( m_byteStream.begin(), m_byteStream.end() - std::min<size_t>( m_byteStream.size(), 2 ) );
+      return;
+    }
+    m_nalStart = m_scanPos = startCode + 3;
+  }
+
+  size_t startCode;
+  while( ( startCode = xFindStartCode( m_byteStream, m_scanPos ) ) != std::string::npos )
+  {
+    // trailing_zero_8bits and the zero_byte of the next start code are not part of the NAL unit
+    size_t nalEnd = startCode;
+    while( nalEnd > m_nalStart && m_byteStream[nalEnd - 1] == 0 )
+    {
+      nalEnd--;
+    }
+    xDecode( m_byteStream.data() + m_nalStart, nalEnd - m_nalStart, false );
+    m_nalStart = m_scanPos = startCode + 3;
+  }
+
+  // a start code may be split across two calls
+  m_scanPos = std::max( m_nalStart, m_byteStream.size() - std::min<size_t>( m_byteStream.size(), 2 ) );
+
+  m_byteStream.erase( m_byteStream.begin(), m_byteStream.begin() + m_nalStart );
+  m_scanPos -= m_nalStart;
+  m_nalStart = 0;
+}
+
+void DecStream::pushNalUnit( const uint8_t* data, size_t size )
+{
+  CHECK( !m_created, "Decoder stream not created" );
+
+  xDecode( data, size, false );
+}
+
+void DecStream::flush()
+{
+  CHECK( !m_created, "Decoder stream not created" );
+
+  if( m_nalStart != std::string::npos )
+  {
+    size_t nalEnd = m_byteStream.size();
+    while( nalEnd > m_nalStart && m_byteStream[nalEnd - 1] == 0 )
+    {
+      nalEnd--;
+    }
+    xDecode( m_byteStream.data() + m_nalStart, nalEnd - m_nalStart, true );
+  }
+  m_byteStream.clear();
+  m_nalStart = std::string::npos;
+  m_scanPos  = 0;
+
+  if( !m_pool->decLib.getFirstSliceInSequence() && !m_loopFiltered )
+  {
+    xFinishPicture();
+  }
+  else if( m_pool->decLib.getFirstSliceInSequence() )
+  {
+    m_pool->decLib.setFirstSliceInPicture( true );
+  }
+  m_loopFiltered = true;
+
+  xFlushOutput();
+}
+
+uint32_t DecStream::getNumberOfChecksumErrorsDetected() const
+{
+  return m_pool ? m_pool->decLib.getNumberOfChecksumErrorsDetected() : 0;
+}
+
+DecStreamPicturePtr DecStream::getPicture()
+{
+  if( m_outputQueue.empty() )
+  {
+    return DecStreamPicturePtr();
+  }
+
+  Picture* pic = m_outputQueue.front();
+  m_outputQueue.pop_front();
+
+  // the reference taken in xOutputPicture is handed over to the returned picture
+  return DecStreamPicturePtr( new DecStreamPicture( pic, m_pool ), DecStreamPicture::xRelease );
+}
+
+void DecStream::xDecode( const uint8_t* data, size_t size, bool endOfStream )
+{
+  if( size == 0 )
+  {
+    msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n" );
+    return;
+  }
+
+  bool newPicture = false;
+  do
+  {
+    // the first NAL unit of a picture is passed again after the previous picture has been finished
+    InputNALUnit nalu;
+    nalu.getBitstream().getFifo().assign( data, data + size );
+    read( nalu );
+
+    newPicture = xDecodeNalUnit( nalu, endOfStream );
+  }
+  while( newPicture );
+}
+
+bool DecStream::xDecodeNalUnit( InputNALUnit& nalu, bool endOfStream )
+{
+  const bool isEos      = nalu.m_nalUnitType == NAL_UNIT_EOS;
+  bool       newPicture = false;
+
+#if JVET_O0610_DETECT_AUD
+  if( m_pool->decLib.getFirstSliceInPicture() && ( nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP ) )
+  {
+    xFlushOutput();
+  }
+#endif
+
+  if( xIsNaluToBeDecoded( nalu ) )
+  {
+    newPicture = m_pool->decLib.decode( nalu, m_skipFrames, m_pocLastDisplay );
+#if JVET_O0610_DETECT_AUD
+    if( newPicture && nalu.m_nalUnitType != NAL_UNIT_ACCESS_UNIT_DELIMITER )
+    {
+      msg( ERROR, "Error: New picture detected without access unit delimiter. VVC requires the presence of access unit delimiters.\n" );
+    }
+#endif
+  }
+
+  if( ( newPicture || endOfStream || isEos ) && !m_pool->decLib.getFirstSliceInSequence() )
+  {
+    if( !m_loopFiltered || !endOfStream )
+    {
+      xFinishPicture();
+    }
+    m_loopFiltered = isEos || endOfStream;
+    if( isEos )
+    {
+      m_pool->decLib.setFirstSliceInSequence( true );
+    }
+  }
+  else if( ( newPicture || endOfStream || isEos ) && m_pool->decLib.getFirstSliceInSequence() )
+  {
+    m_pool->decLib.setFirstSliceInPicture( true );
+  }
+
+  if( m_pcListPic )
+  {
+    if( newPicture )
+    {
+      xWriteOutput();
+    }
+    if( isEos )
+    {
+      xWriteOutput();
+      m_pool->decLib.setFirstSliceInPicture( false );
+    }
+    // additional bumping as defined in C.5.2.3
+#if JVET_N0865_GRA2GDR
+    if( !newPicture && ( ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL_15 )
+      || ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalu.m_nalUnitType <= NAL_UNIT_CODED_SLICE_GDR ) ) )
+#else
+    if( !newPicture && ( ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL_15 )
+      || ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalu.m_nalUnitType <= NAL_UNIT_CODED_SLICE_GRA ) ) )
+#endif
+    {
+      xWriteOutput();
+    }
+  }
+
+  return newPicture;
+}
+
+bool DecStream::xIsNaluToBeDecoded( const InputNALUnit& nalu ) const
+{
+  if( m_params.maxTemporalLayer >= 0 && nalu.m_temporalId > m_params.maxTemporalLayer )
+  {
+    return false;
+  }
+  return m_params.targetLayer < 0 || nalu.m_nuhLayerId == m_params.targetLayer;
+}
+
+void DecStream::xFinishPicture()
+{
+  int poc;
+  m_pool->decLib.executeLoopFilters();
+  m_pool->decLib.finishPicture( poc, m_pcListPic, m_params.pictureInfoLevel );
+}
+
+void DecStream::xWriteOutput()
+{
+  if( !m_pcListPic || m_pcListPic->empty() )
+  {
+    return;
+  }
+
+  const SPS*     activeSPS      = m_pcListPic->front()->cs->sps;
+  const int      maxNrSublayers = activeSPS->getMaxTLayers();
+  const int      highestTid     = m_params.maxTemporalLayer == -1 || m_params.maxTemporalLayer >= maxNrSublayers ? maxNrSublayers - 1 : m_params.maxTemporalLayer;
+  const int      numReorderPics = activeSPS->getNumReorderPics( highestTid );
+  const int      maxDecPicBuf   = activeSPS->getMaxDecPicBuffering( highestTid );
+  int            numPicsNotYetDisplayed = 0;
+  int            dpbFullness            = 0;
+
+  for( auto pic : *m_pcListPic )
+  {
+    if( pic->neededForOutput && pic->getPOC() > m_pocLastDisplay )
+    {
+      numPicsNotYetDisplayed++;
+      dpbFullness++;
+    }
+    else if( pic->referenced )
+    {
+      dpbFullness++;
+    }
+  }
+
+  // fields are returned as separate pictures
+  for( auto pic : *m_pcListPic )
+  {
+    if( pic->neededForOutput && pic->getPOC() > m_pocLastDisplay && ( numPicsNotYetDisplayed > numReorderPics || dpbFullness > maxDecPicBuf ) )
+    {
+      numPicsNotYetDisplayed--;
+      if( !pic->referenced )
+      {
+        dpbFullness--;
+      }
+      xOutputPicture( pic );
+    }
+  }
+}
+
+void DecStream::xFlushOutput()
+{
+  if( !m_pcListPic )
+  {
+    return;
+  }
+
+  for( auto pic : *m_pcListPic )
+  {
+    if( pic->neededForOutput )
+    {
+      xOutputPicture( pic );
+    }
+    // instead of deleting the pictures they are kept as free buffers
+    pic->referenced    = false;
+    pic->reconstructed = false;
+  }
+  m_pocLastDisplay = -MAX_INT;
+}
+
+void DecStream::xOutputPicture( Picture* pic )
+{
+  m_pocLastDisplay = pic->getPOC();
+
+  if( !pic->referenced && pic->reconstructed )
+  {
+    pic->reconstructed = false;
+  }
+  pic->neededForOutput = false;
+
+  // the buffer is not reused by DecLib::xGetNewPicBuffer until the application has released it
+  pic->outputRefCount++;
+  m_outputQueue.push_back( pic );
+}
+
+// ====================================================================================================================
+// C interface
+// ====================================================================================================================
+
+struct DecStreamHandle
+{
+  DecStream   stream;
+  std::string lastError;
+};
+
+int decstream_create( DecStreamHandle** handle, int maxTemporalLayer, int targetLayer )
+{
+  *handle = nullptr;
+  DecStreamHandle* h = new DecStreamHandle;
+  try
+  {
+    DecStreamParams params;
+    params.maxTemporalLayer = maxTemporalLayer;
+    params.targetLayer      = targetLayer;
+    h->stream.create( params );
+  }
+  catch( std::exception& e )
+  {
+    msg( ERROR, "%s\n", e.what() );
+    delete h;
+    return DECSTREAM_ERROR;
+  }
+  *handle = h;
+  return DECSTREAM_OK;
+}
+
+void decstream_destroy( DecStreamHandle* handle )
+{
+  delete handle;
+}
+
+int decstream_push_data( DecStreamHandle* handle, const uint8_t* data, size_t size )
+{
+  try
+  {
+    handle->stream.pushData( data, size );
+  }
+  catch( std::exception& e )
+  {
+    handle->lastError = e.what();
+    return DECSTREAM_ERROR;
+  }
+  return DECSTREAM_OK;
+}
+
+int decstream_push_nal_unit( DecStreamHandle* handle, const uint8_t* data, size_t size )
+{
+  try
+  {
+    handle->stream.pushNalUnit( data, size );
+  }
+  catch( std::exception& e )
+  {
+    handle->lastError = e.what();
+    return DECSTREAM_ERROR;
+  }
+  return DECSTREAM_OK;
+}
+
+int decstream_flush( DecStreamHandle* handle )
+{
+  try
+  {
+    handle->stream.flush();
+  }
+  catch( std::exception& e )
+  {
+    handle->lastError = e.what();
+    return DECSTREAM_ERROR;
+  }
+  return DECSTREAM_OK;
+}
+
+int decstream_get_picture( DecStreamHandle* handle, DecStreamPlanes* planes )
+{
+  DecStreamPicturePtr pic = handle->stream.getPicture();
+  if( !pic )
+  {
+    return 0;
+  }
+
+  const CPelUnitBuf& buf = pic->getBuf();
+  planes->poc            = pic->getPOC();
+  planes->chromaFormat   = int( pic->getChromaFormat() );
+  planes->bitDepth[0]    = pic->getBitDepth( CHANNEL_TYPE_LUMA );
+  planes->bitDepth[1]    = pic->getBitDepth( CHANNEL_TYPE_CHROMA );
+  planes->bytesPerSample = int( sizeof( Pel ) );
+  planes->numPlanes      = int( buf.bufs.size() );
+  for( int i = 0; i < 3; i++ )
+  {
+    const bool valid  = i < planes->numPlanes;
+    planes->plane [i] = valid ? buf.bufs[i].buf    : nullptr;
+    planes->width [i] = valid ? buf.bufs[i].width  : 0;
+    planes->height[i] = valid ? buf.bufs[i].height : 0;
+    planes->stride[i] = valid ? buf.bufs[i].stride : 0;
+  }
+  planes->opaque = new DecStreamPicturePtr( pic );
+  return 1;
+}
+
+void decstream_release_picture( DecStreamPlanes* planes )
+{
+  delete static_cast<DecStreamPicturePtr*>( planes->opaque );
+  planes->opaque = nullptr;
+}
+
+const char* decstream_get_last_error( const DecStreamHandle* handle )
+{
+  return handle->lastError.c_str();
+}
+
+//! \}
@@ -0,0 +1,148 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DecStream.h
+    \brief    decoder library interface for embedding applications (header)
+*/
+
+#ifndef __DECSTREAM__
+#define __DECSTREAM__
+
+#include "DecLib.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+//! \ingroup DecoderLib
+//! \{
+
+struct DecStreamPool;
+
+/// parameters of a decoder stream
+struct DecStreamParams
+{
+  int      maxTemporalLayer;                ///< highest temporal sub-layer to be decoded, -1 for all
+  int      targetLayer;                     ///< nuh_layer_id to be decoded, -1 for all
+  int      decodedPictureHashSEIEnabled;    ///< 1: check the decoded picture hash SEI messages, 0: ignore them
+  MsgLevel pictureInfoLevel;                ///< message level of the per-picture decoding report
+
+  DecStreamParams()
+    : maxTemporalLayer            ( -1 )
+    , targetLayer                 ( -1 )
+    , decodedPictureHashSEIEnabled( 1 )
+    , pictureInfoLevel            ( DETAILS )
+  {}
+};
+
+/// view of a decoded picture in output order, the reconstruction buffer is not reused by the decoder while the view exists
+class DecStreamPicture
+{
+public:
+  int                 getPOC          ()                    const { return m_poc; }
+  uint32_t            getTemporalId   ()                    const { return m_temporalId; }
+  ChromaFormat        getChromaFormat ()                    const { return m_chromaFormat; }
+  int                 getBitDepth     ( ChannelType chType )const { return m_bitDepths.recon[chType]; }
+  const Window&       getConformanceWindow()                const { return m_confWindow; }
+  const CPelUnitBuf&  getBuf          ()                    const { return m_buf; }   ///< conformance window of the reconstruction
+  const CPelUnitBuf   getFullBuf      ()                    const { return m_pic->getRecoBuf(); }
+  const Picture&      getPicture      ()                    const { return *m_pic; }  ///< the parameter sets referenced by the picture may have been replaced since its output
+
+private:
+  friend class DecStream;
+
+  DecStreamPicture( Picture* pic, const std::shared_ptr<DecStreamPool>& pool );
+  ~DecStreamPicture() {}
+
+  static void xRelease( DecStreamPicture* pic );
+
+  Picture*                        m_pic;
+  int                             m_poc;
+  uint32_t                        m_temporalId;
+  ChromaFormat                    m_chromaFormat;
+  BitDepths                       m_bitDepths;
+  Window                          m_confWindow;
+  CPelUnitBuf                     m_buf;
+  std::shared_ptr<DecStreamPool>  m_pool;
+};
+
+typedef std::shared_ptr<const DecStreamPicture> DecStreamPicturePtr;
+
+/** decoder for a single bitstream, fed with Annex-B data or NAL units and returning the pictures in output order.
+    A stream must only be used from one thread, the returned pictures may be released from any thread.
+    Errors in the bitstream are reported by throwing an Exception. */
+class DecStream
+{
+public:
+  DecStream();
+  ~DecStream();
+
+  void                create                ( const DecStreamParams& params = DecStreamParams() );
+  void                destroy               ();
+
+  void                pushData              ( const uint8_t* data, size_t size );   ///< Annex-B byte stream, may be split at arbitrary positions
+  void                pushNalUnit           ( const uint8_t* data, size_t size );   ///< single NAL unit without start code
+  void                flush                 ();                                     ///< end of the bitstream, makes all remaining pictures available
+
+  DecStreamPicturePtr getPicture            ();                                     ///< next picture in output order, empty if none is available
+  size_t              getNumPicturesAvailable() const { return m_outputQueue.size(); }
+  uint32_t            getNumberOfChecksumErrorsDetected() const;
+
+private:
+  void                xDecode               ( const uint8_t* data, size_t size, bool endOfStream );
+  bool                xDecodeNalUnit        ( InputNALUnit& nalu, bool endOfStream );
+  void                xFinishPicture        ();
+  void                xWriteOutput          ();
+  void                xFlushOutput          ();
+  void                xOutputPicture        ( Picture* pic );
+  bool                xIsNaluToBeDecoded    ( const InputNALUnit& nalu ) const;
+
+  DecStreamParams                 m_params;
+  bool                            m_created;
+  PicList*                        m_pcListPic;
+  int                             m_pocLastDisplay;
+  int                             m_skipFrames;
+  bool                            m_loopFiltered;
+
+  std::vector<uint8_t>            m_byteStream;       ///< Annex-B data not yet assigned to a complete NAL unit
+  size_t                          m_nalStart;         ///< first byte of the current NAL unit in m_byteStream
+  size_t                          m_scanPos;          ///< position to continue the start code search
+
+  std::deque<Picture*>            m_outputQueue;
+  std::shared_ptr<DecStreamPool>  m_pool;             ///< owns the decoder, kept alive by the output pictures
+};
+
+//! \}
+
+#endif // __DECSTREAM__
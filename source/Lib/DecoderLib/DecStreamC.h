@@ -0,0 +1,83 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DecStreamC.h
+    \brief    C interface of the decoder library (DecStream)
+*/
+
+#ifndef __DECSTREAMC__
+#define __DECSTREAMC__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECSTREAM_OK       0
+#define DECSTREAM_ERROR   -1
+
+typedef struct DecStreamHandle DecStreamHandle;
+
+/// planes of a decoded picture, the sample buffers stay valid until decstream_release_picture() is called
+typedef struct DecStreamPlanes
+{
+  int         poc;
+  int         chromaFormat;       ///< 0: 4:0:0, 1: 4:2:0, 2: 4:2:2, 3: 4:4:4
+  int         bitDepth[2];        ///< luma, chroma
+  int         bytesPerSample;
+  int         numPlanes;
+  const void* plane[3];           ///< top-left sample of the conformance window
+  int         width[3];
+  int         height[3];
+  ptrdiff_t   stride[3];          ///< in samples
+  void*       opaque;             ///< reference held by the application
+} DecStreamPlanes;
+
+int         decstream_create          ( DecStreamHandle** handle, int maxTemporalLayer, int targetLayer );
+void        decstream_destroy         ( DecStreamHandle* handle );
+int         decstream_push_data       ( DecStreamHandle* handle, const uint8_t* data, size_t size );
+int         decstream_push_nal_unit   ( DecStreamHandle* handle, const uint8_t* data, size_t size );
+int         decstream_flush           ( DecStreamHandle* handle );
+/// returns 1 if a picture was returned in planes, 0 if no picture is available
+int         decstream_get_picture     ( DecStreamHandle* handle, DecStreamPlanes* planes );
+void        decstream_release_picture ( DecStreamPlanes* planes );
+const char* decstream_get_last_error  ( const DecStreamHandle* handle );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DECSTREAMC__
@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 
@@ -58,42 +59,63 @@ using namespace std;
 //! \{
 static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bitstream, bool isVclNalUnit)
 {
-  uint32_t zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  uint8_t* const buf = nalUnitBuf.data();
+  const size_t   len = nalUnitBuf.size();
+  size_t readPos  = 0;
+  size_t writePos = 0;
 
-  uint32_t pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  CHECK(len > 0 && buf[len - 1] == 0x00, "Zero count not '0'");
+
+  // only the zero bytes need to be examined, the data in between is moved as a whole
+  size_t scanPos = 0;
+  while (scanPos + 2 < len)
   {
-    CHECK(zeroCount >= 2 && *it_read < 0x03, "Zero count is '2' and read value is small than '3'");
-    if (zeroCount == 2 && *it_read == 0x03)
+    const uint8_t* zero = (const uint8_t*) memchr(buf + scanPos, 0x00, len - scanPos - 2);
+    if (zero == NULL)
+    {
+      break;
+    }
+    size_t pos = zero - buf;
+    if (buf[pos + 1] != 0x00)
+    {
+      scanPos = pos + 2;
+      continue;
+    }
+    CHECK(buf[pos + 2] < 0x03, "Zero count is '2' and read value is small than '3'");
+    if (buf[pos + 2] != 0x03)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      scanPos = pos + 3;
+      continue;
+    }
+
+    // emulation prevention byte at pos + 2
+    bitstream->pushEmulationPreventionByteLocation( uint32_t(pos + 2) );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-      CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
+    CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
-      {
-        break;
-      }
-      CHECK(*it_read > 0x03, "Read a value bigger than '3'");
+    CHECK(pos + 3 < len && buf[pos + 3] > 0x03, "Read a value bigger than '3'");
+    if (writePos != readPos)
+    {
+      memmove(buf + writePos, buf + readPos, pos + 2 - readPos);
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    writePos += pos + 2 - readPos;
+    readPos = scanPos = pos + 3;
+  }
+  if (writePos != readPos)
+  {
+    memmove(buf + writePos, buf + readPos, len - readPos);
   }
-  CHECK(zeroCount != 0, "Zero count not '0'");
+  writePos += len - readPos;
 
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (writePos > 0 && buf[writePos - 1] == 0x00)
     {
-      it_write--;
+      writePos--;
       n++;
     }
 
@@ -103,7 +125,7 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(writePos);
 }
 
 #if ENABLE_TRACING
@@ -77,8 +77,8 @@ static std::vector<uint32_t> writeAnnexB(std::ostream& out, const AccessUnit& au
       out.write(reinterpret_cast<const char*>(start_code_prefix+1), 3);
       size += 3;
     }
-    out << nalu.m_nalUnitData.str();
-    size += uint32_t(nalu.m_nalUnitData.str().size());
+    out.write(reinterpret_cast<const char*>(nalu.m_nalUnitData.data()), nalu.m_nalUnitData.size());
+    size += uint32_t(nalu.m_nalUnitData.size());
 
     annexBsizes.push_back(size);
   }
@@ -38,6 +38,7 @@
 
 #include "CommonLib/Picture.h"
 #include "CommonLib/CodingStructure.h"
+#include "CommonLib/StageProfiler.h"
 
 #define AlfCtx(c) SubCtx( Ctx::Alf, c)
 std::vector<double> EncAdaptiveLoopFilter::m_lumaLevelToWeightPLUT;
@@ -664,6 +665,7 @@ void EncAdaptiveLoopFilter::ALFProcess(CodingStructure& cs, const double *lambda
 #endif
                                       )
 {
+  PROFILE_STAGE( PROF_STAGE_ALF );
   if (cs.slice->getPendingRasInit() || cs.slice->isIDRorBLA())
   {
 #if JVET_O_MAX_NUM_ALF_APS_8
@@ -3850,6 +3852,9 @@ void EncAdaptiveLoopFilter::alfReconstructor(CodingStructure& cs, const PelUnitB
 #endif
   for (int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight)
   {
+    // the CTU rows above are final, extend their borders while they are still in the cache
+    cs.picture->extendPicBorder( yPos );
+
     for (int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
     {
       const int width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
@@ -4016,6 +4021,8 @@ void EncAdaptiveLoopFilter::alfReconstructor(CodingStructure& cs, const PelUnitB
       ctuIdx++;
     }
   }
+
+  cs.picture->extendPicBorder();
 }
 #if JVET_O0090_ALF_CHROMA_FILTER_ALTERNATIVES_CTB
 
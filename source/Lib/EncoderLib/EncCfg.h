@@ -190,6 +190,8 @@ protected:
   bool      m_printHexPsnr;
   bool      m_printFrameMSE;
   bool      m_printSequenceMSE;
+  bool      m_printSSIM;
+  int       m_metricThreads;
   bool      m_cabacZeroWordPaddingEnabled;
 
   bool      m_bIntraOnlyConstraintFlag;
@@ -329,6 +331,7 @@ protected:
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
   bool      m_HashME;
+  int       m_hashMEThreads;
   bool      m_AffineAmvrEncOpt;
   bool      m_DMVR;
   bool      m_MMVD;
@@ -370,6 +373,7 @@ protected:
   bool      m_useAMaxBT;
   bool      m_e0023FastEnc;
   bool      m_contentBasedFastQtbt;
+  int       m_fastSplitPruning;
   bool      m_useNonLinearAlfLuma;
   bool      m_useNonLinearAlfChroma;
 #if JVET_O0090_ALF_CHROMA_FILTER_ALTERNATIVES_CTB
@@ -377,6 +381,7 @@ protected:
 #endif
   bool      m_MIP;
   bool      m_useFastMIP;
+  int       m_intraGradientPreselect;
 #if JVET_O0050_LOCAL_DUAL_TREE
   int       m_fastLocalDualTreeMode;
 #endif
@@ -654,6 +659,9 @@ protected:
   uint32_t      m_RCCpbSize;
   double    m_RCInitialCpbFullness;
 #endif
+  bool      m_RCTwoPass;
+  bool      m_RCFirstPassMode;
+  std::string m_RCStatsFileName;
   bool      m_TransquantBypassEnabledFlag;                    ///< transquant_bypass_enabled_flag setting in PPS.
   bool      m_CUTransquantBypassFlagForce;                    ///< if transquant_bypass_enabled_flag, then, if true, all CU transquant bypass flags will be set to true.
 
@@ -742,6 +750,7 @@ protected:
   bool        m_rprEnabled;
   int         m_switchPocPeriod;
   int         m_upscaledOutput;
+  int         m_rescaleThreads;
 #endif
 
 public:
@@ -855,6 +864,12 @@ public:
   bool      getPrintFrameMSE                ()         const { return m_printFrameMSE;              }
   void      setPrintFrameMSE                (bool value)     { m_printFrameMSE = value;             }
 
+  bool      getPrintSSIM                    ()         const { return m_printSSIM;                  }
+  void      setPrintSSIM                    (bool value)     { m_printSSIM = value;                 }
+
+  int       getMetricThreads                ()         const { return m_metricThreads;              }
+  void      setMetricThreads                (int value)      { m_metricThreads = value;             }
+
   bool      getPrintSequenceMSE             ()         const { return m_printSequenceMSE;           }
   void      setPrintSequenceMSE             (bool value)     { m_printSequenceMSE = value;          }
 
@@ -993,6 +1008,8 @@ public:
   bool      getAllowDisFracMMVD             ()         const { return m_allowDisFracMMVD; }
   void      setUseHashME                    ( bool b )       { m_HashME = b; }
   bool      getUseHashME                    ()         const { return m_HashME; }
+  void      setHashMEThreads                ( int i )        { m_hashMEThreads = i; }
+  int       getHashMEThreads                ()         const { return m_hashMEThreads; }
   void      setUseAffineAmvr                ( bool b )       { m_AffineAmvr = b;    }
   bool      getUseAffineAmvr                ()         const { return m_AffineAmvr; }
   void      setUseAffineAmvrEncOpt          ( bool b )       { m_AffineAmvrEncOpt = b;    }
@@ -1079,6 +1096,8 @@ public:
   bool      getUseE0023FastEnc              () const         { return m_e0023FastEnc; }
   void      setUseContentBasedFastQtbt      ( bool b )       { m_contentBasedFastQtbt = b; }
   bool      getUseContentBasedFastQtbt      () const         { return m_contentBasedFastQtbt; }
+  void      setFastSplitPruning             ( int  i )       { m_fastSplitPruning = i; }
+  int       getFastSplitPruning             () const         { return m_fastSplitPruning; }
   void      setUseNonLinearAlfLuma          ( bool b )       { m_useNonLinearAlfLuma = b; }
   bool      getUseNonLinearAlfLuma          () const         { return m_useNonLinearAlfLuma; }
   void      setUseNonLinearAlfChroma        ( bool b )       { m_useNonLinearAlfChroma = b; }
@@ -1091,6 +1110,8 @@ public:
   bool      getUseMIP                       () const         { return m_MIP; }
   void      setUseFastMIP                   ( bool b )       { m_useFastMIP = b; }
   bool      getUseFastMIP                   () const         { return m_useFastMIP; }
+  void      setIntraGradientPreselect       ( int  i )       { m_intraGradientPreselect = i; }
+  int       getIntraGradientPreselect       () const         { return m_intraGradientPreselect; }
 #if JVET_O0050_LOCAL_DUAL_TREE
   void     setFastLocalDualTreeMode         ( int i )        { m_fastLocalDualTreeMode = i; }
   int      getFastLocalDualTreeMode         () const         { return m_fastLocalDualTreeMode; }
@@ -1647,6 +1668,12 @@ public:
   double       getInitialCpbFullness  ()                             { return m_RCInitialCpbFullness;  }
   void         setInitialCpbFullness  (double f)                     { m_RCInitialCpbFullness = f;     }
 #endif
+  bool         getRCTwoPass           () const                       { return m_RCTwoPass;             }
+  void         setRCTwoPass           ( bool b )                     { m_RCTwoPass = b;                }
+  bool         getRCFirstPassMode     () const                       { return m_RCFirstPassMode;       }
+  void         setRCFirstPassMode     ( bool b )                     { m_RCFirstPassMode = b;          }
+  const std::string& getRCStatsFileName() const                      { return m_RCStatsFileName;       }
+  void         setRCStatsFileName     ( const std::string& s )       { m_RCStatsFileName = s;          }
   bool         getTransquantBypassEnabledFlag()                      { return m_TransquantBypassEnabledFlag; }
   void         setTransquantBypassEnabledFlag(bool flag)             { m_TransquantBypassEnabledFlag = flag; }
   bool         getCUTransquantBypassFlagForceValue() const           { return m_CUTransquantBypassFlagForce; }
@@ -1829,6 +1856,8 @@ public:
   void        setSwitchPocPeriod( int p )                            { m_switchPocPeriod = p;}
   void        setUpscaledOutput( int b )                             { m_upscaledOutput = b; }
   int         getUpscaledOutput()                              const { return m_upscaledOutput; }
+  void        setRescaleThreads( int i )                             { m_rescaleThreads = i; }
+  int         getRescaleThreads()                              const { return m_rescaleThreads; }
 #endif
 };
 
@@ -44,6 +44,7 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/StageProfiler.h"
 #include "MCTS.h"
 
 
@@ -62,8 +63,38 @@ extern std::recursive_mutex g_cache_mutex;
 //! \ingroup EncoderLib
 //! \{
 
+#if ENABLE_STAGE_PROFILING
+static void xSetStageProfilerModeTestNames()
+{
+  g_stageProfiler.setModeTestName( ETM_HASH_INTER,       "hashInter" );
+  g_stageProfiler.setModeTestName( ETM_MERGE_SKIP,       "mergeSkip" );
+  g_stageProfiler.setModeTestName( ETM_INTER_ME,         "interMe" );
+  g_stageProfiler.setModeTestName( ETM_AFFINE,           "affine" );
+  g_stageProfiler.setModeTestName( ETM_MERGE_TRIANGLE,   "mergeTriangle" );
+  g_stageProfiler.setModeTestName( ETM_INTRA,            "intra" );
+#if !JVET_O0525_REMOVE_PCM
+  g_stageProfiler.setModeTestName( ETM_IPCM,             "ipcm" );
+#endif
+#if JVET_O0119_BASE_PALETTE_444
+  g_stageProfiler.setModeTestName( ETM_PALETTE,          "palette" );
+#endif
+  g_stageProfiler.setModeTestName( ETM_SPLIT_QT,         "splitQt" );
+  g_stageProfiler.setModeTestName( ETM_SPLIT_BT_H,       "splitBtH" );
+  g_stageProfiler.setModeTestName( ETM_SPLIT_BT_V,       "splitBtV" );
+  g_stageProfiler.setModeTestName( ETM_SPLIT_TT_H,       "splitTtH" );
+  g_stageProfiler.setModeTestName( ETM_SPLIT_TT_V,       "splitTtV" );
+  g_stageProfiler.setModeTestName( ETM_POST_DONT_SPLIT,  "postDontSplit" );
+#if REUSE_CU_RESULTS
+  g_stageProfiler.setModeTestName( ETM_RECO_CACHED,      "recoCached" );
+#endif
+  g_stageProfiler.setModeTestName( ETM_TRIGGER_IMV_LIST, "triggerImvList" );
+  g_stageProfiler.setModeTestName( ETM_IBC,              "ibc" );
+  g_stageProfiler.setModeTestName( ETM_IBC_MERGE,        "ibcMerge" );
+}
+#endif
+
 // ====================================================================================================================
-EncCu::EncCu() : m_triangleModeTest
+EncCu::EncCu() : m_mergeCandCacheValid( false ), m_triangleModeTest
 {
   TriangleMotionInfo( 0, 1, 0 ), TriangleMotionInfo( 1, 0, 1 ), TriangleMotionInfo( 1, 0, 2 ), TriangleMotionInfo( 0, 0, 1 ), TriangleMotionInfo( 0, 2, 0 ),
   TriangleMotionInfo( 1, 0, 3 ), TriangleMotionInfo( 1, 0, 4 ), TriangleMotionInfo( 1, 1, 0 ), TriangleMotionInfo( 0, 3, 0 ), TriangleMotionInfo( 0, 4, 0 ),
@@ -191,6 +222,10 @@ void EncCu::create( EncCfg* encCfg )
 
   m_CtxBuffer.resize( maxDepth );
   m_CurrCtx = 0;
+
+#if ENABLE_STAGE_PROFILING
+  xSetStageProfilerModeTestNames();
+#endif
 }
 
 
@@ -325,6 +360,7 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
 
 void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[], const int currQP[] )
 {
+  PROFILE_STAGE( PROF_STAGE_RDO );
   m_modeCtrl->initCTUEncoding( *cs.slice );
 #if JVET_O0050_LOCAL_DUAL_TREE
   cs.treeType = TREE_D;
@@ -630,6 +666,8 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
 #if JVET_O0502_ISP_CLEANUP
   CHECK(maxCostAllowed < 0, "Wrong value of maxCostAllowed!");
 #endif
+  m_mergeCandCacheValid = false;
+
   if (m_shareState == NO_SHARE)
   {
     tempCS->sharedBndPos = tempCS->area.Y().lumaPos();
@@ -816,6 +854,8 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
     }
 #endif
 
+    PROFILE_MODE_TEST( currTestMode.type );
+
     if( currTestMode.type == ETM_INTER_ME )
     {
       if( ( currTestMode.opts & ETO_IMV ) != 0 )
@@ -944,6 +984,8 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
 #else
       xCheckModeSplit( tempCS, bestCS, partitioner, currTestMode );
 #endif
+        // the sub-CUs coded in the split test may have changed the neighbourhood of this CU
+        m_mergeCandCacheValid = false;
 #if JVET_O0050_LOCAL_DUAL_TREE
         //recover cons modes
         tempCS->modeType = partitioner.modeType = modeTypeParent;
@@ -2457,7 +2499,7 @@ void EncCu::xFillPCMBuffer( CodingUnit &cu )
         CompArea    tmpArea(COMPONENT_Y, compArea.chromaFormat, Position(0, 0), compArea.size());
         PelBuf tempOrgBuf = m_tmpStorageLCU->getBuf(tmpArea);
         tempOrgBuf.copyFrom(source);
-        tempOrgBuf.rspSignal(m_pcReshape->getFwdLUT());
+        tempOrgBuf.rspSignal(m_pcReshape->getFwdMapping());
         destination.copyFrom(tempOrgBuf);
       }
       else
@@ -2510,6 +2552,23 @@ void EncCu::xCheckRDCostHashInter( CodingStructure *&tempCS, CodingStructure *&b
   m_modeCtrl->setIsHashPerfectMatch(isPerfectMatch);
 }
 
+void EncCu::xGetInterMergeCandidates( const PredictionUnit &pu, MergeCtx &mergeCtx )
+{
+  // the spatial, temporal and HMVP candidates of a CU only depend on already coded neighbours,
+  // which stay unchanged between the mode tests of the CU
+  if( !m_mergeCandCacheValid || m_mergeCandCacheArea != pu.Y() )
+  {
+    m_mergeCandCache = MergeCtx();
+    PU::getInterMergeCandidates( pu, m_mergeCandCache, 0 );
+    m_mergeCandCacheArea  = pu.Y();
+    m_mergeCandCacheValid = true;
+  }
+
+  const MotionBuf subPuMvpMiBuf = mergeCtx.subPuMvpMiBuf;
+  mergeCtx                      = m_mergeCandCache;
+  mergeCtx.subPuMvpMiBuf        = subPuMvpMiBuf;
+}
+
 void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
   const Slice &slice = *tempCS->slice;
@@ -2543,9 +2602,7 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
     pu.cs = tempCS;
     pu.shareParentPos = tempCS->sharedBndPos;
     pu.shareParentSize = tempCS->sharedBndSize;
-    PU::getInterMergeCandidates(pu, mergeCtx
-      , 0
-    );
+    xGetInterMergeCandidates( pu, mergeCtx );
     PU::getInterMMVDMergeCandidates(pu, mergeCtx);
     pu.regularMergeFlag = true;
   }
@@ -2777,20 +2834,20 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
 #endif
           if (pu.cs->slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag())
           {
-            pu.cs->getPredBuf(pu).Y().rspSignal(m_pcReshape->getFwdLUT());
+            pu.cs->getPredBuf(pu).Y().rspSignal(m_pcReshape->getFwdMapping());
           }
           m_pcIntraSearch->geneWeightedPred(COMPONENT_Y, pu.cs->getPredBuf(pu).Y(), pu, m_pcIntraSearch->getPredictorPtr2(COMPONENT_Y, intraCnt));
 
           // calculate cost
           if (pu.cs->slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag())
           {
-            pu.cs->getPredBuf(pu).Y().rspSignal(m_pcReshape->getInvLUT());
+            pu.cs->getPredBuf(pu).Y().rspSignal(m_pcReshape->getInvMapping());
           }
           distParam.cur = pu.cs->getPredBuf(pu).Y();
           Distortion sadValue = distParam.distFunc(distParam);
           if (pu.cs->slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag())
           {
-            pu.cs->getPredBuf(pu).Y().rspSignal(m_pcReshape->getFwdLUT());
+            pu.cs->getPredBuf(pu).Y().rspSignal(m_pcReshape->getFwdMapping());
           }
           m_CABACEstimator->getCtx() = ctxStart;
 #if JVET_O0249_MERGE_SYNTAX
@@ -3016,7 +3073,7 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
 #endif
           if (pu.cs->slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag())
           {
-            tmpBuf.rspSignal(m_pcReshape->getFwdLUT());
+            tmpBuf.rspSignal(m_pcReshape->getFwdMapping());
           }
           m_pcIntraSearch->geneWeightedPred(COMPONENT_Y, tmpBuf, pu, m_pcIntraSearch->getPredictorPtr2(COMPONENT_Y, bufIdx));
           tmpBuf = tempCS->getPredBuf(pu).Cb();
@@ -3176,7 +3233,9 @@ void EncCu::xCheckRDCostMergeTriangle2Nx2N( CodingStructure *&tempCS, CodingStru
     pu.cs = tempCS;
     pu.regularMergeFlag = false;
 
-    PU::getTriangleMergeCandidates( pu, triangleMrgCtx );
+    MergeCtx mergeCtx;
+    xGetInterMergeCandidates( pu, mergeCtx );
+    PU::getTriangleMergeCandidates( pu, triangleMrgCtx, mergeCtx );
     const uint8_t maxNumTriangleCand = pu.cs->slice->getMaxNumTriangleCand();
     for (uint8_t mergeCand = 0; mergeCand < maxNumTriangleCand; mergeCand++)
     {
@@ -3759,7 +3818,7 @@ void EncCu::xCheckRDCostIBCModeMerge2Nx2N(CodingStructure *&tempCS, CodingStruct
         CompArea    tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
         PelBuf tmpLuma = m_tmpStorageLCU->getBuf(tmpArea);
         tmpLuma.copyFrom(tempCS->getOrgBuf().Y());
-        tmpLuma.rspSignal(m_pcReshape->getFwdLUT());
+        tmpLuma.rspSignal(m_pcReshape->getFwdMapping());
         m_pcRdCost->setDistParam(distParam, tmpLuma, refBuf, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y, bUseHadamard);
       }
       else
@@ -4504,7 +4563,7 @@ void EncCu::xCalDebCost( CodingStructure &cs, Partitioner &partitioner, bool cal
       picDbBuf.getBuf( curCompArea ).copyFrom( cs.getRecoBuf( curCompArea ) );
       if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getSliceReshaperInfo().getUseSliceReshaper() && isLuma(compId))
       {
-        picDbBuf.getBuf( curCompArea ).rspSignal( m_pcReshape->getInvLUT() );
+        picDbBuf.getBuf( curCompArea ).rspSignal( m_pcReshape->getInvMapping() );
       }
 
       //left neighbour
@@ -4514,7 +4573,7 @@ void EncCu::xCalDebCost( CodingStructure &cs, Partitioner &partitioner, bool cal
         picDbBuf.getBuf( compArea ).copyFrom( cs.picture->getRecoBuf( compArea ) );
         if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getSliceReshaperInfo().getUseSliceReshaper() && isLuma(compId))
         {
-          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvLUT() );
+          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvMapping() );
         }
       }
       //top neighbour
@@ -4524,7 +4583,7 @@ void EncCu::xCalDebCost( CodingStructure &cs, Partitioner &partitioner, bool cal
         picDbBuf.getBuf( compArea ).copyFrom( cs.picture->getRecoBuf( compArea ) );
         if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getSliceReshaperInfo().getUseSliceReshaper() && isLuma(compId))
         {
-          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvLUT() );
+          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvMapping() );
         }
       }
     }
@@ -4599,7 +4658,7 @@ Distortion EncCu::getDistortionDb( CodingStructure &cs, CPelBuf org, CPelBuf rec
       CompArea    tmpArea( COMPONENT_Y, cs.area.chromaFormat, Position( 0, 0 ), compArea.size() );
       PelBuf tmpRecLuma = m_tmpStorageLCU->getBuf( tmpArea );
       tmpRecLuma.copyFrom( reco );
-      tmpRecLuma.rspSignal( m_pcReshape->getInvLUT() );
+      tmpRecLuma.rspSignal( m_pcReshape->getInvMapping() );
       dist += m_pcRdCost->getDistPart( org, tmpRecLuma, cs.sps->getBitDepth( toChannelType( compID ) ), compID, DF_SSE_WTD, &orgLuma );
     }
     else
@@ -4614,7 +4673,7 @@ Distortion EncCu::getDistortionDb( CodingStructure &cs, CPelBuf org, CPelBuf rec
       CompArea    tmpArea( COMPONENT_Y, cs.area.chromaFormat, Position( 0, 0 ), compArea.size() );
       PelBuf tmpRecLuma = m_tmpStorageLCU->getBuf( tmpArea );
       tmpRecLuma.copyFrom( reco );
-      tmpRecLuma.rspSignal( m_pcReshape->getFwdLUT() );
+      tmpRecLuma.rspSignal( m_pcReshape->getFwdMapping() );
       dist += m_pcRdCost->getDistPart( org, tmpRecLuma, cs.sps->getBitDepth( toChannelType( compID ) ), compID, DF_SSE );
     }
     else
@@ -5141,7 +5200,7 @@ void EncCu::xReuseCachedResult( CodingStructure *&tempCS, CodingStructure *&best
           CompArea    tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
           PelBuf tmpRecLuma = m_tmpStorageLCU->getBuf(tmpArea);
           tmpRecLuma.copyFrom(reco);
-          tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+          tmpRecLuma.rspSignal(m_pcReshape->getInvMapping());
           finalDistortion += m_pcRdCost->getDistPart(org, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID, DF_SSE_WTD, &orgLuma);
         }
         else
@@ -132,6 +132,9 @@ private:
 #endif
   PelStorage            m_acTriangleWeightedBuffer[TRIANGLE_MAX_NUM_CANDS]; // to store weighted prediction pixles
   double                m_mergeBestSATDCost;
+  bool                  m_mergeCandCacheValid;  // regular merge list of the current CU, shared by all merge tests until the next split test
+  Area                  m_mergeCandCacheArea;
+  MergeCtx              m_mergeCandCache;
   MotionInfo            m_SubPuMiBuf      [( MAX_CU_SIZE * MAX_CU_SIZE ) >> ( MIN_CU_LOG2 << 1 )];
 
   int                   m_ctuIbcSearchRangeX;
@@ -221,6 +224,7 @@ protected:
 #endif
   void xEncodeDontSplit       ( CodingStructure &cs, Partitioner &partitioner);
 
+  void xGetInterMergeCandidates( const PredictionUnit &pu, MergeCtx &mergeCtx );
   void xCheckRDCostMerge2Nx2N ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode );
 
   void xCheckRDCostMergeTriangle2Nx2N( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode );
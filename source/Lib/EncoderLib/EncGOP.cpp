@@ -53,6 +53,7 @@
 #include <cinttypes>
 
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/StageProfiler.h"
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
 
@@ -93,6 +94,13 @@ EncGOP::EncGOP()
 #endif
   m_lastRasPoc          = MAX_INT;
 
+  for( int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    m_sumSSIM  [comp]   = 0.0;
+    m_sumMSSSIM[comp]   = 0.0;
+  }
+  m_numSSIMPics         = 0;
+
   m_pcCfg               = NULL;
   m_pcSliceEncoder      = NULL;
   m_pcListPic           = NULL;
@@ -218,6 +226,7 @@ void EncGOP::init ( EncLib* pcEncLib )
   m_pcSAO                = pcEncLib->getSAO();
   m_pcALF = pcEncLib->getALF();
   m_pcRateCtrl           = pcEncLib->getRateCtrl();
+  m_picMetrics.setNumThreads( m_pcCfg->getMetricThreads() );
 #if !JVET_N0867_TEMP_SCAL_HRD
   m_lastBPSEI          = 0;
   m_totalCoded         = 0;
@@ -328,7 +337,7 @@ int EncGOP::xWriteVPS (AccessUnit &accessUnit, const VPS *vps)
 #endif
   m_HLSWriter->codeVPS( vps );
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 int EncGOP::xWriteDPS (AccessUnit &accessUnit, const DPS *dps)
@@ -342,7 +351,7 @@ int EncGOP::xWriteDPS (AccessUnit &accessUnit, const DPS *dps)
 #endif
     m_HLSWriter->codeDPS( dps );
     accessUnit.push_back(new NALUnitEBSP(nalu));
-    return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+    return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
   }
   else
   {
@@ -360,7 +369,7 @@ int EncGOP::xWriteSPS (AccessUnit &accessUnit, const SPS *sps)
 #endif
   m_HLSWriter->codeSPS( sps );
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 
 }
 
@@ -386,7 +395,7 @@ int EncGOP::xWritePPS (AccessUnit &accessUnit, const PPS *pps)
   m_HLSWriter->codePPS( pps );
 #endif
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 #if JVET_O0245_VPS_DPS_APS
@@ -404,7 +413,7 @@ int EncGOP::xWriteAPS(AccessUnit &accessUnit, APS *aps)
 #endif
   m_HLSWriter->codeAPS(aps);
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 int EncGOP::xWriteParameterSets (AccessUnit &accessUnit, Slice *slice, const bool bSeqFirst)
@@ -1193,7 +1202,7 @@ void EncGOP::xUpdateDuData(AccessUnit &testAU, std::deque<DUData> &duData)
   uint32_t numRBSPBytes = 0;
   for (AccessUnit::const_iterator it = testAU.begin(); it != testAU.end(); it++)
   {
-    numRBSPBytes += uint32_t((*it)->m_nalUnitData.str().size());
+    numRBSPBytes += uint32_t((*it)->m_nalUnitData.size());
   }
   duData[0].accumBitsDU += ( numRBSPBytes << 3 );
   duData[0].accumNalsDU += numNalUnits;
@@ -1314,7 +1323,7 @@ void EncGOP::xUpdateDuInfoSEI(SEIMessages &duInfoSeiMessages, SEIPictureTiming *
 }
 
 static void
-cabac_zero_word_padding(Slice *const pcSlice, Picture *const pcPic, const std::size_t binCountsInNalUnits, const std::size_t numBytesInVclNalUnits, std::ostringstream &nalUnitData, const bool cabacZeroWordPaddingEnabled)
+cabac_zero_word_padding(Slice *const pcSlice, Picture *const pcPic, const std::size_t binCountsInNalUnits, const std::size_t numBytesInVclNalUnits, std::vector<uint8_t> &nalUnitData, const bool cabacZeroWordPaddingEnabled)
 {
   const SPS &sps=*(pcSlice->getSPS());
   const ChromaFormat format = sps.getChromaFormatIdc();
@@ -1343,12 +1352,14 @@ cabac_zero_word_padding(Slice *const pcSlice, Picture *const pcPic, const std::s
       const std::size_t numberOfAdditionalCabacZeroBytes=numberOfAdditionalCabacZeroWords*3;
       if (cabacZeroWordPaddingEnabled)
       {
-        std::vector<uint8_t> zeroBytesPadding(numberOfAdditionalCabacZeroBytes, uint8_t(0));
+        nalUnitData.reserve(nalUnitData.size() + numberOfAdditionalCabacZeroBytes);
         for(std::size_t i=0; i<numberOfAdditionalCabacZeroWords; i++)
         {
-          zeroBytesPadding[i*3+2]=3;  // 00 00 03
+          // 00 00 03
+          nalUnitData.push_back(0);
+          nalUnitData.push_back(0);
+          nalUnitData.push_back(3);
         }
-        nalUnitData.write(reinterpret_cast<const char*>(&(zeroBytesPadding[0])), numberOfAdditionalCabacZeroBytes);
         msg( NOTICE, "Adding %d bytes of padding\n", uint32_t( numberOfAdditionalCabacZeroWords * 3 ) );
       }
       else
@@ -1831,7 +1842,7 @@ void EncGOP::xPicInitHashME(Picture *pic, const SPS *sps, PicList &rcListPic)
             break;
           }
         }
-        refPic->addPictureToHashMapForInter();
+        refPic->addPictureToHashMapForInter( m_pcCfg->getHashMEThreads() );
       }
     }
   }
@@ -1848,7 +1859,7 @@ void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda,
   {
     frameLevel = 0;
   }
-  m_pcRateCtrl->initRCPic( frameLevel );
+  m_pcRateCtrl->initRCPic( frameLevel, slice->getPOC() );
   estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
 #if U0132_TARGET_BITS_SATURATION
@@ -1896,7 +1907,7 @@ void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda,
   {
     m_pcSliceEncoder->calCostSliceI(pic); // TODO: This only analyses the first slice segment - what about the others?
 
-    if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
+    if ( m_pcCfg->getIntraPeriod() != 1 && !m_pcRateCtrl->getRCPic()->getUseFirstPassStats() )   // do not refine allocated bits for all intra case or when first pass statistics are used
     {
       int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
       bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
@@ -2021,7 +2032,7 @@ void EncGOP::xPicInitLMCS(Picture *pic, Slice *slice)
       //reshape original signal
       if (m_pcReshaper->getSliceReshaperInfo().getUseSliceReshaper())
       {
-        pic->getOrigBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getFwdLUT());
+        pic->getOrigBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getFwdMapping());
         m_pcReshaper->setSrcReshaped(true);
         m_pcReshaper->setRecReshaped(true);
       }
@@ -2467,9 +2478,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     pcSlice->constructRefPicList(rcListPic);
 #if JVET_O1164_RPR
 #if JVET_O0299_APS_SCALINGLIST
-    pcSlice->scaleRefPicList( scaledRefPic, m_pcEncLib->getApss(), pcSlice->getLmcsAPS(), pcSlice->getscalingListAPS(), false );
+    pcSlice->scaleRefPicList( scaledRefPic, m_pcEncLib->getApss(), pcSlice->getLmcsAPS(), pcSlice->getscalingListAPS(), false, m_pcCfg->getRescaleThreads() );
 #else
-    pcSlice->scaleRefPicList( scaledRefPic, m_pcEncLib->getApss(), pcSlice->getLmcsAPS(), false );
+    pcSlice->scaleRefPicList( scaledRefPic, m_pcEncLib->getApss(), pcSlice->getLmcsAPS(), false, m_pcCfg->getRescaleThreads() );
 #endif
 #endif
 
@@ -2992,7 +3003,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
           }
         }
           CHECK((m_pcReshaper->getRecReshaped() == false), "Rec picture is not reshaped!");
-          pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getInvLUT());
+          pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getInvMapping());
           m_pcReshaper->setRecReshaped(false);
 
           pcPic->getOrigBuf().copyFrom(pcPic->getTrueOrigBuf());
@@ -3064,6 +3075,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       m_pcLoopFilter->loopFilterPic( cs );
 
       CS::setRefinedMotionField(cs);
+      cs.storeColMotionField();
       DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 1 ) ) );
 
       if( pcSlice->getSPS()->getSAOEnabledFlag() )
@@ -3351,8 +3363,8 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         bool bNALUAlignedWrittenToList    = false; // used to ensure current NALU is not written more than once to the NALU list.
         xAttachSliceDataToNalUnit(nalu, pcBitstreamRedirect);
         accessUnit.push_back(new NALUnitEBSP(nalu));
-        actualTotalBits += uint32_t(accessUnit.back()->m_nalUnitData.str().size()) * 8;
-        numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.str().size());
+        actualTotalBits += uint32_t(accessUnit.back()->m_nalUnitData.size()) * 8;
+        numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.size());
         bNALUAlignedWrittenToList = true;
 
         if (!bNALUAlignedWrittenToList)
@@ -3378,7 +3390,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
           uint32_t numRBSPBytes = 0;
           for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
           {
-            numRBSPBytes += uint32_t((*it)->m_nalUnitData.str().size());
+            numRBSPBytes += uint32_t((*it)->m_nalUnitData.size());
             numNalus ++;
           }
           duData.push_back(DUData());
@@ -3410,6 +3422,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       xCalculateAddPSNRs(isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, encTime, snr_conversion, printFrameMSE, &PSNR_Y
                        , isEncodeLtRef
       );
+      g_stageProfiler.finishPicture( pcPic->getPOC() );
 
 #if HEVC_SEI
       // Only produce the Green Metadata SEI message with the last picture.
@@ -3425,6 +3438,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
       printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
 
+      if ( m_pcCfg->getRCFirstPassMode() )
+      {
+        m_pcRateCtrl->addFirstPassPicture( pcSlice->getPOC(), pcSlice->getSliceQp(), pcSlice->isIntra(), actualTotalBits );
+      }
       if ( m_pcCfg->getUseRateCtrl() )
       {
         double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
@@ -3646,6 +3663,12 @@ void EncGOP::printOutSummary(uint32_t uiNumAllPicCoded, bool isField, const bool
     }
   }
 
+  if( m_pcCfg->getPrintSSIM() && m_numSSIMPics > 0 )
+  {
+    msg( INFO, "\nSSIM    : Y %1.6lf    U %1.6lf    V %1.6lf\n", m_sumSSIM[COMPONENT_Y] / m_numSSIMPics, m_sumSSIM[COMPONENT_Cb] / m_numSSIMPics, m_sumSSIM[COMPONENT_Cr] / m_numSSIMPics );
+    msg( INFO, "MS-SSIM : Y %1.6lf    U %1.6lf    V %1.6lf\n", m_sumMSSSIM[COMPONENT_Y] / m_numSSIMPics, m_sumMSSSIM[COMPONENT_Cb] / m_numSSIMPics, m_sumMSSSIM[COMPONENT_Cr] / m_numSSIMPics );
+  }
+
   msg( DETAILS,"\nRVM: %.3lf\n", xCalculateRVM() );
 }
 
@@ -3830,18 +3853,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        uiTotalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            uiTotalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return uiTotalDiff;
+        return m_picMetrics.getSSE( pic0, pic1 );
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -3878,17 +3890,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
   }
   else
   {
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    uiTotalDiff = m_picMetrics.getSSE( pic0, pic1 );
   }
 
   return uiTotalDiff;
@@ -3903,45 +3905,28 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
     return 0;
   }
 
-  double uiTotalDiffWPSNR;
-  const  Pel*  pSrc0 = pic0.bufAt(0, 0);
-  const  Pel*  pSrc1 = pic1.bufAt(0, 0);
-  const  Pel*  pSrcLuma = picLuma0.bufAt(0, 0);
   CHECK(pic0.width  != pic1.width , "Unspecified error");
   CHECK(pic0.height != pic1.height, "Unspecified error");
 
-  if( rshift > 0 )
-  {
-    uiTotalDiffWPSNR = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[(x << getComponentScaleX(compID, chfmt))]);
-        uiTotalDiffWPSNR += ((dW * (double)iTemp * (double)iTemp)) * (double)(1 >> rshift);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-      pSrcLuma += picLuma0.stride << getComponentScaleY(compID, chfmt);
-    }
-  }
-  else
+  const RdCost* rdCost = m_pcEncLib->getRdCost();
+  const int     scaleX = getComponentScaleX(compID, chfmt);
+  const int     scaleY = getComponentScaleY(compID, chfmt);
+
+  // accumulated sequentially in raster order, the summation order of the floating point values is kept
+  double uiTotalDiffWPSNR = 0;
+  for (int y = 0; y < pic0.height; y++)
   {
-    uiTotalDiffWPSNR = 0;
-    for (int y = 0; y < pic0.height; y++)
+    const Pel* pSrc0    = pic0.bufAt(0, y);
+    const Pel* pSrc1    = pic1.bufAt(0, y);
+    const Pel* pSrcLuma = picLuma0.bufAt(0, y << scaleY);
+    for (int x = 0; x < pic0.width; x++)
     {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[x << getComponentScaleX(compID, chfmt)]);
-        uiTotalDiffWPSNR += dW * (double)iTemp * (double)iTemp;
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-      pSrcLuma += picLuma0.stride << getComponentScaleY(compID, chfmt);
+      Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
+      double dW = rdCost->getWPSNRLumaLevelWeight(pSrcLuma[x << scaleX]);
+      uiTotalDiffWPSNR += dW * (double)iTemp * (double)iTemp;
     }
   }
+  uiTotalDiffWPSNR *= (double)(1 >> rshift);
 
   return uiTotalDiffWPSNR;
 }
@@ -4076,6 +4061,9 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 
   //===== calculate PSNR =====
   double MSEyuvframe[MAX_NUM_COMPONENT] = {0, 0, 0};
+  double dSSIM      [MAX_NUM_COMPONENT] = {0, 0, 0};
+  double dMSSSIM    [MAX_NUM_COMPONENT] = {0, 0, 0};
+  const bool printSSIM = m_pcCfg->getPrintSSIM();
   const ChromaFormat formatD = pic.chromaFormat;
   const ChromaFormat format  = sps.getChromaFormatIdc();
 
@@ -4092,9 +4080,9 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 #if RPR_CONF_WINDOW
     // the input source picture has a conformance window derived at encoder
     Window& conformanceWindow = m_pcEncLib->getConformanceWindow();
-    Picture::rescalePicture( picC, pcPic->cs->pps->getConformanceWindow(), upscaledRec, conformanceWindow, format, sps.getBitDepths(), false );
+    Picture::rescalePicture( picC, pcPic->cs->pps->getConformanceWindow(), upscaledRec, conformanceWindow, format, sps.getBitDepths(), false, false, m_pcCfg->getRescaleThreads() );
 #else
-    Picture::rescalePicture(picC, upscaledRec, format, sps.getBitDepths(), false);
+    Picture::rescalePicture(picC, upscaledRec, format, sps.getBitDepths(), false, false, m_pcCfg->getRescaleThreads());
 #endif
   }
 #endif
@@ -4125,6 +4113,13 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     const double fRefValue = (double)maxval * maxval * size;
     dPSNR[comp]       = uiSSDtemp ? 10.0 * log10(fRefValue / (double)uiSSDtemp) : 999.99;
     MSEyuvframe[comp] = (double)uiSSDtemp / size;
+    if (printSSIM)
+    {
+      dSSIM[comp]   = m_picMetrics.getSSIM  (recPB, orgPB, bitDepth);
+      dMSSSIM[comp] = m_picMetrics.getMSSSIM(recPB, orgPB, bitDepth);
+      m_sumSSIM[comp]   += dSSIM[comp];
+      m_sumMSSSIM[comp] += dMSSSIM[comp];
+    }
 #if WCG_WPSNR
     const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
     if (useLumaWPSNR)
@@ -4172,7 +4167,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
   uint32_t numRBSPBytes = 0;
   for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
   {
-    uint32_t numRBSPBytes_nal = uint32_t((*it)->m_nalUnitData.str().size());
+    uint32_t numRBSPBytes_nal = uint32_t((*it)->m_nalUnitData.size());
     if (m_pcCfg->getSummaryVerboseness() > 0)
     {
       msg( NOTICE, "*** %6s numBytesInNALunit: %u\n", nalUnitTypeToString((*it)->m_nalUnitType), numRBSPBytes_nal);
@@ -4193,6 +4188,10 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 
   uint32_t uibits = numRBSPBytes * 8;
   m_vRVM_RP.push_back( uibits );
+  if (printSSIM)
+  {
+    m_numSSIMPics++;
+  }
 
   //===== add PSNR =====
   m_gcAnalyzeAll.addResult(dPSNR, (double)uibits, MSEyuvframe
@@ -4298,6 +4297,12 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 
     msg( NOTICE, " [Y %6.4lf dB    U %6.4lf dB    V %6.4lf dB]", dPSNR[COMPONENT_Y], dPSNR[COMPONENT_Cb], dPSNR[COMPONENT_Cr] );
 
+    if (printSSIM)
+    {
+      msg( NOTICE, " [SSIM Y %1.6lf    U %1.6lf    V %1.6lf]", dSSIM[COMPONENT_Y], dSSIM[COMPONENT_Cb], dSSIM[COMPONENT_Cr] );
+      msg( NOTICE, " [MS-SSIM Y %1.6lf    U %1.6lf    V %1.6lf]", dMSSSIM[COMPONENT_Y], dMSSSIM[COMPONENT_Cb], dMSSSIM[COMPONENT_Cr] );
+    }
+
 #if EXTENSION_360_VIDEO
     m_ext360.printPerPOCInfo(NOTICE);
 #endif
@@ -45,6 +45,7 @@
 #include "CommonLib/Picture.h"
 #include "CommonLib/LoopFilter.h"
 #include "CommonLib/NAL.h"
+#include "CommonLib/PictureMetrics.h"
 #include "EncSampleAdaptiveOffset.h"
 #include "EncAdaptiveLoopFilter.h"
 #include "EncReshape.h"
@@ -111,6 +112,10 @@ private:
   Analyze                 m_gcAnalyzeWPSNR;
 #endif
   Analyze                 m_gcAnalyzeAll_in;
+  PictureMetrics          m_picMetrics;
+  double                  m_sumSSIM  [MAX_NUM_COMPONENT];
+  double                  m_sumMSSSIM[MAX_NUM_COMPONENT];
+  int                     m_numSSIMPics;
 #if EXTENSION_360_VIDEO
   TExt360EncGop           m_ext360;
 public:
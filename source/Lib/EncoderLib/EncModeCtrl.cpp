@@ -48,6 +48,7 @@
 #include "CommonLib/dtrace_next.h"
 
 #include <cmath>
+#include <cstring>
 
 void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
 {
@@ -1101,6 +1102,9 @@ void EncModeCtrlMTnoRQT::create( const EncCfg& cfg )
   BestEncInfoCache::create( cfg.getChromaFormatIdc() );
 #endif
   SaveLoadEncInfoSbt::create();
+
+  std::memset( m_splitPruneTested, 0, sizeof( m_splitPruneTested ) );
+  std::memset( m_splitPruneHits,   0, sizeof( m_splitPruneHits ) );
 }
 
 void EncModeCtrlMTnoRQT::destroy()
@@ -1110,6 +1114,31 @@ void EncModeCtrlMTnoRQT::destroy()
   BestEncInfoCache::destroy();
 #endif
   SaveLoadEncInfoSbt::destroy();
+
+  uint64_t numTested = 0;
+
+  for( int split = CU_QUAD_SPLIT; split <= CU_TRIV_SPLIT; split++ )
+  {
+    numTested += m_splitPruneTested[split];
+  }
+
+  if( numTested )
+  {
+    static const char* splitName[CU_TRIV_SPLIT + 1] = { "", "QT", "BT-H", "BT-V", "TT-H", "TT-V" };
+
+    msg( VERBOSE, "\nSplit pruning (pruned / candidates):\n" );
+
+    for( int split = CU_QUAD_SPLIT; split <= CU_TRIV_SPLIT; split++ )
+    {
+      const uint64_t numSmooth = m_splitPruneHits[SPLIT_PRUNE_SMOOTH   ][split];
+      const uint64_t numDir    = m_splitPruneHits[SPLIT_PRUNE_DIRECTION][split];
+      const uint64_t numSkip   = m_splitPruneHits[SPLIT_PRUNE_SKIP     ][split];
+
+      msg( VERBOSE, "  %-4s %10llu / %10llu  (smooth %llu, direction %llu, skip %llu)\n", splitName[split],
+           ( unsigned long long ) ( numSmooth + numDir + numSkip ), ( unsigned long long ) m_splitPruneTested[split],
+           ( unsigned long long ) numSmooth, ( unsigned long long ) numDir, ( unsigned long long ) numSkip );
+    }
+  }
 }
 
 void EncModeCtrlMTnoRQT::initCTUEncoding( const Slice &slice )
@@ -1194,6 +1223,13 @@ void EncModeCtrlMTnoRQT::initCULevel( Partitioner &partitioner, const CodingStru
   cuECtx.set( DID_QUAD_SPLIT,       false );
   cuECtx.set( IS_BEST_NOSPLIT_SKIP, false );
   cuECtx.set( MAX_QT_SUB_DEPTH,     0 );
+  cuECtx.set( PRUNE_SMOOTH_SPLITS,  false );
+  cuECtx.set( PRUNE_DIR_SPLITS,     0 );
+
+  if( m_pcEncCfg->getFastSplitPruning() && isLuma( partitioner.chType ) )
+  {
+    xDeriveSplitPruning( cs, partitioner );
+  }
 
   // QP
   int baseQP = cs.baseQP;
@@ -1494,6 +1530,107 @@ void EncModeCtrlMTnoRQT::finishCULevel( Partitioner &partitioner )
   m_ComprCUCtxList.pop_back();
 }
 
+void EncModeCtrlMTnoRQT::xDeriveSplitPruning( const CodingStructure& cs, const Partitioner& partitioner )
+{
+  // mean absolute gradient (relative to the quantizer step size) below which a block counts as smooth,
+  // and the dominance ratio needed before one split direction is dropped, per FastSplitPruning level
+  static const double smoothThres[4] = { 0.0, 0.02, 0.04, 0.07 };
+  static const double dirRatio   [4] = { 0.0, 2.0,  1.6,  1.3  };
+
+  ComprCUCtx&     cuECtx  = m_ComprCUCtxList.back();
+  const CompArea& area    = cs.area.Y();
+  const CompArea& picArea = cs.picture->Y();
+  const int       level   = m_pcEncCfg->getFastSplitPruning();
+
+  if( area.width < 8 || area.height < 8 || !picArea.contains( area ) )
+  {
+    return;
+  }
+
+  // the gradients are taken as SADs against the block shifted by one sample, which has to stay inside the picture
+  const int offX = area.x + area.width  < picArea.x + picArea.width  ? 1 : ( area.x > picArea.x ? -1 : 0 );
+  const int offY = area.y + area.height < picArea.y + picArea.height ? 1 : ( area.y > picArea.y ? -1 : 0 );
+
+  if( !offX || !offY )
+  {
+    return;
+  }
+
+  const int     bitDepth = cs.sps->getBitDepth( CHANNEL_TYPE_LUMA );
+  const int     shift    = std::max( 0, bitDepth - 8 - DISTORTION_PRECISION_ADJUSTMENT( bitDepth ) );
+  const CPelBuf org      = cs.picture->getOrigBuf( area );
+  const CPelBuf orgHor   ( org.buf + offX,              org.stride, area.width, area.height );
+  const CPelBuf orgVer   ( org.buf + offY * org.stride, org.stride, area.width, area.height );
+
+  const double numPel    = double( area.area() );
+  const double gradHor   = ( m_pcRdCost->getDistPart( org, orgHor, bitDepth, COMPONENT_Y, DF_SAD ) >> shift ) / numPel;
+  const double gradVer   = ( m_pcRdCost->getDistPart( org, orgVer, bitDepth, COMPONENT_Y, DF_SAD ) >> shift ) / numPel;
+
+  const double qStep     = pow( 2.0, ( cs.baseQP - 4 ) / 6.0 );
+
+  if( gradHor + gradVer < smoothThres[level] * qStep )
+  {
+    cuECtx.set( PRUNE_SMOOTH_SPLITS, true );
+    return;
+  }
+
+  // SATD between the two halves of each binary split: halves that differ strongly are worth separating
+  const int     halfW    = area.width  >> 1;
+  const int     halfH    = area.height >> 1;
+  const CPelBuf orgTop   ( org.buf,                     org.stride, area.width, halfH );
+  const CPelBuf orgBot   ( org.bufAt( 0, halfH ),       org.stride, area.width, halfH );
+  const CPelBuf orgLeft  ( org.buf,                     org.stride, halfW, area.height );
+  const CPelBuf orgRight ( org.bufAt( halfW, 0 ),       org.stride, halfW, area.height );
+
+  const double satdTopBot = ( m_pcRdCost->getDistPart( orgTop,  orgBot,   bitDepth, COMPONENT_Y, DF_HAD ) >> shift ) / ( numPel / 2 );
+  const double satdLftRgt = ( m_pcRdCost->getDistPart( orgLeft, orgRight, bitDepth, COMPONENT_Y, DF_HAD ) >> shift ) / ( numPel / 2 );
+
+  // vertical structures (strong horizontal gradients) or left/right halves that differ much more than top/bottom
+  // make horizontal splits pointless, and vice versa; contradicting votes keep both directions
+  const bool skipHorSplits = gradHor    + 1 > dirRatio[level] * ( gradVer    + 1 ) || satdLftRgt + 1 > dirRatio[level] * ( satdTopBot + 1 );
+  const bool skipVerSplits = gradVer    + 1 > dirRatio[level] * ( gradHor    + 1 ) || satdTopBot + 1 > dirRatio[level] * ( satdLftRgt + 1 );
+
+  if( skipHorSplits != skipVerSplits )
+  {
+    cuECtx.set( PRUNE_DIR_SPLITS, skipHorSplits ? ( ( 1 << CU_HORZ_SPLIT ) | ( 1 << CU_TRIH_SPLIT ) ) : ( ( 1 << CU_VERT_SPLIT ) | ( 1 << CU_TRIV_SPLIT ) ) );
+  }
+}
+
+int EncModeCtrlMTnoRQT::xGetSplitPruneRule( const EncTestMode& encTestmode, const CodingStructure &cs, const Partitioner& partitioner ) const
+{
+  const ComprCUCtx& cuECtx = m_ComprCUCtxList.back();
+  const PartSplit   split  = getPartSplit( encTestmode );
+  const int         level  = m_pcEncCfg->getFastSplitPruning();
+
+  // a split can only be dropped once an unsplit candidate has been coded
+  if( !isLuma( partitioner.chType ) || !cuECtx.bestCS || cuECtx.bestCS->cost == MAX_DOUBLE )
+  {
+    return NUM_SPLIT_PRUNE_RULES;
+  }
+
+  if( cuECtx.get<bool>( PRUNE_SMOOTH_SPLITS ) )
+  {
+    return SPLIT_PRUNE_SMOOTH;
+  }
+
+  if( cuECtx.get<int>( PRUNE_DIR_SPLITS ) & ( 1 << split ) )
+  {
+    return SPLIT_PRUNE_DIRECTION;
+  }
+
+  if( level >= 2 && split != CU_QUAD_SPLIT && cuECtx.get<bool>( IS_BEST_NOSPLIT_SKIP ) )
+  {
+    const bool parentSkip = m_ComprCUCtxList.size() > 1 && ( m_ComprCUCtxList.end() - 2 )->get<bool>( IS_BEST_NOSPLIT_SKIP );
+
+    if( split == CU_TRIH_SPLIT || split == CU_TRIV_SPLIT || ( level >= 3 && parentSkip ) )
+    {
+      return SPLIT_PRUNE_SKIP;
+    }
+  }
+
+  return NUM_SPLIT_PRUNE_RULES;
+}
+
 
 bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner )
 {
@@ -1790,6 +1927,24 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
       return false;
     }
 
+    if( m_pcEncCfg->getFastSplitPruning() )
+    {
+      const int pruneRule = xGetSplitPruneRule( encTestmode, cs, partitioner );
+
+      m_splitPruneTested[split]++;
+
+      if( pruneRule != NUM_SPLIT_PRUNE_RULES )
+      {
+        m_splitPruneHits[pruneRule][split]++;
+
+        if( split == CU_HORZ_SPLIT ) cuECtx.set( DID_HORZ_SPLIT, false );
+        if( split == CU_VERT_SPLIT ) cuECtx.set( DID_VERT_SPLIT, false );
+        if( split == CU_QUAD_SPLIT ) cuECtx.set( DID_QUAD_SPLIT, false );
+
+        return false;
+      }
+    }
+
     if( m_pcEncCfg->getUseContentBasedFastQtbt() )
     {
       const CompArea& currArea = partitioner.currArea().Y();
@@ -547,11 +547,27 @@ class EncModeCtrlMTnoRQT : public EncModeCtrl, public CacheBlkInfoCtrl
 #if REUSE_CU_RESULTS
     IS_REUSING_CU,
 #endif
+    PRUNE_SMOOTH_SPLITS,
+    PRUNE_DIR_SPLITS,
     NUM_EXTRA_FEATURES
   };
 
+  enum SplitPruneRule
+  {
+    SPLIT_PRUNE_SMOOTH = 0,   // homogeneous block, no split pays off
+    SPLIT_PRUNE_DIRECTION,    // gradients and half-block SATD favour one split direction
+    SPLIT_PRUNE_SKIP,         // skip chosen for the unsplit block (and its parent)
+    NUM_SPLIT_PRUNE_RULES
+  };
+
   unsigned m_skipThreshold;
 
+  uint64_t m_splitPruneTested[CU_TRIV_SPLIT + 1];
+  uint64_t m_splitPruneHits  [NUM_SPLIT_PRUNE_RULES][CU_TRIV_SPLIT + 1];
+
+  void xDeriveSplitPruning        ( const CodingStructure& cs, const Partitioner& partitioner );
+  int  xGetSplitPruneRule         ( const EncTestMode& encTestmode, const CodingStructure &cs, const Partitioner& partitioner ) const;
+
 public:
 
   virtual void create             ( const EncCfg& cfg );
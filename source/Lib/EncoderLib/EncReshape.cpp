@@ -172,169 +172,117 @@ void EncReshape::calcSeqStats(Picture *pcPic, SeqInfo &stats)
   uint32_t winLens = (m_binNum == PIC_CODE_CW_BINS) ? (std::min(height, width) / 240) : 2;
   winLens = winLens > 0 ? winLens : 1;
 
-  int64_t tempSq = 0;
-  int64_t topSum = 0, topSumSq = 0;
-  int64_t leftSum = 0, leftSumSq = 0;
-  int64_t *leftColSum = new int64_t[width];
-  int64_t *leftColSumSq = new int64_t[width];
-  int64_t *topRowSum = new int64_t[height];
-  int64_t *topRowSumSq = new int64_t[height];
-  int64_t *topColSum = new int64_t[width];
-  int64_t *topColSumSq = new int64_t[width];
+  const int numThreads = std::max(1, m_reshapeCW.numThreads);
+  const int binLen = m_reshapeLUTSize / m_binNum;
   uint32_t *binCnt = new uint32_t[m_binNum];
-  memset(leftColSum, 0, width * sizeof(int64_t));
-  memset(leftColSumSq, 0, width * sizeof(int64_t));
-  memset(topRowSum, 0, height * sizeof(int64_t));
-  memset(topRowSumSq, 0, height * sizeof(int64_t));
-  memset(topColSum, 0, width * sizeof(int64_t));
-  memset(topColSumSq, 0, width * sizeof(int64_t));
   memset(binCnt, 0, m_binNum * sizeof(uint32_t));
 
   initSeqStats(stats);
-  for (uint32_t y = 0; y < height; y++)
+
+  // the local variances are computed in bands of rows, the window column sums are slid down within a band and a
+  // band is the unit of parallel work. The values of a group of bands are accumulated afterwards in raster order, so
+  // the result does not depend on the number of threads
+  const int bandHeight  = std::min(height, 64);
+  const int groupHeight = std::min(height, bandHeight * numThreads);
+  std::vector<double> varLog10(groupHeight * width);
+
+  for (int yGroup = 0; yGroup < height; yGroup += groupHeight)
   {
-    for (uint32_t x = 0; x < width; x++)
+    const int groupEnd = std::min(yGroup + groupHeight, height);
+
+#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+    for (int yBand = yGroup; yBand < groupEnd; yBand += bandHeight)
     {
-      const Pel pxlY = picY.buf[x];
-      int64_t sum = 0, sumSq = 0;
-      uint32_t numPixInPart = 0;
-      uint32_t y1 = std::max((int)(y - winLens), 0);
-      uint32_t y2 = std::min((int)(y + winLens), (height - 1));
-      uint32_t x1 = std::max((int)(x - winLens), 0);
-      uint32_t x2 = std::min((int)(x + winLens), (width - 1));
-      uint32_t bx = 0, by = 0;
-      const Pel *pWinY = &picY.buf[0];
-      numPixInPart = (x2 - x1 + 1) * (y2 - y1 + 1);
+      const int bandEnd = std::min(yBand + bandHeight, groupEnd);
+      std::vector<int64_t> colSum(width, 0), colSumSq(width, 0);
 
-      if (x == 0 && y == 0)
+      for (int y = yBand; y < bandEnd; y++)
       {
-        for (by = y1; by <= y2; by++)
+        const int y1 = std::max(y - (int)winLens, 0);
+        const int y2 = std::min(y + (int)winLens, height - 1);
+        if (y == yBand)
         {
-          for (bx = x1; bx <= x2; bx++)
+          for (int by = y1; by <= y2; by++)
           {
-            tempSq = pWinY[bx] * pWinY[bx];
-            leftSum += pWinY[bx];
-            leftSumSq += tempSq;
-            leftColSum[bx] += pWinY[bx];
-            leftColSumSq[bx] += tempSq;
-            topColSum[bx] += pWinY[bx];
-            topColSumSq[bx] += tempSq;
-            topRowSum[by] += pWinY[bx];
-            topRowSumSq[by] += tempSq;
+            const Pel *pWinY = picY.buf + by * stride;
+            for (int x = 0; x < width; x++)
+            {
+              colSum[x] += pWinY[x];
+              colSumSq[x] += pWinY[x] * pWinY[x];
+            }
           }
-          pWinY += stride;
         }
-        topSum = leftSum;
-        topSumSq = leftSumSq;
-        sum = leftSum;
-        sumSq = leftSumSq;
-      }
-      else if (x == 0 && y > 0)
-      {
-        if (y < height - winLens)
+        else
         {
-          pWinY += winLens*stride;
-          topRowSum[y + winLens] = 0;
-          topRowSumSq[y + winLens] = 0;
-          for (bx = x1; bx <= x2; bx++)
+          if (y + (int)winLens < height)
+          {
+            const Pel *pWinY = picY.buf + (y + winLens) * stride;
+            for (int x = 0; x < width; x++)
+            {
+              colSum[x] += pWinY[x];
+              colSumSq[x] += pWinY[x] * pWinY[x];
+            }
+          }
+          if (y > (int)winLens)
           {
-            topRowSum[y + winLens] += pWinY[bx];
-            topRowSumSq[y + winLens] += pWinY[bx] * pWinY[bx];
+            const Pel *pWinY = picY.buf + (y - 1 - winLens) * stride;
+            for (int x = 0; x < width; x++)
+            {
+              colSum[x] -= pWinY[x];
+              colSumSq[x] -= pWinY[x] * pWinY[x];
+            }
           }
-          topSum += topRowSum[y + winLens];
-          topSumSq += topRowSumSq[y + winLens];
         }
-        if (y > winLens)
+
+        int64_t sum = 0, sumSq = 0;
+        for (int x = 0; x < std::min((int)winLens, width); x++)
         {
-          topSum -= topRowSum[y - 1 - winLens];
-          topSumSq -= topRowSumSq[y - 1 - winLens];
+          sum += colSum[x];
+          sumSq += colSumSq[x];
         }
-        memset(leftColSum, 0, width * sizeof(int64_t));
-        memset(leftColSumSq, 0, width * sizeof(int64_t));
-        pWinY = &picY.buf[0];
-        pWinY -= (y <= winLens ? y : winLens)*stride;
-        for (by = y1; by <= y2; by++)
+        double *dst = &varLog10[(y - yGroup) * width];
+        for (int x = 0; x < width; x++)
         {
-          for (bx = x1; bx <= x2; bx++)
+          if (x + (int)winLens < width)
           {
-            leftColSum[bx] += pWinY[bx];
-            leftColSumSq[bx] += pWinY[bx] * pWinY[bx];
+            sum += colSum[x + winLens];
+            sumSq += colSumSq[x + winLens];
           }
-          pWinY += stride;
-        }
-        leftSum = topSum;
-        leftSumSq = topSumSq;
-        sum = topSum;
-        sumSq = topSumSq;
-      }
-      else if (x > 0)
-      {
-        if (x < width - winLens)
-        {
-          pWinY -= (y <= winLens ? y : winLens)*stride;
-          if (y == 0)
+          if (x > (int)winLens)
           {
-            leftColSum[x + winLens] = 0;
-            leftColSumSq[x + winLens] = 0;
-            for (by = y1; by <= y2; by++)
-            {
-              leftColSum[x + winLens] += pWinY[x + winLens];
-              leftColSumSq[x + winLens] += pWinY[x + winLens] * pWinY[x + winLens];
-              pWinY += stride;
-            }
+            sum -= colSum[x - 1 - winLens];
+            sumSq -= colSumSq[x - 1 - winLens];
           }
-          else
+          const int x1 = std::max(x - (int)winLens, 0);
+          const int x2 = std::min(x + (int)winLens, width - 1);
+          const uint32_t numPixInPart = (x2 - x1 + 1) * (y2 - y1 + 1);
+
+          double average = double(sum) / numPixInPart;
+          double variance = double(sumSq) / numPixInPart - average * average;
+          if (m_lumaBD > 10)
           {
-            leftColSum[x + winLens] = topColSum[x + winLens];
-            leftColSumSq[x + winLens] = topColSumSq[x + winLens];
-            if (y < height - winLens)
-            {
-              pWinY = &picY.buf[0];
-              pWinY += winLens * stride;
-              leftColSum[x + winLens] += pWinY[x + winLens];
-              leftColSumSq[x + winLens] += pWinY[x + winLens] * pWinY[x + winLens];
-            }
-            if (y > winLens)
-            {
-              pWinY = &picY.buf[0];
-              pWinY -= (winLens + 1) * stride;
-              leftColSum[x + winLens] -= pWinY[x + winLens];
-              leftColSumSq[x + winLens] -= pWinY[x + winLens] * pWinY[x + winLens];
-            }
+            variance = variance / (double)(1 << (2 * m_lumaBD - 20));
           }
-          topColSum[x + winLens] = leftColSum[x + winLens];
-          topColSumSq[x + winLens] = leftColSumSq[x + winLens];
-          leftSum += leftColSum[x + winLens];
-          leftSumSq += leftColSumSq[x + winLens];
-        }
-        if (x > winLens)
-        {
-          leftSum -= leftColSum[x - 1 - winLens];
-          leftSumSq -= leftColSumSq[x - 1 - winLens];
+          else if (m_lumaBD < 10)
+          {
+            variance = variance * (double)(1 << (20 - 2 * m_lumaBD));
+          }
+          dst[x] = log10(variance + 1.0);
         }
-        sum = leftSum;
-        sumSq = leftSumSq;
       }
+    }
 
-      double average = double(sum) / numPixInPart;
-      double variance = double(sumSq) / numPixInPart - average * average;
-      int binLen = m_reshapeLUTSize / m_binNum;
-      uint32_t binIdx = (uint32_t)(pxlY / binLen);
-      if (m_lumaBD > 10)
-      {
-        average = average / (double)(1 << (m_lumaBD - 10));
-        variance = variance / (double)(1 << (2 * m_lumaBD - 20));
-      }
-      else if (m_lumaBD < 10)
+    for (int y = yGroup; y < groupEnd; y++)
+    {
+      const Pel *pxlY = picY.buf + y * stride;
+      const double *src = &varLog10[(y - yGroup) * width];
+      for (int x = 0; x < width; x++)
       {
-        average = average * (double)(1 << (10 - m_lumaBD));
-        variance = variance * (double)(1 << (20 - 2 * m_lumaBD));
+        uint32_t binIdx = (uint32_t)(pxlY[x] / binLen);
+        stats.binVar[binIdx] += src[x];
+        binCnt[binIdx]++;
       }
-      double varLog10 = log10(variance + 1.0);
-      stats.binVar[binIdx] += varLog10;
-      binCnt[binIdx]++;
     }
-    picY.buf += stride;
   }
 
   for (int b = 0; b < m_binNum; b++)
@@ -343,12 +291,6 @@ void EncReshape::calcSeqStats(Picture *pcPic, SeqInfo &stats)
     stats.binVar[b] = (binCnt[b] > 0) ? (stats.binVar[b] / binCnt[b]) : 0.0;
   }
   delete[] binCnt;
-  delete[] topColSum;
-  delete[] topColSumSq;
-  delete[] topRowSum;
-  delete[] topRowSumSq;
-  delete[] leftColSum;
-  delete[] leftColSumSq;
 
   stats.minBinVar = 5.0;
   stats.maxBinVar = 0.0;
@@ -373,35 +315,39 @@ void EncReshape::calcSeqStats(Picture *pcPic, SeqInfo &stats)
     stats.weightNorm += stats.binHist[b] * stats.normVar[b];
   }
 
-  picY = pcPic->getOrigBuf(COMPONENT_Y);
   PelBuf picU = pcPic->getOrigBuf(COMPONENT_Cb);
   PelBuf picV = pcPic->getOrigBuf(COMPONENT_Cr);
   const int widthC = picU.width;
   const int heightC = picU.height;
   const int strideC = picU.stride;
-  double avgY = 0.0, avgU = 0.0, avgV = 0.0;
-  double varY = 0.0, varU = 0.0, varV = 0.0;
+  // integer sums are exact, so the reductions give the same averages as a serial scan
+  int64_t sumY = 0, sumU = 0, sumV = 0;
+  int64_t sumSqY = 0, sumSqU = 0, sumSqV = 0;
+#pragma omp parallel for reduction(+:sumY,sumSqY) num_threads(numThreads) if(numThreads > 1)
   for (int y = 0; y < height; y++)
   {
+    const Pel *pY = picY.buf + y * stride;
     for (int x = 0; x < width; x++)
     {
-      avgY += picY.buf[x];
-      varY += picY.buf[x] * picY.buf[x];
+      sumY += pY[x];
+      sumSqY += pY[x] * pY[x];
     }
-    picY.buf += stride;
   }
+#pragma omp parallel for reduction(+:sumU,sumV,sumSqU,sumSqV) num_threads(numThreads) if(numThreads > 1)
   for (int y = 0; y < heightC; y++)
   {
+    const Pel *pU = picU.buf + y * strideC;
+    const Pel *pV = picV.buf + y * strideC;
     for (int x = 0; x < widthC; x++)
     {
-      avgU += picU.buf[x];
-      avgV += picV.buf[x];
-      varU += picU.buf[x] * picU.buf[x];
-      varV += picV.buf[x] * picV.buf[x];
+      sumU += pU[x];
+      sumV += pV[x];
+      sumSqU += pU[x] * pU[x];
+      sumSqV += pV[x] * pV[x];
     }
-    picU.buf += strideC;
-    picV.buf += strideC;
   }
+  double avgY = (double)sumY, avgU = (double)sumU, avgV = (double)sumV;
+  double varY = (double)sumSqY, varU = (double)sumSqU, varV = (double)sumSqV;
   avgY = avgY / (width * height);
   avgU = avgU / (widthC * heightC);
   avgV = avgV / (widthC * heightC);
@@ -1836,6 +1782,7 @@ void EncReshape::initLUTfromdQPModel()
   reverseLUT(m_fwdLUT, m_invLUT, m_reshapeLUTSize);
   updateChromaScaleLUT();
 #endif
+  updatePWLMappings();
 }
 
 #if JVET_O0432_LMCS_ENCODER
@@ -1937,6 +1884,7 @@ void EncReshape::constructReshaperLMCS()
     int end = (i + 1)*histLenth - 1;
     m_cwLumaWeight[i] = m_fwdLUT[end] - m_fwdLUT[start];
   }
+  updatePWLMappings();
 }
 #else
 void EncReshape::constructReshaperSDR()
@@ -2195,6 +2143,7 @@ void EncReshape::constructReshaperSDR()
   reverseLUT(m_fwdLUT, m_invLUT, m_reshapeLUTSize);
   updateChromaScaleLUT();
 #endif
+  updatePWLMappings();
 }
 #endif
 
@@ -2294,6 +2243,8 @@ void EncReshape::copyState(const EncReshape &other)
   m_recReshaped      = other.m_recReshaped;
   m_invLUT           = other.m_invLUT;
   m_fwdLUT           = other.m_fwdLUT;
+  m_fwdMapping       = other.m_fwdMapping;
+  m_invMapping       = other.m_invMapping;
   m_chromaAdjHelpLUT = other.m_chromaAdjHelpLUT;
   m_binCW            = other.m_binCW;
   m_initCW           = other.m_initCW;
@@ -665,7 +665,6 @@ void EncSlice::initEncSlice(Picture* pcPic, const int pocLast, const int pocCurr
 #if JVET_O1164_PS
   if( ( m_pcCfg->getIBCHashSearch() && m_pcCfg->getIBCMode() ) || m_pcCfg->getAllowDisFracMMVD() )
   {
-    m_pcCuEncoder->getIbcHashMap().destroy();
     m_pcCuEncoder->getIbcHashMap().init( pcPic->cs->pps->getPicWidthInLumaSamples(), pcPic->cs->pps->getPicHeightInLumaSamples() );
   }
 #endif
@@ -1728,6 +1727,14 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     int actualBits = int(cs.fracBits >> SCALE_BITS);
     actualBits    -= (int)m_uiPicTotalBits;
 #endif
+    if ( pCfg->getRCFirstPassMode() )
+    {
+#if ENABLE_WPP_PARALLELISM
+      int actualBits      = int( cs.fracBits >> SCALE_BITS );
+      actualBits         -= (int)m_uiPicTotalBits;
+#endif
+      pRateCtrl->setFirstPassLCUBits( ctuRsAddr, actualBits );
+    }
     if ( pCfg->getUseRateCtrl() )
     {
 #if ENABLE_WPP_PARALLELISM
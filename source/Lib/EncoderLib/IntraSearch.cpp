@@ -49,6 +49,7 @@
 
 #include <math.h>
 #include <limits>
+#include <array>
  //! \ingroup EncoderLib
  //! \{
 #if JVET_O0119_BASE_PALETTE_444
@@ -77,6 +78,13 @@ void IntraSearch::destroy()
 {
   CHECK( !m_isInitialized, "Not initialized" );
 
+  if( m_numGradPreselections )
+  {
+    msg( VERBOSE, "\nIntra gradient pre-selection: best luma mode outside the pre-selected set in %llu of %llu searches (%.2f%%)\n",
+         ( unsigned long long ) m_numGradPreselectMisses, ( unsigned long long ) m_numGradPreselections,
+         100.0 * m_numGradPreselectMisses / m_numGradPreselections );
+  }
+
   if( m_pcEncCfg )
   {
     const uint32_t uiNumLayersToAllocateSplit = 1;
@@ -181,6 +189,8 @@ void IntraSearch::init( EncCfg*        pcEncCfg,
   m_CABACEstimator               = CABACEstimator;
   m_CtxCache                     = ctxCache;
   m_pcReshape                    = pcReshape;
+  m_numGradPreselections         = 0;
+  m_numGradPreselectMisses       = 0;
 
   const ChromaFormat cform = pcEncCfg->getChromaFormatIdc();
 
@@ -420,6 +430,9 @@ bool IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner,
 
     static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> uiRdModeList;
 
+    bool useGradPreselect = false;
+    bool bGradPreselected[NUM_INTRA_MODE];
+
     int numModesForFullRD = 3;
     numModesForFullRD = g_aucIntraModeNumFast_UseMPM_2D[uiWidthBit - MIN_CU_LOG2][uiHeightBit - MIN_CU_LOG2];
 
@@ -453,7 +466,7 @@ bool IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner,
           CompArea      tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
           PelBuf tmpOrg = m_tmpStorageLCU.getBuf(tmpArea);
           tmpOrg.copyFrom(piOrg);
-          tmpOrg.rspSignal(m_pcReshape->getFwdLUT());
+          tmpOrg.rspSignal(m_pcReshape->getFwdMapping());
           m_pcRdCost->setDistParam(distParamSad, tmpOrg, piPred, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y, false); // Use SAD cost
           m_pcRdCost->setDistParam(distParamHad, tmpOrg, piPred, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y,  true); // Use HAD (SATD) cost
         }
@@ -486,6 +499,13 @@ bool IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner,
 
         if( !LFNSTLoadFlag )
         {
+          useGradPreselect = m_pcEncCfg->getIntraGradientPreselect() > 0;
+
+          if( useGradPreselect )
+          {
+            xPreselectModesByGradient( pu, bGradPreselected );
+          }
+
           for( int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
           {
             uint32_t       uiMode = modeIdx;
@@ -497,6 +517,13 @@ bool IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner,
               continue;
             }
 
+            // Skip the directions not pre-selected by the gradient analysis (an odd pre-selected mode keeps both even neighbours)
+            if( useGradPreselect && uiMode > DC_IDX && !bGradPreselected[uiMode]
+                && !( uiMode - 1 > DC_IDX && bGradPreselected[uiMode - 1] ) && !( uiMode + 1 < NUM_LUMA_MODE && bGradPreselected[uiMode + 1] ) )
+            {
+              continue;
+            }
+
             bSatdChecked[uiMode] = true;
 
             pu.intraDir[0] = modeIdx;
@@ -1370,6 +1397,12 @@ bool IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner,
       pu.multiRefIdx = uiBestPUMode.mRefId;
       pu.intraDir[ CHANNEL_TYPE_LUMA ] = uiBestPUMode.modeId;
       cu.bdpcmMode = bestBDPCMMode;
+
+      if( useGradPreselect )
+      {
+        m_numGradPreselections++;
+        m_numGradPreselectMisses += !uiBestPUMode.mipFlg && !bGradPreselected[uiBestPUMode.modeId];
+      }
     }
   }
 
@@ -1399,6 +1432,9 @@ void IntraSearch::estIntraPredChromaQT( CodingUnit &cu, Partitioner &partitioner
 
   auto &pu = *cu.firstPU;
 
+  // the luma reconstruction does not change during the chroma search, the LM modes share the down-sampled luma
+  setLumaRecPixelsReuse( true );
+
   {
     uint32_t       uiBestMode = 0;
     Distortion uiBestDist = 0;
@@ -1677,6 +1713,8 @@ void IntraSearch::estIntraPredChromaQT( CodingUnit &cu, Partitioner &partitioner
     cs.dist        = uiBestDist;
   }
 
+  setLumaRecPixelsReuse( false );
+
   //----- restore context models -----
   m_CABACEstimator->getCtx() = ctxStart;
   if( lumaUsesISP && bestCostSoFar >= maxCostAllowed )
@@ -1733,7 +1771,7 @@ void IntraSearch::xEncPCM(CodingStructure &cs, Partitioner& partitioner, const C
   tempOrgBuf.copyFrom(orgBuf);
   if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag() && compID == COMPONENT_Y)
   {
-    tempOrgBuf.rspSignal(m_pcReshape->getFwdLUT());
+    tempOrgBuf.rspSignal(m_pcReshape->getFwdMapping());
   }
   for (uint32_t uiY = 0; uiY < pcmBuf.height; uiY++)
   {
@@ -1781,7 +1819,7 @@ void IntraSearch::PLTSearch(CodingStructure &cs, Partitioner& partitioner, Compo
   if (m_pcEncCfg->getReshaper() && (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag()))
   {
     cs.getPredBuf().copyFrom(cs.getOrgBuf());
-    cs.getPredBuf().Y().rspSignal(m_pcReshape->getFwdLUT());
+    cs.getPredBuf().Y().rspSignal(m_pcReshape->getFwdMapping());
   }
 
   Pel  *runLength = tu.getRunLens (compBegin);
@@ -1858,7 +1896,7 @@ void IntraSearch::PLTSearch(CodingStructure &cs, Partitioner& partitioner, Compo
         CompArea tmpArea1(COMPONENT_Y, areaY.chromaFormat, Position(0, 0), areaY.size());
         PelBuf   tmpRecLuma = m_tmpStorageLCU.getBuf(tmpArea1);
         tmpRecLuma.copyFrom(reco);
-        tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+        tmpRecLuma.rspSignal(m_pcReshape->getInvMapping());
         distortion += m_pcRdCost->getDistPart(org, tmpRecLuma, cs.sps->getBitDepth(toChannelType(compID)), compID, DF_SSE_WTD, &orgLuma);
       }
       else
@@ -2855,7 +2893,7 @@ void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &comp
     CompArea      tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
     PelBuf tmpPred = m_tmpStorageLCU.getBuf(tmpArea);
     tmpPred.copyFrom(piPred);
-    piResi.rspSignal(m_pcReshape->getFwdLUT());
+    piResi.rspSignal(m_pcReshape->getFwdMapping());
     piResi.subtract(tmpPred);
   }
   else
@@ -3138,7 +3176,7 @@ void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &comp
       CompArea      tmpArea1(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
       PelBuf tmpRecLuma = m_tmpStorageLCU.getBuf(tmpArea1);
       tmpRecLuma.copyFrom(piReco);
-      tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+      tmpRecLuma.rspSignal(m_pcReshape->getInvMapping());
       ruiDist += m_pcRdCost->getDistPart(piOrg, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID, DF_SSE_WTD, &orgLuma);
     }
     else
@@ -4336,6 +4374,114 @@ bool IntraSearch::useDPCMForFirstPassIntraEstimation( const PredictionUnit &pu,
   return CU::isRDPCMEnabled( *pu.cu ) && pu.cu->transQuantBypass && (uiDirMode == HOR_IDX || uiDirMode == VER_IDX);
 }
 
+void IntraSearch::xPreselectModesByGradient( const PredictionUnit &pu, bool *preselected )
+{
+  // index of the angular mode with the closest 1/32-sample displacement for every displacement in [-32, 32]
+  // (modes 34..66 cover -32..32, modes 34..2 the same displacements for the horizontal family)
+  static const std::array<int8_t, 65> angleToIdx = []
+  {
+    static const int modeAngle[33] = { -32, -29, -26, -23, -20, -18, -16, -14, -12, -10, -8, -6, -4, -3, -2, -1, 0,
+                                         1,   2,   3,   4,   6,   8,  10,  12,  14,  16, 18, 20, 23, 26, 29, 32 };
+    std::array<int8_t, 65> table;
+    for( int angle = -32; angle <= 32; angle++ )
+    {
+      int bestIdx = 0;
+      for( int idx = 1; idx < 33; idx++ )
+      {
+        if( abs( modeAngle[idx] - angle ) < abs( modeAngle[bestIdx] - angle ) )
+        {
+          bestIdx = idx;
+        }
+      }
+      table[angle + 32] = int8_t( bestIdx );
+    }
+    return table;
+  }();
+
+  uint64_t hist[NUM_LUMA_MODE] = { 0 };
+
+  // histogram of the Sobel gradients on the inner samples of a buffer, the edge direction selects the mode
+  auto addGradients = [&hist]( const CPelBuf &buf )
+  {
+    for( int y = 1; y < int( buf.height ) - 1; y++ )
+    {
+      const Pel *r0 = buf.bufAt( 0, y - 1 );
+      const Pel *r1 = buf.bufAt( 0, y     );
+      const Pel *r2 = buf.bufAt( 0, y + 1 );
+
+      for( int x = 1; x < int( buf.width ) - 1; x++ )
+      {
+        const int gx = ( r0[x + 1] + 2 * r1[x + 1] + r2[x + 1] ) - ( r0[x - 1] + 2 * r1[x - 1] + r2[x - 1] );
+        const int gy = ( r2[x - 1] + 2 * r2[x    ] + r2[x + 1] ) - ( r0[x - 1] + 2 * r0[x    ] + r0[x + 1] );
+
+        if( gx == 0 && gy == 0 )
+        {
+          continue;
+        }
+
+        const int mode = abs( gx ) >= abs( gy ) ? 34 + angleToIdx[32 + gy * 32 / gx] : 34 - angleToIdx[32 + gx * 32 / gy];
+
+        hist[mode] += abs( gx ) + abs( gy );
+      }
+    }
+  };
+
+  const CodingStructure &cs      = *pu.cs;
+  const CompArea        &area    = pu.Y();
+  const CompArea        &picArea = cs.picture->Y();
+  const CPelBuf          orgPic  = cs.picture->getOrigBuf( COMPONENT_Y );
+  const CPelBuf          recoPic = cs.picture->getRecoBuf( COMPONENT_Y );
+
+  // source block, widened by one sample where the picture allows so that the block edges get a gradient, too
+  const int x0 = std::max<int>( area.x - 1, picArea.x );
+  const int y0 = std::max<int>( area.y - 1, picArea.y );
+  const int x1 = std::min<int>( area.x + area.width,  picArea.x + picArea.width  - 1 );
+  const int y1 = std::min<int>( area.y + area.height, picArea.y + picArea.height - 1 );
+
+  addGradients( CPelBuf( orgPic.bufAt( x0, y0 ), orgPic.stride, x1 - x0 + 1, y1 - y0 + 1 ) );
+
+  // reconstructed template: three rows above and three columns left of the block
+  if( area.y >= picArea.y + 3 && cs.getCURestricted( area.pos().offset( 0, -1 ), *pu.cu, CHANNEL_TYPE_LUMA ) )
+  {
+    addGradients( CPelBuf( recoPic.bufAt( area.x, area.y - 3 ), recoPic.stride, area.width, 3 ) );
+  }
+  if( area.x >= picArea.x + 3 && cs.getCURestricted( area.pos().offset( -1, 0 ), *pu.cu, CHANNEL_TYPE_LUMA ) )
+  {
+    addGradients( CPelBuf( recoPic.bufAt( area.x - 3, area.y ), recoPic.stride, 3, area.height ) );
+  }
+
+  std::fill_n( preselected, NUM_LUMA_MODE, false );
+
+  for( int n = 0; n < m_pcEncCfg->getIntraGradientPreselect(); n++ )
+  {
+    int bestMode = -1;
+    for( int mode = DC_IDX + 1; mode < NUM_LUMA_MODE; mode++ )
+    {
+      if( hist[mode] && ( bestMode < 0 || hist[mode] > hist[bestMode] ) )
+      {
+        bestMode = mode;
+      }
+    }
+    if( bestMode < 0 )
+    {
+      break;
+    }
+    preselected[bestMode] = true;
+    hist[bestMode]        = 0;
+  }
+
+  // planar, DC and the MPMs are always kept
+  unsigned mpms[NUM_MOST_PROBABLE_MODES];
+  const int numMpms = PU::getIntraMPMs( pu, mpms );
+
+  for( int i = 0; i < numMpms; i++ )
+  {
+    preselected[mpms[i]] = true;
+  }
+  preselected[PLANAR_IDX] = true;
+  preselected[DC_IDX]     = true;
+}
+
 #if JVET_O0925_MIP_SIMPLIFICATIONS
 template<typename T, size_t N>
 void IntraSearch::reduceHadCandList(static_vector<T, N>& candModeList, static_vector<double, N>& candCostList, int& numModesForFullRD, const double thresholdHadCost, const double* mipHadCost, const PredictionUnit &pu, const bool fastMip)
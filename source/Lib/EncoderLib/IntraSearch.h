@@ -343,6 +343,10 @@ private:
   static_vector<double,   FAST_UDI_MAX_RDMODE_NUM> m_dSavedModeCostLFNST;
   static_vector<double,   FAST_UDI_MAX_RDMODE_NUM> m_dSavedHadListLFNST;
 
+  // statistics of the gradient-based mode pre-selection
+  uint64_t                                         m_numGradPreselections;
+  uint64_t                                         m_numGradPreselectMisses;
+
   PelStorage      m_tmpStorageLCU;
 protected:
   // interface to option
@@ -439,6 +443,7 @@ protected:
 
   void encPredIntraDPCM( const ComponentID &compID, PelBuf &pOrg, PelBuf &pDst, const uint32_t &uiDirMode );
   static bool useDPCMForFirstPassIntraEstimation( const PredictionUnit &pu, const uint32_t &uiDirMode );
+  void xPreselectModesByGradient  ( const PredictionUnit &pu, bool *preselected );
 
   template<typename T, size_t N>
 #if JVET_O0925_MIP_SIMPLIFICATIONS
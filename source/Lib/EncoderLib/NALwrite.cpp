@@ -34,6 +34,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "CommonLib/NAL.h"
 #include "CommonLib/BitStream.h"
@@ -46,7 +47,7 @@ using namespace std;
 
 static const uint8_t emulation_prevention_three_byte = 3;
 
-void writeNalUnitHeader(ostream& out, OutputNALUnit& nalu)       // nal_unit_header()
+void writeNalUnitHeader(vector<uint8_t>& out, OutputNALUnit& nalu)       // nal_unit_header()
 {
 OutputBitstream bsNALUHeader;
 #if JVET_O0179
@@ -71,13 +72,13 @@ OutputBitstream bsNALUHeader;
   bsNALUHeader.write(0, 1);                             // nuh_reserved_zero_bit
 #endif
 
-  out.write(reinterpret_cast<const char*>(bsNALUHeader.getByteStream()), bsNALUHeader.getByteStreamLength());
+  out.insert(out.end(), bsNALUHeader.getByteStream(), bsNALUHeader.getByteStream() + bsNALUHeader.getByteStreamLength());
 }
 /**
  * write nalu to bytestream out, performing RBSP anti startcode
  * emulation as required.  nalu.m_RBSPayload must be byte aligned.
  */
-void write(ostream& out, OutputNALUnit& nalu)
+void write(vector<uint8_t>& out, OutputNALUnit& nalu)
 {
   writeNalUnitHeader(out, nalu);
   /* write out rsbp_byte's, inserting any required
@@ -100,42 +101,51 @@ void write(ostream& out, OutputNALUnit& nalu)
    *  - 0x00000302
    *  - 0x00000303
    */
-  vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
+  const vector<uint8_t>& rbsp = nalu.m_Bitstream.getFIFO();
+  const uint8_t*         src  = rbsp.data();
+  const std::size_t      size = rbsp.size();
 
-  vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
-  std::size_t outputAmount = 0;
-  int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  out.reserve(out.size() + size + size / 64 + 1);
+
+  /* an emulation_prevention_three_byte is needed in front of each byte <= 3
+   * following two zero bytes, so only the zero bytes need to be examined and
+   * the data in between is copied as a whole */
+  std::size_t runStart = 0;
+  std::size_t pos      = 0;
+  while (pos < size)
   {
-    const uint8_t v=(*it);
-    if (zeroCount==2 && v<=3)
+    const uint8_t* zero = (const uint8_t*) memchr(src + pos, 0, size - pos);
+    if (zero == NULL || std::size_t(zero - src) + 2 >= size)
     {
-      outputBuffer[outputAmount++]=emulation_prevention_three_byte;
-      zeroCount=0;
+      break;
     }
-
-    if (v==0)
+    const std::size_t zeroPos = zero - src;
+    if (src[zeroPos + 1] != 0)
+    {
+      pos = zeroPos + 2;
+    }
+    else if (src[zeroPos + 2] > 3)
     {
-      zeroCount++;
+      pos = zeroPos + 3;
     }
     else
     {
-      zeroCount=0;
+      out.insert(out.end(), src + runStart, src + zeroPos + 2);
+      out.push_back(emulation_prevention_three_byte);
+      runStart = pos = zeroPos + 2;
     }
-    outputBuffer[outputAmount++]=v;
   }
+  out.insert(out.end(), src + runStart, src + size);
 
   /* 7.4.1.1
    * ... when the last byte of the RBSP data is equal to 0x00 (which can
    * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
    * to 0x03 is appended to the end of the data.
    */
-  if (zeroCount>0)
+  if (size > 0 && src[size - 1] == 0)
   {
-    outputBuffer[outputAmount++]=emulation_prevention_three_byte;
+    out.push_back(emulation_prevention_three_byte);
   }
-  out.write(reinterpret_cast<const char*>(&(*outputBuffer.begin())), outputAmount);
 }
 
 //! \}
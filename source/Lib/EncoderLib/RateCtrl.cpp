@@ -38,6 +38,7 @@
 #include "../CommonLib/ChromaFormat.h"
 
 #include <cmath>
+#include <fstream>
 
 #define LAMBDA_PREC                                           1000000
 
@@ -69,6 +70,8 @@ EncRCSeq::EncRCSeq()
   m_adaptiveBit         = 0;
   m_lastLambda          = 0.0;
   m_bitDepth          = 0;
+  m_firstPassStats      = NULL;
+  m_firstPassBitsLeft   = 0;
 }
 
 EncRCSeq::~EncRCSeq()
@@ -165,6 +168,8 @@ void EncRCSeq::create( int totalFrames, int targetBitrate, int frameRate, int GO
   m_bitsLeft   = m_targetBits;
   m_adaptiveBit = adaptiveBit;
   m_lastLambda = 0.0;
+  m_firstPassStats    = NULL;
+  m_firstPassBitsLeft = 0;
 }
 
 void EncRCSeq::destroy()
@@ -286,6 +291,38 @@ void EncRCSeq::updateAfterPic ( int bits )
   m_framesLeft--;
 }
 
+void EncRCSeq::setFirstPassStats( std::map<int, TRCPassStats>* stats )
+{
+  m_firstPassStats    = stats;
+  m_firstPassBitsLeft = 0;
+  if ( m_firstPassStats != NULL )
+  {
+    for ( auto &it : *m_firstPassStats )
+    {
+      m_firstPassBitsLeft += it.second.m_numBits;
+    }
+  }
+}
+
+const TRCPassStats* EncRCSeq::getFirstPassStats( int POC )
+{
+  if ( m_firstPassStats == NULL )
+  {
+    return NULL;
+  }
+  auto it = m_firstPassStats->find( POC );
+  return it == m_firstPassStats->end() ? NULL : &it->second;
+}
+
+void EncRCSeq::updateAfterPicFirstPass( int POC )
+{
+  const TRCPassStats* stats = getFirstPassStats( POC );
+  if ( stats != NULL )
+  {
+    m_firstPassBitsLeft -= stats->m_numBits;
+  }
+}
+
 void EncRCSeq::setAllBitRatio( double basicLambda, double* equaCoeffA, double* equaCoeffB )
 {
   int* bitsRatio = new int[m_GOPSize];
@@ -564,6 +601,8 @@ EncRCPic::EncRCPic()
   m_encRCGOP = NULL;
 
   m_frameLevel    = 0;
+  m_POC           = 0;
+  m_useFirstPassStats = false;
   m_numberOfPixel = 0;
   m_numberOfLCU   = 0;
   m_targetBits    = 0;
@@ -618,6 +657,23 @@ int EncRCPic::xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP )
   return targetBits;
 }
 
+int EncRCPic::xEstPicTargetBitsFirstPass( EncRCSeq* encRCSeq, const TRCPassStats& stats )
+{
+  // the analysis pass is coded with a constant QP, so its bits reflect the relative complexity of the remaining pictures
+  int targetBits = encRCSeq->getLeftAverageBits();
+  if ( encRCSeq->getFirstPassBitsLeft() > 0 )
+  {
+    targetBits = int( (double)encRCSeq->getBitsLeft() * stats.m_numBits / (double)encRCSeq->getFirstPassBitsLeft() );
+  }
+
+  if ( targetBits < 100 )
+  {
+    targetBits = 100;   // at least allocate 100 bits for one picture
+  }
+
+  return targetBits;
+}
+
 int EncRCPic::xEstPicHeaderBits( list<EncRCPic*>& listPreviousPictures, int frameLevel )
 {
   int numPreviousPics   = 0;
@@ -695,13 +751,17 @@ void EncRCPic::addToPictureLsit( list<EncRCPic*>& listPreviousPictures )
   listPreviousPictures.push_back( this );
 }
 
-void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, list<EncRCPic*>& listPreviousPictures )
+void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, int POC, list<EncRCPic*>& listPreviousPictures )
 {
   destroy();
   m_encRCSeq = encRCSeq;
   m_encRCGOP = encRCGOP;
+  m_POC      = POC;
 
-  int targetBits    = xEstPicTargetBits( encRCSeq, encRCGOP );
+  const TRCPassStats* firstPassStats = encRCSeq->getFirstPassStats( POC );
+  m_useFirstPassStats = firstPassStats != NULL;
+
+  int targetBits    = m_useFirstPassStats ? xEstPicTargetBitsFirstPass( encRCSeq, *firstPassStats ) : xEstPicTargetBits( encRCSeq, encRCGOP );
   int estHeaderBits = xEstPicHeaderBits( listPreviousPictures, frameLevel );
 
   if ( targetBits < estHeaderBits + 100 )
@@ -868,6 +928,17 @@ double EncRCPic::estimatePicLambda( list<EncRCPic*>& listPreviousPictures, bool
     }
     totalWeight += m_LCUs[i].m_bitWeight;
   }
+  const TRCPassStats* firstPassStats = m_useFirstPassStats ? m_encRCSeq->getFirstPassStats( m_POC ) : NULL;
+  if ( firstPassStats != NULL && (int)firstPassStats->m_LCUBits.size() == m_numberOfLCU )
+  {
+    // use the CTU bits of the analysis pass as allocation weights
+    totalWeight = 0.0;
+    for ( int i=0; i<m_numberOfLCU; i++ )
+    {
+      m_LCUs[i].m_bitWeight = std::max( firstPassStats->m_LCUBits[i], 1 );
+      totalWeight += m_LCUs[i].m_bitWeight;
+    }
+  }
   for ( int i=0; i<m_numberOfLCU; i++ )
   {
     double BUTargetBits = m_targetBits * m_LCUs[i].m_bitWeight / totalWeight;
@@ -1234,6 +1305,10 @@ void EncRCPic::updateAfterPicture( int actualHeaderBits, int actualTotalBits, do
 {
   m_picActualHeaderBits = actualHeaderBits;
   m_picActualBits       = actualTotalBits;
+  if ( m_useFirstPassStats )
+  {
+    m_encRCSeq->updateAfterPicFirstPass( m_POC );
+  }
   if ( averageQP > 0.0 )
   {
     m_picQP             = int( averageQP + 0.5 );
@@ -1790,10 +1865,10 @@ void RateCtrl::init(int totalFrames, int targetBitrate, int frameRate, int GOPSi
   delete[] GOPID2Level;
 }
 
-void RateCtrl::initRCPic( int frameLevel )
+void RateCtrl::initRCPic( int frameLevel, int POC )
 {
   m_encRCPic = new EncRCPic;
-  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures );
+  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, POC, m_listRCPictures );
 }
 
 void RateCtrl::initRCGOP( int numberOfPictures )
@@ -1837,3 +1912,65 @@ void RateCtrl::destroyRCGOP()
   delete m_encRCGOP;
   m_encRCGOP = NULL;
 }
+
+void RateCtrl::initFirstPass( int numberOfLCU )
+{
+  m_firstPassStats.clear();
+  m_firstPassLCUBits.assign( numberOfLCU, 0 );
+}
+
+void RateCtrl::addFirstPassPicture( int POC, int QP, bool isIntra, int numBits )
+{
+  TRCPassStats stats;
+  stats.m_POC     = POC;
+  stats.m_QP      = QP;
+  stats.m_isIntra = isIntra;
+  stats.m_numBits = numBits;
+  stats.m_LCUBits = m_firstPassLCUBits;
+  m_firstPassStats[POC] = stats;
+
+  std::fill( m_firstPassLCUBits.begin(), m_firstPassLCUBits.end(), 0 );
+}
+
+void RateCtrl::writeFirstPassStats( const std::string& fileName )
+{
+  std::ofstream statsFile( fileName.c_str() );
+  CHECK( !statsFile.is_open(), "Unable to open rate control statistics file " << fileName << " for writing" );
+
+  // one line per picture: POC QP isIntra numBits numLCU LCUBits...
+  for ( auto &it : m_firstPassStats )
+  {
+    const TRCPassStats& stats = it.second;
+    statsFile << stats.m_POC << " " << stats.m_QP << " " << ( stats.m_isIntra ? 1 : 0 ) << " " << stats.m_numBits << " " << stats.m_LCUBits.size();
+    for ( auto bits : stats.m_LCUBits )
+    {
+      statsFile << " " << bits;
+    }
+    statsFile << "\n";
+  }
+}
+
+void RateCtrl::readFirstPassStats( const std::string& fileName )
+{
+  std::ifstream statsFile( fileName.c_str() );
+  CHECK( !statsFile.is_open(), "Unable to open rate control statistics file " << fileName << " for reading" );
+
+  m_firstPassStats.clear();
+  TRCPassStats stats;
+  int isIntra = 0;
+  size_t numLCU = 0;
+  while ( statsFile >> stats.m_POC >> stats.m_QP >> isIntra >> stats.m_numBits >> numLCU )
+  {
+    stats.m_isIntra = isIntra != 0;
+    stats.m_LCUBits.resize( numLCU );
+    for ( size_t i = 0; i < numLCU; i++ )
+    {
+      statsFile >> stats.m_LCUBits[i];
+    }
+    CHECK( statsFile.fail(), "Corrupted rate control statistics file " << fileName );
+    m_firstPassStats[stats.m_POC] = stats;
+  }
+
+  m_encRCSeq->setFirstPassStats( &m_firstPassStats );
+  msg( NOTICE, "\nRate control: %d pictures read from statistics file %s\n", (int)m_firstPassStats.size(), fileName.c_str() );
+}
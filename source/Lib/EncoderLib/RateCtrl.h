@@ -47,6 +47,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <string>
 
 using namespace std;
 
@@ -88,6 +90,15 @@ struct TRCLCU
   double m_actualMSE;
 };
 
+struct TRCPassStats
+{
+  int              m_POC;
+  int              m_QP;
+  bool             m_isIntra;
+  int              m_numBits;     // the whole picture, including header
+  std::vector<int> m_LCUBits;     // CTU data bits in raster scan order
+};
+
 struct TRCParameter
 {
   double m_alpha;
@@ -154,6 +165,11 @@ public:
   void setBitDepth(int bitDepth) { m_bitDepth = bitDepth; }
   int getbitDepth() { return m_bitDepth; }
 
+  void   setFirstPassStats( std::map<int, TRCPassStats>* stats );
+  const TRCPassStats* getFirstPassStats( int POC );
+  int64_t getFirstPassBitsLeft()        { return m_firstPassBitsLeft; }
+  void   updateAfterPicFirstPass( int POC );
+
 private:
   int m_totalFrames;
   int m_targetRate;
@@ -184,6 +200,9 @@ private:
   int m_adaptiveBit;
   double m_lastLambda;
   int m_bitDepth;
+
+  std::map<int, TRCPassStats>* m_firstPassStats;
+  int64_t m_firstPassBitsLeft;
 };
 
 class EncRCGOP
@@ -226,7 +245,7 @@ public:
   ~EncRCPic();
 
 public:
-  void create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, list<EncRCPic*>& listPreviousPictures );
+  void create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, int POC, list<EncRCPic*>& listPreviousPictures );
   void destroy();
 
   int    estimatePicQP    ( double lambda, list<EncRCPic*>& listPreviousPictures );
@@ -250,6 +269,7 @@ public:
 private:
   int xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
   int xEstPicHeaderBits( list<EncRCPic*>& listPreviousPictures, int frameLevel );
+  int xEstPicTargetBitsFirstPass( EncRCSeq* encRCSeq, const TRCPassStats& stats );
 #if V0078_ADAPTIVE_LOWER_BOUND
   int xEstPicLowerBound( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
 #endif
@@ -259,6 +279,8 @@ public:
   EncRCGOP*      getRCGOP()                              { return m_encRCGOP; }
 
   int  getFrameLevel()                                    { return m_frameLevel; }
+  int  getPOC()                                           { return m_POC; }
+  bool getUseFirstPassStats()                             { return m_useFirstPassStats; }
   int  getNumberOfPixel()                                 { return m_numberOfPixel; }
   int  getNumberOfLCU()                                   { return m_numberOfLCU; }
   int  getTargetBits()                                    { return m_targetBits; }
@@ -296,6 +318,8 @@ private:
   EncRCGOP* m_encRCGOP;
 
   int m_frameLevel;
+  int m_POC;
+  bool m_useFirstPassStats;
   int m_numberOfPixel;
   int m_numberOfLCU;
   int m_targetBits;
@@ -330,7 +354,7 @@ public:
 public:
   void init(int totalFrames, int targetBitrate, int frameRate, int GOPSize, int picWidth, int picHeight, int LCUWidth, int LCUHeight, int bitDepth, int keepHierBits, bool useLCUSeparateModel, GOPEntry GOPList[MAX_GOP]);
   void destroy();
-  void initRCPic( int frameLevel );
+  void initRCPic( int frameLevel, int POC );
   void initRCGOP( int numberOfPictures );
   void destroyRCGOP();
 
@@ -341,6 +365,12 @@ public:
   EncRCGOP* getRCGOP()          { CHECK( m_encRCGOP == NULL, "Object does not exist" ); return m_encRCGOP; }
   EncRCPic* getRCPic()          { CHECK( m_encRCPic == NULL, "Object does not exist" ); return m_encRCPic; }
   list<EncRCPic*>& getPicList() { return m_listRCPictures; }
+
+  void       initFirstPass( int numberOfLCU );
+  void       setFirstPassLCUBits( int LCUIdx, int bits ) { CHECK( LCUIdx >= (int)m_firstPassLCUBits.size(), "LCU id exceeds number of LCU" ); m_firstPassLCUBits[LCUIdx] = bits; }
+  void       addFirstPassPicture( int POC, int QP, bool isIntra, int numBits );
+  void       writeFirstPassStats( const std::string& fileName );
+  void       readFirstPassStats( const std::string& fileName );
 #if U0132_TARGET_BITS_SATURATION
   bool       getCpbSaturationEnabled()  { return m_CpbSaturationEnabled;  }
   uint32_t       getCpbState()              { return m_cpbState;       }
@@ -356,6 +386,8 @@ private:
   EncRCPic* m_encRCPic;
   list<EncRCPic*> m_listRCPictures;
   int        m_RCQP;
+  std::map<int, TRCPassStats> m_firstPassStats;   // statistics of the analysis pass of two-pass rate control, indexed by POC
+  std::vector<int> m_firstPassLCUBits;
 #if U0132_TARGET_BITS_SATURATION
   bool       m_CpbSaturationEnabled;    // Enable target bits saturation to avoid CPB overflow and underflow
   int        m_cpbState;                // CPB State